@@ -23,7 +23,7 @@
 #include "task-mine-block.h"
 
 #include "blackboard.h"
-#include "bts-decompiler.h"
+#include "bts-blueprints.h"
 
 AIModelBase::AIModelBase()
 {
@@ -44,60 +44,39 @@ void AIModelBase::ConstructAI()
 {
   PrepareScript();
 
-  if (!_scriptCompiled.empty())
-  {
-    _scriptAsText   = BTSDecompiler::Instance().Decompile(_scriptCompiled);
-    _scriptCompiled = std::vector<uint8_t>();
-  }
-
-  _aiReader.Init(AIComponentRef->OwnerGameObject);
-  _aiReader.ParseFromString(_scriptAsText);
-  _aiReader.FormTree();
-
-  _scriptAsText = std::string();
+  const BTSBlueprint& bp = _scriptCompiled.empty()
+                         ? BTSBlueprints::Instance().Get(_scriptAsText)
+                         : BTSBlueprints::Instance().Get(_scriptCompiled);
 
-  std::unordered_map<const ScriptNode*, bool> scriptNodesChecked;
-  std::unordered_map<const ScriptNode*, Node*> behaviourNodesCreated;
+  _scriptCompiled = std::vector<uint8_t>();
+  _scriptAsText   = std::string();
 
-  const ScriptNode* nodeData       = nullptr;
-  const ScriptNode* parentNodeData = nullptr;
+  //
+  // Only nodes themselves are created per object,
+  // script data they refer to is shared.
+  //
+  std::vector<Node*> behaviourNodesCreated(bp.Nodes.size(), nullptr);
 
-  Node* taskRef   = nullptr;
   Node* parentRef = nullptr;
 
-  for (auto& i : _aiReader.GetConstructionOrder())
+  for (auto& i : bp.Order)
   {
-    nodeData       = i.first;
-    parentNodeData = i.second;
-
-    Node* task   = nullptr;
-    Node* parent = nullptr;
+    Node*& task   = behaviourNodesCreated[i.first];
+    Node*& parent = behaviourNodesCreated[i.second];
 
-    //std::string addInfo1 = nodeData->Params.size() != 0 ? nodeData->Params.at("p1") : "";
-    //std::string addInfo2 = parentNodeData->Params.size() != 0 ? parentNodeData->Params.at("p1") : "";
-
-    if (scriptNodesChecked.count(nodeData) != 1)
+    if (task == nullptr)
     {
-      //DebugLog("\tinstantiate 0x%X (%s, %s)\n", nodeData, nodeData->NodeName.data(), addInfo1.data());
-      scriptNodesChecked[nodeData] = true;
-      task = CreateNode(nodeData);
-      behaviourNodesCreated[nodeData] = task;
+      task = CreateNode(&bp.Nodes[i.first]);
     }
 
-    if (scriptNodesChecked.count(parentNodeData) != 1)
+    if (parent == nullptr)
     {
-      //DebugLog("\tinstantiate 0x%X (%s, %s)\n", parentNodeData, parentNodeData->NodeName.data(), addInfo2.data());
-      scriptNodesChecked[parentNodeData] = true;
-      parent = CreateNode(parentNodeData);
-      behaviourNodesCreated[parentNodeData] = parent;
+      parent = CreateNode(&bp.Nodes[i.second]);
     }
 
-    taskRef   = behaviourNodesCreated[nodeData];
-    parentRef = behaviourNodesCreated[parentNodeData];
-
-    parentRef->AddNode(taskRef);
+    parent->AddNode(task);
 
-    //DebugLog("\n(0x%X)(%s) %s::AddNode(%s) (0x%X)(%s)\n\n", parentNodeData, addInfo2.data(), parentNodeData->NodeName.data(), nodeData->NodeName.data(), nodeData, addInfo1.data());
+    parentRef = parent;
   }
 
   _root.reset(static_cast<Root*>(parentRef));
@@ -156,6 +135,33 @@ void AIModelBase::Update()
 
 // =============================================================================
 
+int AIModelBase::GetIdleTicks()
+{
+  GameObject* owner = AIComponentRef->OwnerGameObject;
+
+  if (!_root || owner->CanAct())
+  {
+    return 0;
+  }
+
+  //
+  // Actor acts during the tick it becomes ready.
+  // WaitForTurn() processes effects which can change anything,
+  // so stop before any of them does something.
+  //
+  return std::min(owner->TicksUntilReady() - 1,
+                  owner->GetEffectsIdleTicks());
+}
+
+// =============================================================================
+
+void AIModelBase::SkipTicks(int ticks)
+{
+  AIComponentRef->OwnerGameObject->SkipWaitingTicks(ticks);
+}
+
+// =============================================================================
+
 Node* AIModelBase::CreateTask(const ScriptNode* data)
 {
   Node* task = nullptr;
@@ -623,16 +629,12 @@ std::function<BTResult()> AIModelBase::GetIsPlayerVisibleCF()
     Position plPos  = playerRef.GetPosition();
     Position objPos = ogo->GetPosition();
 
-    bool res = Map::Instance().IsObjectVisible(objPos, plPos);
+    bool res = Map::Instance().IsVisibleFromPlayer(objPos.X, objPos.Y);
     if (res)
     {
-      std::string plPosStr = Util::StringFormat("%i,%i", plPos.X, plPos.Y);
-
       Blackboard::Instance().Set(AIComponentRef->OwnerGameObject->ObjectId(),
-                                 {
-                                   Strings::BlackboardKeyPlayerPos,
-                                   plPosStr
-                                 });
+                                 BlackboardKey::PLAYER_POS,
+                                 plPos);
     }
 
     //
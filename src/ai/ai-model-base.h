@@ -20,6 +20,13 @@ class AIModelBase
 
     virtual void Update();
 
+    //
+    // While actor is not ready Update() only waits for turn
+    // (see Component::GetIdleTicks()).
+    //
+    int GetIdleTicks();
+    void SkipTicks(int ticks);
+
     void ConstructAI();
 
     AIComponent* AIComponentRef = nullptr;
@@ -42,8 +49,6 @@ class AIModelBase
 
     std::vector<uint8_t> _scriptCompiled;
 
-    BTSParser _aiReader;
-
     std::unordered_map<std::string, ItemBonusType> _bonusTypeByDisplayName;
 
     Node* CreateNode(const ScriptNode* data);
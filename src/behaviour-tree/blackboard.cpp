@@ -6,9 +6,20 @@ void Blackboard::InitSpecific()
 
 // =============================================================================
 
+void Blackboard::Clear(uint64_t goId, BlackboardKey key)
+{
+  auto it = _blackboard.find(goId);
+  if (it != _blackboard.end())
+  {
+    it->second.Slots[(size_t)key] = std::monostate();
+  }
+}
+
+// =============================================================================
+
 void Blackboard::Set(uint64_t goId, const SSPair& data)
 {
-  auto& mapVal = _blackboard[goId];
+  auto& mapVal = _blackboard[goId].Strings;
   mapVal[data.first] = data.second;
 }
 
@@ -16,8 +27,16 @@ void Blackboard::Set(uint64_t goId, const SSPair& data)
 
 std::string Blackboard::Get(uint64_t goId, const std::string& key)
 {
-  auto& mapVal = _blackboard[goId];
-  return mapVal[key];
+  auto it = _blackboard.find(goId);
+  if (it == _blackboard.end())
+  {
+    return std::string();
+  }
+
+  auto& mapVal = it->second.Strings;
+
+  auto res = mapVal.find(key);
+  return (res != mapVal.end()) ? res->second : std::string();
 }
 
 // =============================================================================
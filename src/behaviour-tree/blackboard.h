@@ -3,31 +3,74 @@
 
 #include <string>
 #include <unordered_map>
+#include <variant>
+#include <array>
 #include <cstdint>
 
 #include "singleton.h"
+#include "enumerations.h"
+#include "position.h"
 
 class GameObject;
 
 using SSMap = std::unordered_map<std::string, std::string>;
 using SSPair = std::pair<std::string, std::string>;
 
+//
+// std::monostate means "not set".
+//
+using BBValue = std::variant<std::monostate, Position, int, uint64_t, bool>;
+
 ///
 /// Helper class for global data access
 /// and manipulation for AI controlled objects
 ///
+/// Data used by tasks every turn is stored by BlackboardKey
+/// in fixed slots as is, without converting it to string and back.
+/// String pairs are left for anything else (e.g. keys defined in scripts).
+///
 class Blackboard : public Singleton<Blackboard>
 {
   public:
+    template <typename T>
+    void Set(uint64_t goId, BlackboardKey key, const T& value)
+    {
+      _blackboard[goId].Slots[(size_t)key] = value;
+    }
+
+    //
+    // Returns nullptr if value is not set or is of different type.
+    //
+    template <typename T>
+    const T* Get(uint64_t goId, BlackboardKey key)
+    {
+      auto it = _blackboard.find(goId);
+      if (it == _blackboard.end())
+      {
+        return nullptr;
+      }
+
+      return std::get_if<T>(&it->second.Slots[(size_t)key]);
+    }
+
+    void Clear(uint64_t goId, BlackboardKey key);
+
     void Set(uint64_t goId, const SSPair& data);
     std::string Get(uint64_t goId, const std::string& key);
+
     void Remove(uint64_t goId);
 
   protected:
     void InitSpecific() override;
 
   private:
-    std::unordered_map<uint64_t, SSMap> _blackboard;
+    struct Entry
+    {
+      std::array<BBValue, (size_t)BlackboardKey::LAST_ELEMENT> Slots;
+      SSMap Strings;
+    };
+
+    std::unordered_map<uint64_t, Entry> _blackboard;
 };
 
 #endif // BLACKBOARD_H
@@ -3,9 +3,7 @@
 #include "util.h"
 #include "game-object.h"
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
 void BTSParser::Init(GameObject* objRef)
 {
@@ -322,6 +320,26 @@ const ConstructionOrder& BTSParser::GetConstructionOrder()
 
 // =============================================================================
 
+BTSBlueprint BTSParser::MakeBlueprint()
+{
+  BTSBlueprint res;
+
+  res.Nodes = _parsedData;
+  res.Order.reserve(_constructionOrder.size());
+
+  const ScriptNode* first = _parsedData.data();
+
+  for (auto& i : _constructionOrder)
+  {
+    res.Order.push_back({ (size_t)(i.first  - first),
+                          (size_t)(i.second - first) });
+  }
+
+  return res;
+}
+
+// =============================================================================
+
 void ScriptNode::Print()
 {
   std::string tabs(Indent, ' ');
@@ -22,6 +22,18 @@ class GameObject;
 using ConstructionOrder = std::vector<std::pair<const ScriptNode*,
                                                 const ScriptNode*>>;
 
+//
+// Parsed and formed script that doesn't depend on any particular object,
+// so it can be shared by everyone who uses the same script.
+// Order holds pairs of { node, parent } indices into Nodes
+// in the same sequence as BTSParser::GetConstructionOrder().
+//
+struct BTSBlueprint
+{
+  std::vector<ScriptNode> Nodes;
+  std::vector<std::pair<size_t, size_t>> Order;
+};
+
 class BTSParser
 {
   public:
@@ -37,6 +49,11 @@ class BTSParser
 
     const ConstructionOrder& GetConstructionOrder();
 
+    //
+    // Call after FormTree().
+    //
+    BTSBlueprint MakeBlueprint();
+
   private:
     void ParseLine(int indent, const std::string& line);
     void ReadTag(const std::string& tagData, int indent);
@@ -6,9 +6,7 @@
 #include "player.h"
 #include "printer.h"
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
 //
 // NOTE:
@@ -95,13 +93,16 @@ BTResult TaskAttackRanged::ProcessSpellAttack()
   auto line = Util::BresenhamLine(from, to);
   GameObject* hit = Util::GetFirstObjectOnTheLine(line);
 
+  std::unique_ptr<GameObject> tile;
+
   if (hit != nullptr)
   {
     to = hit->GetPosition();
   }
   else
   {
-    hit = Map::Instance().CurrentLevel->MapArray[to.X][to.Y].get();
+    tile = Map::Instance().CurrentLevel->Tiles.MakeTileObject(to.X, to.Y);
+    hit  = tile.get();
   }
 
   SpellInfo* si = SpellsDatabase::Instance().GetSpellInfoFromDatabase(_spellType);
@@ -198,6 +199,8 @@ BTResult TaskAttackRanged::ProcessWeaponAttack()
   auto line = Util::BresenhamLine(from, to);
   GameObject* hit = Util::GetFirstObjectOnTheLine(line);
 
+  std::unique_ptr<GameObject> tile;
+
   //
   // If something is hit, launch projectile up to this point.
   //
@@ -210,7 +213,8 @@ BTResult TaskAttackRanged::ProcessWeaponAttack()
     //
     // Otherwise to the cursor position (i.e. player position)
     //
-    hit = Map::Instance().CurrentLevel->MapArray[to.X][to.Y].get();
+    tile = Map::Instance().CurrentLevel->Tiles.MakeTileObject(to.X, to.Y);
+    hit  = tile.get();
   }
 
   if (weapon->Data.ItemType_ == ItemType::RANGED_WEAPON)
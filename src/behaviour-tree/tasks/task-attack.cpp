@@ -4,9 +4,7 @@
 #include "game-object.h"
 #include "printer.h"
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
 TaskAttack::TaskAttack(GameObject* objectToControl,
                        bool alwaysHitOverride)
@@ -2,28 +2,24 @@
 
 #include "game-object.h"
 #include "application.h"
-#include "pathfinder.h"
+#include "player.h"
 #include "map.h"
 
 BTResult TaskChasePlayer::Run()
 {
   //DebugLog("[TaskChasePlayer]\n");
 
-  Pathfinder pf;
-
-  auto path = pf.BuildRoad(Map::Instance().CurrentLevel,
-                           _objectToControl->GetPosition(),
-                           _playerRef->GetPosition(),
-                           std::vector<char>(),
-                           false,
-                           true);
-
-  if (path.empty())
+  //
+  // Distance field is shared between all chasing monsters
+  // and is rebuilt only when something has changed,
+  // so there's no need to build path for every one of them.
+  //
+  Position moveTo;
+  if (!_playerRef->GetStepTowards(_objectToControl, moveTo))
   {
     return BTResult::Failure;
   }
 
-  auto moveTo = path.top();
   if (_objectToControl->MoveTo(moveTo))
   {
     _objectToControl->FinishTurn();
@@ -92,10 +92,8 @@ void TaskDrinkPotion::UsePotion(int inventoryIndex)
 void TaskDrinkPotion::PrintLogIfNeeded(ItemComponent* ic)
 {
   auto curLvl = Map::Instance().CurrentLevel;
-  auto curTile =
-      curLvl->MapArray[_objectToControl->PosX][_objectToControl->PosY].get();
 
-  if (curTile->Visible)
+  if (curLvl->Tiles.IsVisible(_objectToControl->PosX, _objectToControl->PosY))
   {
     auto msg = Util::StringFormat("%s drinks %s",
                                   _objectToControl->ObjectName.data(),
@@ -11,26 +11,22 @@ BTResult TaskFindAndDestroyContainer::Run()
 {
   BTResult res = BTResult::Failure;
 
-  std::string objId =
-      Blackboard::Instance().Get(_objectToControl->ObjectId(),
-                                 Strings::BlackboardKeyObjectId);
-  if (!objId.empty())
+  const uint64_t* objId =
+      Blackboard::Instance().Get<uint64_t>(_objectToControl->ObjectId(),
+                                           BlackboardKey::OBJECT_ID);
+  if (objId != nullptr)
   {
-    uint64_t objIdInt = std::stoull(objId);
     GameObjectCollectionType t = GameObjectCollectionType::STATIC_OBJECTS;
 
-    GameObject* object = Map::Instance().FindGameObjectById(objIdInt, t);
+    GameObject* object = Map::Instance().FindGameObjectById(*objId, t);
     if (object == nullptr)
     {
       //
       // If our saved object no longer exists, erase it from blackboard
       // so that new container could be found on next iteration.
       //
-      Blackboard::Instance().Set(_objectToControl->ObjectId(),
-                                 {
-                                   Strings::BlackboardKeyObjectId,
-                                   std::string()
-                                 });
+      Blackboard::Instance().Clear(_objectToControl->ObjectId(),
+                                   BlackboardKey::OBJECT_ID);
     }
     else
     {
@@ -43,10 +39,8 @@ BTResult TaskFindAndDestroyContainer::Run()
     if (container != nullptr)
     {
       Blackboard::Instance().Set(_objectToControl->ObjectId(),
-                                 {
-                                   Strings::BlackboardKeyObjectId,
-                                   std::to_string(container->ObjectId())
-                                 });
+                                 BlackboardKey::OBJECT_ID,
+                                 container->ObjectId());
       res = ProcessExistingObject(container);
     }
   }
@@ -121,7 +115,7 @@ TaskFindAndDestroyContainer::ProcessExistingObject(GameObject* container)
   }
   else
   {
-    Pathfinder pf;
+    auto& pf = Map::Instance().CurrentLevel->LevelPathfinder;
 
     auto path = pf.BuildRoad(Map::Instance().CurrentLevel,
                              _objectToControl->GetPosition(),
@@ -7,28 +7,23 @@ BTResult TaskGotoLastMinedPos::Run()
 {
   //DebugLog("[TaskGotoLastMinedPos]\n");
 
-  auto minedPos =
-      Blackboard::Instance().Get(_objectToControl->ObjectId(),
-                                 Strings::BlackboardKeyLastMinedPos);
+  const Position* minedPos =
+      Blackboard::Instance().Get<Position>(_objectToControl->ObjectId(),
+                                           BlackboardKey::LAST_MINED_POS);
 
-  if (minedPos.empty())
+  if (minedPos == nullptr)
   {
     return BTResult::Failure;
   }
 
-  auto split = Util::StringSplit(minedPos, ',');
-
-  int mX = std::stoi(split[0]);
-  int mY = std::stoi(split[1]);
+  int mX = minedPos->X;
+  int mY = minedPos->Y;
 
   if (_objectToControl->PosX == mX
    && _objectToControl->PosY == mY)
   {
-    Blackboard::Instance().Set(_objectToControl->ObjectId(),
-                               {
-                                 Strings::BlackboardKeyLastMinedPos,
-                                 std::string()
-                               });
+    Blackboard::Instance().Clear(_objectToControl->ObjectId(),
+                                 BlackboardKey::LAST_MINED_POS);
 
     return BTResult::Failure;
   }
@@ -36,11 +31,8 @@ BTResult TaskGotoLastMinedPos::Run()
   _objectToControl->MoveTo({ mX, mY });
   _objectToControl->FinishTurn();
 
-  Blackboard::Instance().Set(_objectToControl->ObjectId(),
-                             {
-                               Strings::BlackboardKeyLastMinedPos,
-                               std::string()
-                             });
+  Blackboard::Instance().Clear(_objectToControl->ObjectId(),
+                               BlackboardKey::LAST_MINED_POS);
 
   return BTResult::Success;
 }
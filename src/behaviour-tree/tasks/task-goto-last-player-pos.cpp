@@ -2,7 +2,7 @@
 
 #include "game-object.h"
 #include "application.h"
-#include "pathfinder.h"
+#include "player.h"
 #include "map.h"
 #include "blackboard.h"
 
@@ -10,60 +10,42 @@ BTResult TaskGotoLastPlayerPos::Run()
 {
   //DebugLog("[TaskGotoLastPlayerPos]\n");
 
-  auto plPos = Blackboard::Instance().Get(_objectToControl->ObjectId(),
-                                          Strings::BlackboardKeyPlayerPos);
+  const Position* plPos =
+      Blackboard::Instance().Get<Position>(_objectToControl->ObjectId(),
+                                           BlackboardKey::PLAYER_POS);
 
-  if (plPos.empty())
+  if (plPos == nullptr)
   {
     return BTResult::Failure;
   }
 
-  auto split = Util::StringSplit(plPos, ',');
-
-  int plX = std::stoi(split[0]);
-  int plY = std::stoi(split[1]);
+  int plX = plPos->X;
+  int plY = plPos->Y;
 
   if (_objectToControl->PosX == plX
    && _objectToControl->PosY == plY)
   {
     // We have arrived at the last known player position
 
-    Blackboard::Instance().Set(_objectToControl->ObjectId(),
-                               {
-                                 Strings::BlackboardKeyPlayerPos,
-                                 std::string()
-                               });
+    Blackboard::Instance().Clear(_objectToControl->ObjectId(),
+                                 BlackboardKey::PLAYER_POS);
 
     return BTResult::Success;
   }
 
   //DebugLog("\tplX: %i plY: %i\n\n", plX, plY);
 
-  Pathfinder pf;
-  auto path = pf.BuildRoad(Map::Instance().CurrentLevel,
-                           _objectToControl->GetPosition(),
-                           _playerRef->GetPosition(),
-                           std::vector<char>(),
-                           false,
-                           true);
-
-  if (!path.empty())
+  Position moveTo;
+  if (_playerRef->GetStepTowards(_objectToControl, moveTo)
+   && _objectToControl->MoveTo(moveTo))
   {
-    auto moveTo = path.top();
-    if (_objectToControl->MoveTo(moveTo))
-    {
-      path.pop();
-      _objectToControl->FinishTurn();
-      return BTResult::Success;
-    }
+    _objectToControl->FinishTurn();
+    return BTResult::Success;
   }
 
   // No path can be built or MoveTo() failed
-  Blackboard::Instance().Set(_objectToControl->ObjectId(),
-                             {
-                               Strings::BlackboardKeyPlayerPos,
-                               std::string()
-                             });
+  Blackboard::Instance().Clear(_objectToControl->ObjectId(),
+                               BlackboardKey::PLAYER_POS);
 
   return BTResult::Failure;
 }
@@ -3,8 +3,6 @@
 
 #include "behaviour-tree.h"
 
-#include "pathfinder.h"
-
 class Player;
 
 class TaskGotoLastPlayerPos : public Node
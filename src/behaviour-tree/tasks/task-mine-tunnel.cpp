@@ -115,13 +115,9 @@ BTResult TaskMineTunnel::Run()
 
   _objectToControl->FinishTurn();
 
-  auto minedPos = Util::StringFormat("%i,%i", found.X, found.Y);
-
   Blackboard::Instance().Set(_objectToControl->ObjectId(),
-                             {
-                               Strings::BlackboardKeyLastMinedPos,
-                               minedPos
-                             });
+                             BlackboardKey::LAST_MINED_POS,
+                             found);
 
   return BTResult::Success;
 }
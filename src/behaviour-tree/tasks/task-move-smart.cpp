@@ -23,9 +23,9 @@ BTResult TaskMoveSmart::Run()
     // E.g. undead cannot step on SHRINE or HALLOWED_GROUND, but kobold can.
     // Add ZoneMarker to check.
     //
-    bool isOk = !curLvl->MapArray[c.X][c.Y]->Special;
+    bool isOk = !curLvl->Tiles.IsSpecial(c.X, c.Y);
 
-    bool isOccupied = curLvl->MapArray[c.X][c.Y]->Occupied;
+    bool isOccupied = curLvl->Tiles.IsOccupied(c.X, c.Y);
 
     bool isDoor = (so != nullptr
                && (so->GetComponent<DoorComponent>() != nullptr));
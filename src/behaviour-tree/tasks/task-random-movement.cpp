@@ -25,8 +25,8 @@ BTResult TaskRandomMovement::Smart()
   {
     MapLevelBase* curLvl = Map::Instance().CurrentLevel;
 
-    bool isOk       = !curLvl->MapArray[c.X][c.Y]->Special;
-    bool isOccupied = curLvl->MapArray[c.X][c.Y]->Occupied;
+    bool isOk       = !curLvl->Tiles.IsSpecial(c.X, c.Y);
+    bool isOccupied = curLvl->Tiles.IsOccupied(c.X, c.Y);
 
     if (isOk && !isOccupied)
     {
@@ -69,7 +69,7 @@ BTResult TaskRandomMovement::Dumb()
 
   MapLevelBase* curLvl = Map::Instance().CurrentLevel;
 
-  bool isOk = !curLvl->MapArray[newPos.X][newPos.Y]->Special;
+  bool isOk = !curLvl->Tiles.IsSpecial(newPos.X, newPos.Y);
 
   if (isOk && _objectToControl->Move(dx, dy))
   {
@@ -7,16 +7,9 @@ BTResult TaskRememberPlayerPos::Run()
 {
   //DebugLog("[TaskRememberPlayerPos]\n");
 
-  std::string plX = std::to_string(_playerRef->PosX);
-  std::string plY = std::to_string(_playerRef->PosY);
-
-  auto plPos = Util::StringFormat("%i,%i", _playerRef->PosX, _playerRef->PosY);
-
   Blackboard::Instance().Set(_objectToControl->ObjectId(),
-                             {
-                               Strings::BlackboardKeyPlayerPos,
-                               plPos
-                             });
+                             BlackboardKey::PLAYER_POS,
+                             _playerRef->GetPosition());
 
   return BTResult::Success;
 }
@@ -68,12 +68,12 @@ bool TaskTryPickupItems::PickupItems(const Items& items,
   bool found = false;
   for (auto& i : items)
   {
-    ItemComponent* ic = i.second->GetComponent<ItemComponent>();
+    ItemComponent* ic = i->GetComponent<ItemComponent>();
     if (ic == nullptr)
     {
       DebugLog("[WAR] TaskTryPickupItems::FilterItem() "
                "no ItemComponent found on %s!",
-               i.second->ObjectName.data());
+               i->ObjectName.data());
       continue;
     }
 
@@ -93,18 +93,25 @@ bool TaskTryPickupItems::PickupItems(const Items& items,
 
 void TaskTryPickupItems::Pickup(const Item& item)
 {
-  auto go = Map::Instance().CurrentLevel->GameObjects[item.first].get();
+  auto curLvl = Map::Instance().CurrentLevel;
+
+  auto go = item;
   ItemComponent* ic = go->GetComponent<ItemComponent>();
   if (ic->Data.ItemType_ == ItemType::COINS)
   {
     _objectToControl->Money += ic->Data.Amount;
+    curLvl->EraseGameObject(item);
+
+    go = nullptr;
   }
   else
   {
-    go = Map::Instance().CurrentLevel->GameObjects[item.first].release();
+    go = curLvl->ReleaseGameObject(item);
     _inventoryRef->Add(go);
   }
 
-  auto it = Map::Instance().CurrentLevel->GameObjects.begin();
-  Map::Instance().CurrentLevel->GameObjects.erase(it + item.first);
+  Map::Instance().PostTriggerEvent({ TriggerEventType::ITEM_PICKED_UP,
+                                     _objectToControl,
+                                     go,
+                                     _objectToControl->GetPosition() });
 }
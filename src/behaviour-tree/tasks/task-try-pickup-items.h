@@ -3,7 +3,7 @@
 
 #include "behaviour-tree.h"
 
-using Item   = std::pair<int, GameObject*>;
+using Item   = GameObject*;
 using Items  = std::vector<Item>;
 using Filter = std::vector<ItemType>;
 
@@ -28,3 +28,27 @@ void AIComponent::Update()
     OwnerGameObject->FinishTurn();
   }
 }
+
+// =============================================================================
+
+bool AIComponent::IsTicking()
+{
+  return true;
+}
+
+// =============================================================================
+
+int AIComponent::GetIdleTicks()
+{
+  return (CurrentModel != nullptr) ? CurrentModel->GetIdleTicks() : 0;
+}
+
+// =============================================================================
+
+void AIComponent::SkipTicks(int ticks)
+{
+  if (CurrentModel != nullptr)
+  {
+    CurrentModel->SkipTicks(ticks);
+  }
+}
@@ -7,13 +7,13 @@
 #include "component.h"
 #include "ai-model-base.h"
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
 class AIComponent : public Component
 {
   public:
+    static constexpr ComponentType TypeId = ComponentType::AI;
+
     AIComponent();
 
     template <typename T>
@@ -67,6 +67,9 @@ class AIComponent : public Component
     }
 
     void Update() override;
+    bool IsTicking() override;
+    int GetIdleTicks() override;
+    void SkipTicks(int ticks) override;
 
     AIModelBase* CurrentModel = nullptr;
 
@@ -18,3 +18,29 @@ void Component::Prepare(GameObject* owner)
 void Component::PrepareAdditional()
 {
 }
+
+// =============================================================================
+
+void Component::Update()
+{
+}
+
+// =============================================================================
+
+bool Component::IsTicking()
+{
+  return false;
+}
+
+// =============================================================================
+
+int Component::GetIdleTicks()
+{
+  return 0;
+}
+
+// =============================================================================
+
+void Component::SkipTicks(int ticks)
+{
+}
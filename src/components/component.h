@@ -2,11 +2,21 @@
 #define COMPONENT_H
 
 #include <typeinfo>
+#include <limits>
 
 #include <stdlib.h>
 
+#include "enumerations.h"
+
 class GameObject;
 
+//
+// Every derived class must declare
+//
+// static constexpr ComponentType TypeId = ComponentType::...;
+//
+// which is used as a slot index in GameObject.
+//
 class Component
 {
   public:
@@ -16,7 +26,27 @@ class Component
 
     void Prepare(GameObject* owner);
 
-    virtual void Update() = 0;
+    //
+    // Does nothing by default.
+    //
+    virtual void Update();
+
+    //
+    // Only components that do something in Update() say so,
+    // others are not visited every map update cycle (see UpdateList).
+    //
+    virtual bool IsTicking();
+
+    //
+    // How many map update cycles in a row Update() can be replaced
+    // with a single SkipTicks() call without changing the outcome
+    // (see Map::SkipIdleTicks()).
+    // Assume none unless component says otherwise.
+    //
+    static constexpr int kUnlimitedIdleTicks = std::numeric_limits<int>::max();
+
+    virtual int GetIdleTicks();
+    virtual void SkipTicks(int ticks);
 
     GameObject* OwnerGameObject = nullptr;
 
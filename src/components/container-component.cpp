@@ -5,9 +5,7 @@
 #include "printer.h"
 #include "util.h"
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
 ContainerComponent::ContainerComponent(size_t maxCapacity)
 {
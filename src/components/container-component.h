@@ -10,6 +10,8 @@
 class ContainerComponent : public Component
 {
   public:
+    static constexpr ComponentType TypeId = ComponentType::CONTAINER;
+
     ContainerComponent(size_t maxCapacity = GlobalConstants::InventoryMaxSize);
 
     void Update() override;
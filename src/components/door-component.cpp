@@ -4,6 +4,7 @@
 #include "printer.h"
 #include "util.h"
 #include "application.h"
+#include "map.h"
 
 DoorComponent::DoorComponent()
 {
@@ -99,6 +100,11 @@ void DoorComponent::UpdateDoorState()
                                 (BgColorOverride == Colors::None ?
                                   Colors::DoorHighlightColor :
                                   BgColorOverride);
+
+  if (Map::Instance().CurrentLevel != nullptr)
+  {
+    Map::Instance().CurrentLevel->LayoutVersion++;
+  }
 }
 
 // =============================================================================
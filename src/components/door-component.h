@@ -9,6 +9,8 @@
 class DoorComponent : public Component
 {
   public:
+    static constexpr ComponentType TypeId = ComponentType::DOOR;
+
     DoorComponent();
 
     void Update() override;
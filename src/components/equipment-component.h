@@ -19,6 +19,8 @@ class Player;
 class EquipmentComponent : public Component
 {
   public:
+    static constexpr ComponentType TypeId = ComponentType::EQUIPMENT;
+
     EquipmentComponent(ContainerComponent* inventoryRef);
 
     void Update() override;
@@ -9,6 +9,8 @@ class ContainerComponent;
 class ItemComponent : public Component
 {
   public:
+    static constexpr ComponentType TypeId = ComponentType::ITEM;
+
     ItemComponent();
 
     void Update() override;
@@ -45,6 +45,38 @@ void ShrineComponent::Update()
 
 // =============================================================================
 
+bool ShrineComponent::IsTicking()
+{
+  return true;
+}
+
+// =============================================================================
+
+int ShrineComponent::GetIdleTicks()
+{
+  if (_counter > _timeout)
+  {
+    return kUnlimitedIdleTicks;
+  }
+
+  //
+  // Last tick before timeout activates the shrine.
+  //
+  return std::max(_timeout - _counter - 1, 0);
+}
+
+// =============================================================================
+
+void ShrineComponent::SkipTicks(int ticks)
+{
+  if (_counter < _timeout)
+  {
+    _counter += ticks;
+  }
+}
+
+// =============================================================================
+
 IR ShrineComponent::Interact()
 {
   if (_timeout == -1 || _counter < _timeout)
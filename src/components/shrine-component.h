@@ -8,9 +8,14 @@
 class ShrineComponent : public Component
 {
   public:
+    static constexpr ComponentType TypeId = ComponentType::SHRINE;
+
     ShrineComponent(ShrineType shrineType, int timeout, bool oneTimeUse = true);
 
     void Update() override;
+    bool IsTicking() override;
+    int GetIdleTicks() override;
+    void SkipTicks(int ticks) override;
 
     IR Interact();
 
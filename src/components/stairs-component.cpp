@@ -9,7 +9,7 @@ StairsComponent::StairsComponent()
 void StairsComponent::Update()
 {
   //
-  // Stairs are part of MapArray, i.e. map floor tiles,
+  // Stairs are part of level Tiles, i.e. map floor tiles,
   // so they are not participating in global Update().
   //
 }
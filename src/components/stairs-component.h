@@ -7,6 +7,8 @@
 class StairsComponent : public Component
 {
   public:
+    static constexpr ComponentType TypeId = ComponentType::STAIRS;
+
     StairsComponent();
 
     void Update() override;
@@ -28,3 +28,24 @@ void TimedDestroyerComponent::Update()
     OwnerGameObject->IsDestroyed = true;
   }
 }
+
+// =============================================================================
+
+bool TimedDestroyerComponent::IsTicking()
+{
+  return true;
+}
+
+// =============================================================================
+
+int TimedDestroyerComponent::GetIdleTicks()
+{
+  return std::max(_time - 1, 0);
+}
+
+// =============================================================================
+
+void TimedDestroyerComponent::SkipTicks(int ticks)
+{
+  _time -= ticks;
+}
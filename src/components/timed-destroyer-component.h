@@ -8,12 +8,17 @@
 class TimedDestroyerComponent : public Component
 {
   public:
+    static constexpr ComponentType TypeId = ComponentType::TIMED_DESTROYER;
+
     TimedDestroyerComponent(
         int delay,
         const std::function<void()>& onTimerEnd = std::function<void()>()
     );
 
     void Update() override;
+    bool IsTicking() override;
+    int GetIdleTicks() override;
+    void SkipTicks(int ticks) override;
 
   private:
     int _time = 0;
@@ -21,6 +21,30 @@ void TownPortalComponent::Update()
 
 // =============================================================================
 
+bool TownPortalComponent::IsTicking()
+{
+  return true;
+}
+
+// =============================================================================
+
+int TownPortalComponent::GetIdleTicks()
+{
+  //
+  // Player doesn't move while ticks are skipped.
+  //
+  auto& playerRef = Application::Instance().PlayerInstance;
+  if (playerRef.PosX == OwnerGameObject->PosX
+   && playerRef.PosY == OwnerGameObject->PosY)
+  {
+    return 0;
+  }
+
+  return kUnlimitedIdleTicks;
+}
+
+// =============================================================================
+
 void TownPortalComponent::SavePosition(MapType mapToReturn,
                                        const Position& posToReturn)
 {
@@ -8,9 +8,13 @@
 class TownPortalComponent : public Component
 {
   public:
+    static constexpr ComponentType TypeId = ComponentType::TOWN_PORTAL;
+
     TownPortalComponent();
 
     void Update() override;
+    bool IsTicking() override;
+    int GetIdleTicks() override;
 
     void SavePosition(MapType mapToReturn, const Position& posToReturn);
     void TeleportBack();
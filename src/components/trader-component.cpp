@@ -53,6 +53,27 @@ void TraderComponent::Update()
 
 // =============================================================================
 
+bool TraderComponent::IsTicking()
+{
+  return true;
+}
+
+// =============================================================================
+
+int TraderComponent::GetIdleTicks()
+{
+  return std::max(_stockRefreshTurns - _stockResetCounter, 0);
+}
+
+// =============================================================================
+
+void TraderComponent::SkipTicks(int ticks)
+{
+  _stockResetCounter += ticks;
+}
+
+// =============================================================================
+
 void TraderComponent::CreateItems()
 {
   switch (_traderType)
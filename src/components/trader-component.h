@@ -11,9 +11,14 @@ class AINPC;
 class TraderComponent : public Component
 {
   public:
+    static constexpr ComponentType TypeId = ComponentType::TRADER;
+
     TraderComponent();
 
     void Update() override;
+    bool IsTicking() override;
+    int GetIdleTicks() override;
+    void SkipTicks(int ticks) override;
 
     void Init(TraderRole traderType, int stockRefreshTurns, int maxItems);
     void RefreshStock();
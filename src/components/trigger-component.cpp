@@ -4,8 +4,8 @@
 #include "util.h"
 
 TriggerComponent::TriggerComponent(TriggerType type,
-                                   const std::function<bool()>& condition,
-                                   const std::function<void()>& handler)
+                                   const TriggerCondition& condition,
+                                   const TriggerHandler& handler)
 {
   _data.Type      = type;
   _data.Condition = condition;
@@ -14,11 +14,11 @@ TriggerComponent::TriggerComponent(TriggerType type,
 
 // =============================================================================
 
-void TriggerComponent::Update()
+void TriggerComponent::Fire(const TriggerEvent& e)
 {
   if (Util::IsFunctionValid(_data.Condition))
   {
-    if (_data.Condition())
+    if (_data.Condition(e))
     {
       if (Util::IsFunctionValid(_data.Handler))
       {
@@ -26,14 +26,14 @@ void TriggerComponent::Update()
         {
           if (!_once)
           {
-            _data.Handler();
+            _data.Handler(e);
             _once = true;
             OwnerGameObject->IsDestroyed = true;
           }
         }
         else
         {
-          _data.Handler();
+          _data.Handler(e);
         }
       }
     }
@@ -2,25 +2,62 @@
 #define TRIGGERCOMPONENT_H
 
 #include <functional>
+#include <cstdint>
 
 #include "component.h"
 #include "enumerations.h"
+#include "position.h"
+
+struct TriggerEvent
+{
+  TriggerEventType Type = TriggerEventType::MAP_UPDATE;
+
+  //
+  // Actor that caused the event, if any.
+  //
+  GameObject* Who = nullptr;
+
+  //
+  // Item picked up (ITEM_PICKED_UP),
+  // nullptr for coins since they're destroyed right away.
+  //
+  GameObject* What = nullptr;
+
+  //
+  // Where Who was at the time.
+  //
+  Position Pos;
+
+  uint64_t Turn = 0;
+};
+
+using TriggerCondition = std::function<bool(const TriggerEvent&)>;
+using TriggerHandler   = std::function<void(const TriggerEvent&)>;
 
 struct TriggerData
 {
   TriggerType Type = TriggerType::ONE_SHOT;
-  std::function<bool()> Condition;
-  std::function<void()> Handler;
+  TriggerCondition Condition;
+  TriggerHandler Handler;
 };
 
+//
+// Is not updated, it's run by TriggerDispatcher
+// of the level on events trigger is subscribed to.
+//
 class TriggerComponent : public Component
 {
   public:
+    static constexpr ComponentType TypeId = ComponentType::TRIGGER;
+
     TriggerComponent(TriggerType type,
-                     const std::function<bool()>& condition,
-                     const std::function<void()>& handler);
+                     const TriggerCondition& condition,
+                     const TriggerHandler& handler);
 
-    void Update() override;
+    //
+    // Runs handler if condition holds for this event.
+    //
+    void Fire(const TriggerEvent& e);
 
   private:
     bool _once = false;
@@ -1,9 +1,12 @@
 #include "attribute.h"
 #include "util.h"
 
+#include <algorithm>
+
 void Attribute::Reset()
 {
-  _modifiersByGoId.clear();
+  _modifiers.clear();
+  _modifiersTotal = 0;
   _originalValue = 0;
   Talents = 0;
 }
@@ -19,48 +22,44 @@ void Attribute::Set(int value)
 
 void Attribute::AddModifier(int64_t who, int value)
 {
-  _modifiersByGoId[who].push_back(value);
+  _modifiers.push_back({ who, value });
+  _modifiersTotal += value;
 }
 
 // =============================================================================
 
 void Attribute::RemoveModifier(int64_t who)
 {
-  _modifiersByGoId.erase(who);
-}
-
-// =============================================================================
-
-int Attribute::Get()
-{
-  int res = _originalValue;
-
-  for (auto& kvp : _modifiersByGoId)
+  for (auto& m : _modifiers)
   {
-    for (auto& v : kvp.second)
+    if (m.first == who)
     {
-      res += v;
+      _modifiersTotal -= m.second;
     }
   }
 
-  return res;
+  auto it = std::remove_if(_modifiers.begin(),
+                           _modifiers.end(),
+                           [who](const std::pair<int64_t, int>& m)
+                           {
+                             return (m.first == who);
+                           });
+
+  _modifiers.erase(it, _modifiers.end());
 }
 
 // =============================================================================
 
-int Attribute::GetModifiers()
+int Attribute::Get()
 {
-  int res = 0;
+  return _originalValue + _modifiersTotal;
+}
 
-  for (auto& kvp : _modifiersByGoId)
-  {
-    for (auto& v : kvp.second)
-    {
-      res += v;
-    }
-  }
+// =============================================================================
 
-  return res;
+int Attribute::GetModifiers()
+{
+  return _modifiersTotal;
 }
 
 // =============================================================================
@@ -1,7 +1,6 @@
 #ifndef ATTRIBUTE_H
 #define ATTRIBUTE_H
 
-#include <unordered_map>
 #include <vector>
 #include <cstdint>
 #include <map>
@@ -28,9 +27,19 @@ struct Attribute
   private:
     //
     // Some items may modify stat several times (e.g. dagger gives +SKL
-    // but may also be magic that gives further modifier to SKL)
+    // but may also be magic that gives further modifier to SKL),
+    // so there can be several entries with the same id.
     //
-    std::unordered_map<int64_t, std::vector<int>> _modifiersByGoId;
+    // Most attributes have no modifiers at all and the rest
+    // have just a few, so plain vector is enough.
+    //
+    std::vector<std::pair<int64_t, int>> _modifiers;
+
+    //
+    // Sum of all modifiers, so that Get() doesn't have to count it
+    // every time.
+    //
+    int _modifiersTotal = 0;
 
     int _originalValue = 0;
 };
@@ -13,12 +13,11 @@
 #include "serializer.h"
 #include "blackboard.h"
 #include "gid-generator.h"
+#include "game-objects-registry.h"
 #include "door-component.h"
 
 #ifdef DEBUG_BUILD
 #include "dev-console.h"
-
-std::unordered_map<uint64_t, GameObject*> GameObjectsById;
 #endif
 
 GameObject::GameObject(MapLevelBase* levelOwner)
@@ -27,9 +26,9 @@ GameObject::GameObject(MapLevelBase* levelOwner)
   VisibilityRadius.Set(0);
 
   _objectId = GID::Instance().GenerateGlobalId();
+  _handle   = GameObjectsRegistry::Instance().Register(this);
 
 #ifdef DEBUG_BUILD
-  GameObjectsById[_objectId] = this;
   HexAddressString = Util::StringFormat("0x%X", this);
 #endif
 }
@@ -44,11 +43,11 @@ GameObject::GameObject(MapLevelBase *levelOwner,
                        const uint32_t& bgColor)
 {
   _objectId = GID::Instance().GenerateGlobalId();
+  _handle   = GameObjectsRegistry::Instance().Register(this);
 
   Init(levelOwner, x, y, avatar, htmlColor, bgColor);
 
 #ifdef DEBUG_BUILD
-  GameObjectsById[_objectId] = this;
   HexAddressString = Util::StringFormat("0x%X", this);
 #endif
 }
@@ -87,6 +86,8 @@ GameObject::~GameObject()
     }
   }
 #endif
+
+  GameObjectsRegistry::Instance().Release(_handle);
 }
 
 // =============================================================================
@@ -106,17 +107,11 @@ void GameObject::Init(MapLevelBase* levelOwner,
 
   Attrs.ActionMeter = GlobalConstants::TurnReadyValue;
 
-  _levelOwner = levelOwner;
-
   //
-  // _currentCell->Occupied is not set to true by default,
+  // Occupied flag of the tile is not set to true by default,
   // see game-object.h comments for Occupied field.
   //
-  if (_levelOwner != nullptr)
-  {
-    _currentCell  = _levelOwner->MapArray[PosX][PosY].get();
-    _previousCell = _levelOwner->MapArray[PosX][PosY].get();
-  }
+  _levelOwner = levelOwner;
 }
 
 // =============================================================================
@@ -155,17 +150,21 @@ bool GameObject::MoveTo(int x, int y, bool force)
     //
     if (PosX < _levelOwner->MapSize.X && PosY < _levelOwner->MapSize.Y)
     {
-      _previousCell = _levelOwner->MapArray[PosX][PosY].get();
-      _previousCell->Occupied = false;
+      _levelOwner->Tiles.SetOccupied(PosX, PosY, false);
     }
 
+    int oldX = PosX;
+    int oldY = PosY;
+
     PosX = x;
     PosY = y;
 
     //DebugLog("MoveTo(%i, %i)\n", x, y);
 
-    _currentCell = _levelOwner->MapArray[PosX][PosY].get();
-    _currentCell->Occupied = true;
+    _levelOwner->Tiles.SetOccupied(PosX, PosY, true);
+    _levelOwner->ActorsIndex.Move(this, oldX, oldY);
+
+    PostMovedEvents();
 
     return true;
   }
@@ -190,7 +189,7 @@ bool GameObject::CanMoveTo(const Position& pos)
   auto curLvl = Map::Instance().CurrentLevel;
 
   bool isBlocked  = curLvl->IsCellBlocking(pos);
-  bool isOccupied = curLvl->MapArray[pos.X][pos.Y]->Occupied;
+  bool isOccupied = curLvl->Tiles.IsOccupied(pos.X, pos.Y);
 
   res = (!isBlocked && !isOccupied);
 
@@ -199,7 +198,7 @@ bool GameObject::CanMoveTo(const Position& pos)
     //
     // Check whether we still can move by levitating over the tile.
     //
-    auto tileType = curLvl->MapArray[pos.X][pos.Y]->Type;
+    auto tileType = curLvl->Tiles.GetType(pos.X, pos.Y);
 
     bool isDangerous = (tileType == GameObjectType::DEEP_WATER
                      || tileType == GameObjectType::CHASM
@@ -221,7 +220,7 @@ bool GameObject::IsSwimming()
   bool isWaterWalking = HasEffect(ItemBonusType::WATER_WALKING);
   bool canSwim        = (GlobalConstants::CanSwimMap.count(Type) == 1
                       && GlobalConstants::CanSwimMap.at(Type) == true);
-  bool isOnDeepWater  = (_currentCell->Type == GameObjectType::DEEP_WATER);
+  bool isOnDeepWater  = IsOnTile(GameObjectType::DEEP_WATER);
 
   return (isOnDeepWater && canSwim && !isFlying && !isWaterWalking);
 }
@@ -278,17 +277,33 @@ void GameObject::Draw(const uint32_t& overrideColorFg,
 
 void GameObject::Update()
 {
-  for (std::pair<const size_t, std::unique_ptr<Component>>& c : _components)
+  uint32_t mask = _tickingComponents;
+
+  for (size_t i = 0; mask != 0; i++, mask >>= 1)
   {
-    if (c.second->IsEnabled)
+    if ((mask & 1) && _components[i]->IsEnabled)
     {
-      c.second->Update();
+      _components[i]->Update();
     }
   }
 }
 
 // =============================================================================
 
+void GameObject::OnTickingComponentAdded(size_t slot)
+{
+  bool wasTicking = (_tickingComponents != 0);
+
+  _tickingComponents |= (1u << slot);
+
+  if (_updateList != nullptr && !wasTicking)
+  {
+    _updateList->OnTickingComponentAdded(this);
+  }
+}
+
+// =============================================================================
+
 void GameObject::ApplyBonuses(ItemComponent* itemRef)
 {
   for (auto& i : itemRef->Data.Bonuses)
@@ -431,21 +446,6 @@ const Position& GameObject::GetPosition()
 
 // =============================================================================
 
-void GameObject::MakeTile(const GameObjectInfo& t,
-                          GameObjectType typeOverride)
-{
-  Blocking     = t.IsBlocking;
-  BlocksSight  = t.BlocksSight;
-  Image        = t.Image;
-  FgColor      = t.FgColor;
-  BgColor      = t.BgColor;
-  ObjectName   = t.ObjectName;
-  FogOfWarName = t.FogOfWarName;
-  Type         = typeOverride;
-}
-
-// =============================================================================
-
 bool GameObject::ReceiveDamage(GameObject* from,
                                int amount,
                                bool isMagical,
@@ -563,8 +563,7 @@ bool GameObject::ReceiveDamage(GameObject* from,
     }
   }
 
-  bool tileVisible =
-      Map::Instance().CurrentLevel->MapArray[PosX][PosY]->Visible;
+  bool tileVisible = Map::Instance().CurrentLevel->Tiles.IsVisible(PosX, PosY);
 
   if (!suppressLog && tileVisible)
   {
@@ -596,11 +595,11 @@ bool GameObject::CanAct()
 
 // =============================================================================
 
-bool GameObject::ShouldSkipTurn()
+bool GameObject::ShouldSkipTurn(int skipTurnsCounter)
 {
   int speed = Attrs.Spd.Get();
 
-  if (speed >= 0 || _skipTurnsCounter >= std::abs(speed))
+  if (speed >= 0 || skipTurnsCounter >= std::abs(speed))
   {
     return false;
   }
@@ -611,6 +610,18 @@ bool GameObject::ShouldSkipTurn()
 // =============================================================================
 
 void GameObject::WaitForTurn()
+{
+  AccumulateActionMeter(Attrs.ActionMeter, _skipTurnsCounter);
+
+  if (Type != GameObjectType::PLAYER)
+  {
+    ProcessEffects();
+  }
+}
+
+// =============================================================================
+
+void GameObject::AccumulateActionMeter(int& actionMeter, int& skipTurnsCounter)
 {
   int actionIncrement = GetActionIncrement();
 
@@ -619,7 +630,7 @@ void GameObject::WaitForTurn()
   //
   if (Map::Instance().CurrentLevel->Peaceful)
   {
-    Attrs.ActionMeter = GlobalConstants::TurnReadyValue;
+    actionMeter = GlobalConstants::TurnReadyValue;
   }
   else
   {
@@ -627,20 +638,106 @@ void GameObject::WaitForTurn()
     // If SPD is < 0, skip std::abs(SPD) amount of turns
     // without gaining action meter.
     //
-    if (ShouldSkipTurn())
+    if (ShouldSkipTurn(skipTurnsCounter))
     {
-      _skipTurnsCounter++;
+      skipTurnsCounter++;
     }
     else
     {
-      _skipTurnsCounter = 0;
-      Attrs.ActionMeter += actionIncrement;
+      skipTurnsCounter = 0;
+      actionMeter += actionIncrement;
     }
   }
+}
 
-  if (Type != GameObjectType::PLAYER)
+// =============================================================================
+
+int GameObject::TicksUntilReady()
+{
+  int actionMeter      = Attrs.ActionMeter;
+  int skipTurnsCounter = _skipTurnsCounter;
+
+  int ticks = 0;
+
+  while (actionMeter < GlobalConstants::TurnReadyValue)
   {
-    ProcessEffects();
+    AccumulateActionMeter(actionMeter, skipTurnsCounter);
+    ticks++;
+  }
+
+  return ticks;
+}
+
+// =============================================================================
+
+void GameObject::SkipWaitingTicks(int ticks)
+{
+  for (int i = 0; i < ticks; i++)
+  {
+    AccumulateActionMeter(Attrs.ActionMeter, _skipTurnsCounter);
+  }
+
+  //
+  // Player's effects are processed in his own WaitForTurn().
+  //
+  _effectsClock += ticks;
+}
+
+// =============================================================================
+
+int GameObject::GetEffectsIdleTicks()
+{
+  if (_effectsActEveryTick)
+  {
+    return 0;
+  }
+
+  if (_nextEffectsEvent == kNoEffectsEvent)
+  {
+    return Component::kUnlimitedIdleTicks;
+  }
+
+  uint64_t res = _nextEffectsEvent - _effectsClock - 1;
+
+  return (int)std::min(res, (uint64_t)Component::kUnlimitedIdleTicks);
+}
+
+// =============================================================================
+
+int GameObject::GetIdleTicks()
+{
+  int res = Component::kUnlimitedIdleTicks;
+
+  uint32_t mask = _tickingComponents;
+
+  for (size_t i = 0; mask != 0; i++, mask >>= 1)
+  {
+    if ((mask & 1) && _components[i]->IsEnabled)
+    {
+      res = std::min(res, _components[i]->GetIdleTicks());
+
+      if (res == 0)
+      {
+        break;
+      }
+    }
+  }
+
+  return res;
+}
+
+// =============================================================================
+
+void GameObject::SkipTicks(int ticks)
+{
+  uint32_t mask = _tickingComponents;
+
+  for (size_t i = 0; mask != 0; i++, mask >>= 1)
+  {
+    if ((mask & 1) && _components[i]->IsEnabled)
+    {
+      _components[i]->SkipTicks(ticks);
+    }
   }
 }
 
@@ -681,9 +778,7 @@ bool GameObject::IsOnDangerousTile()
 {
   bool res = false;
 
-  _currentCell = _levelOwner->MapArray[PosX][PosY].get();
-
-  switch (_currentCell->Type)
+  switch (_levelOwner->Tiles.GetType(PosX, PosY))
   {
     case GameObjectType::DEEP_WATER:
     {
@@ -716,7 +811,7 @@ bool GameObject::IsOnDangerousTile()
 
 bool GameObject::IsOnTile(GameObjectType tileType)
 {
-  return (_currentCell->Type == tileType);
+  return (_levelOwner->Tiles.GetType(PosX, PosY) == tileType);
 }
 
 // =============================================================================
@@ -759,7 +854,10 @@ void GameObject::FinishTurn()
   // and skip trigger position related activation,
   // so we have to check triggers every turn.
   //
-  Map::Instance().UpdateTriggers(TriggerUpdateType::FINISH_TURN);
+  Map::Instance().DispatchTriggerEvent({ TriggerEventType::TURN_FINISHED,
+                                         this,
+                                         nullptr,
+                                         GetPosition() });
 
   CheckPerish();
 }
@@ -862,14 +960,35 @@ void GameObject::ProcessNaturalRegenMP()
 
 void GameObject::MoveGameObject(int dx, int dy)
 {
-  _previousCell = Map::Instance().CurrentLevel->MapArray[PosX][PosY].get();
-  _previousCell->Occupied = false;
+  auto curLvl = Map::Instance().CurrentLevel;
+
+  curLvl->Tiles.SetOccupied(PosX, PosY, false);
 
   PosX += dx;
   PosY += dy;
 
-  _currentCell = Map::Instance().CurrentLevel->MapArray[PosX][PosY].get();
-  _currentCell->Occupied = true;
+  curLvl->Tiles.SetOccupied(PosX, PosY, true);
+  curLvl->ActorsIndex.Move(this, PosX - dx, PosY - dy);
+
+  PostMovedEvents();
+}
+
+// =============================================================================
+
+void GameObject::PostMovedEvents()
+{
+  Map::Instance().PostTriggerEvent({ TriggerEventType::CELL_ENTERED,
+                                     this,
+                                     nullptr,
+                                     GetPosition() });
+
+  if (Type == GameObjectType::PLAYER)
+  {
+    Map::Instance().PostTriggerEvent({ TriggerEventType::PLAYER_MOVED,
+                                       this,
+                                       nullptr,
+                                       GetPosition() });
+  }
 }
 
 // =============================================================================
@@ -881,6 +1000,8 @@ void GameObject::AddEffect(const ItemBonusStruct& effectToAdd)
     return;
   }
 
+  SyncEffects();
+
   uint64_t id = effectToAdd.Id;
 
   //
@@ -931,6 +1052,8 @@ void GameObject::AddEffect(const ItemBonusStruct& effectToAdd)
     }
   }
 
+  RebuildEffectsIndex();
+
   ApplyEffect(effectToAdd);
 
   /*
@@ -1114,38 +1237,18 @@ void GameObject::UnapplyEffect(const ItemBonusStruct& e)
 void GameObject::RemoveEffect(const ItemBonusType& type,
                               const uint64_t& causer)
 {
-  //
-  // Loop goes from end to start to avoid potential skipping
-  // during erasing when there are adjacent elements.
-  //
-  for (int i = _activeEffects.size() - 1; i >= 0; i--)
+  EraseEffects([type, causer](const ItemBonusStruct& bonus)
   {
-    auto it = _activeEffects.begin();
-    std::advance(it, i);
-
-    bool shouldErase = false;
-    for (ItemBonusStruct& bonus : it->second)
-    {
-      if (bonus.Type == type && bonus.Id == causer)
-      {
-        UnapplyEffect(bonus);
-        shouldErase = true;
-        break;
-      }
-    }
-
-    if (shouldErase)
-    {
-      _activeEffects.erase(it);
-    }
-  }
+    return (bonus.Type == type && bonus.Id == causer);
+  },
+  false);
 }
 
 // =============================================================================
 
 void GameObject::AttachTrigger(TriggerType type,
-                               const std::function<bool ()>& condition,
-                               const std::function<void ()>& handler)
+                               const TriggerCondition& condition,
+                               const TriggerHandler& handler)
 {
   AddComponent<TriggerComponent>(type, condition, handler);
 }
@@ -1154,55 +1257,22 @@ void GameObject::AttachTrigger(TriggerType type,
 
 void GameObject::DispelEffectFirstFound(const ItemBonusType& t)
 {
-  for (int i = _activeEffects.size() - 1; i >= 0; i--)
+  EraseEffects([t](const ItemBonusStruct& bonus)
   {
-    auto it = _activeEffects.begin();
-    std::advance(it, i);
-
-    bool shouldErase = false;
-    for (ItemBonusStruct& bonus : it->second)
-    {
-      if (bonus.Type == t && !bonus.Persistent)
-      {
-        UnapplyEffect(bonus);
-        shouldErase = true;
-        break;
-      }
-    }
-
-    if (shouldErase)
-    {
-      _activeEffects.erase(it);
-      break;
-    }
-  }
+    return (bonus.Type == t && !bonus.Persistent);
+  },
+  true);
 }
 
 // =============================================================================
 
 void GameObject::DispelEffectsAllOf(const ItemBonusType& type)
 {
-  for (int i = _activeEffects.size() - 1; i >= 0; i--)
+  EraseEffects([type](const ItemBonusStruct& bonus)
   {
-    auto it = _activeEffects.begin();
-    std::advance(it, i);
-
-    bool shouldErase = false;
-    for (ItemBonusStruct& bonus : it->second)
-    {
-      if (bonus.Type == type && !bonus.Persistent)
-      {
-        UnapplyEffect(bonus);
-        shouldErase = true;
-        break;
-      }
-    }
-
-    if (shouldErase)
-    {
-      _activeEffects.erase(it);
-    }
-  }
+    return (bonus.Type == type && !bonus.Persistent);
+  },
+  false);
 }
 
 #ifdef DEBUG_BUILD
@@ -1211,15 +1281,29 @@ void GameObject::DispelEffectsAllOf(const ItemBonusType& type)
 
 void GameObject::DispelEffects()
 {
-  for (int i = _activeEffects.size() - 1; i >= 0; i--)
+  EraseEffects([](const ItemBonusStruct& bonus)
   {
-    auto it = _activeEffects.begin();
-    std::advance(it, i);
+    return !bonus.Persistent;
+  },
+  false);
+}
+
+#endif
+
+// =============================================================================
+
+void GameObject::EraseEffects(
+    const std::function<bool(const ItemBonusStruct&)>& pred,
+    bool firstOnly)
+{
+  SyncEffects();
 
+  for (auto it = _activeEffects.begin(); it != _activeEffects.end(); )
+  {
     bool shouldErase = false;
     for (ItemBonusStruct& bonus : it->second)
     {
-      if (!bonus.Persistent)
+      if (pred(bonus))
       {
         UnapplyEffect(bonus);
         shouldErase = true;
@@ -1229,35 +1313,49 @@ void GameObject::DispelEffects()
 
     if (shouldErase)
     {
-      _activeEffects.erase(it);
+      it = _activeEffects.erase(it);
+
+      if (firstOnly)
+      {
+        break;
+      }
+    }
+    else
+    {
+      it++;
     }
   }
-}
 
-#endif
+  RebuildEffectsIndex();
+}
 
 // =============================================================================
 
 bool GameObject::HasEffect(const ItemBonusType& t)
 {
-  for (auto& kvp : _activeEffects)
-  {
-    for (auto& i : kvp.second)
-    {
-      if (i.Type == t)
-      {
-        return true;
-      }
-    }
-  }
-
-  return false;
+  return (_effectsMask & (1ULL << (size_t)t)) != 0;
 }
 
 // =============================================================================
 
 void GameObject::ProcessEffects()
 {
+  _effectsClock++;
+
+  if (!_effectsActEveryTick && _effectsClock < _nextEffectsEvent)
+  {
+    return;
+  }
+
+  //
+  // Catch up to the previous call, this one is carried out for real.
+  //
+  _effectsClock--;
+  SyncEffects();
+  _effectsClock++;
+
+  _effectsSyncedAt = _effectsClock;
+
   auto ProcessEffect = [this](ItemBonusStruct& ibs)
   {
     if (ibs.Period > 0)
@@ -1276,12 +1374,9 @@ void GameObject::ProcessEffects()
     }
   };
 
-  for (int i = _activeEffects.size() - 1; i >= 0; i--)
+  for (auto it = _activeEffects.begin(); it != _activeEffects.end(); )
   {
-    auto it = _activeEffects.begin();
-    std::advance(it, i);
-
-    auto& ae = _activeEffects[it->first];
+    auto& ae = it->second;
     for (int j = ae.size() - 1; j >= 0; j--)
     {
       if (ae[j].Duration > 0)
@@ -1313,7 +1408,106 @@ void GameObject::ProcessEffects()
 
     if (ae.empty())
     {
-      _activeEffects.erase(it);
+      it = _activeEffects.erase(it);
+    }
+    else
+    {
+      it++;
+    }
+  }
+
+  RebuildEffectsIndex();
+}
+
+// =============================================================================
+
+void GameObject::SyncEffects()
+{
+  uint64_t elapsed = _effectsClock - _effectsSyncedAt;
+  if (elapsed == 0)
+  {
+    return;
+  }
+
+  _effectsSyncedAt = _effectsClock;
+
+  //
+  // Nothing fired or expired during these calls
+  // (see RebuildEffectsIndex()), so they only counted down.
+  //
+  for (auto& kvp : _activeEffects)
+  {
+    for (ItemBonusStruct& e : kvp.second)
+    {
+      if (e.Duration > 0 || e.Duration == -1)
+      {
+        if (e.Period > 0)
+        {
+          e.EffectCounter += (int)elapsed;
+        }
+
+        if (e.Duration > 0)
+        {
+          e.Duration -= (int)elapsed;
+        }
+      }
+    }
+  }
+}
+
+// =============================================================================
+
+void GameObject::RebuildEffectsIndex()
+{
+  _effectsMask         = 0;
+  _effectsActEveryTick = false;
+  _nextEffectsEvent    = kNoEffectsEvent;
+
+  uint64_t now = _effectsSyncedAt;
+
+  for (auto& kvp : _activeEffects)
+  {
+    for (const ItemBonusStruct& e : kvp.second)
+    {
+      _effectsMask |= (1ULL << (size_t)e.Type);
+
+      uint64_t next = kNoEffectsEvent;
+
+      if (e.Duration == 0)
+      {
+        next = now + 1;
+      }
+      else if (e.Duration > 0 || e.Duration == -1)
+      {
+        if (e.Period > 0)
+        {
+          int counter = e.EffectCounter % e.Period;
+          if (counter < 0)
+          {
+            counter += e.Period;
+          }
+
+          //
+          // Effect acts only while its duration hasn't run out.
+          //
+          uint64_t fire = now + (e.Period - counter);
+          if (e.Duration == -1 || fire <= now + e.Duration)
+          {
+            next = fire;
+          }
+        }
+        else if (HasEffectAction(e.Type))
+        {
+          _effectsActEveryTick = true;
+        }
+
+        if (e.Duration > 0)
+        {
+          next = std::min(next, now + e.Duration + 1);
+        }
+      }
+
+      _nextEffectsEvent = std::min(_nextEffectsEvent, next);
     }
   }
 }
@@ -1354,6 +1548,25 @@ void GameObject::ProcessItemsEffects()
 
 // =============================================================================
 
+bool GameObject::HasEffectAction(const ItemBonusType& t)
+{
+  switch (t)
+  {
+    case ItemBonusType::BURNING:
+    case ItemBonusType::POISONED:
+    case ItemBonusType::REGEN:
+    case ItemBonusType::PARALYZE:
+      return true;
+  }
+
+  return false;
+}
+
+// =============================================================================
+
+//
+// Keep HasEffectAction() in sync.
+//
 void GameObject::EffectAction(const ItemBonusStruct& e)
 {
   switch (e.Type)
@@ -1422,7 +1635,17 @@ void GameObject::SetLevelOwner(MapLevelBase *levelOwner)
 
 size_t GameObject::ComponentsSize()
 {
-  return _components.size();
+  size_t res = 0;
+
+  for (auto& c : _components)
+  {
+    if (c != nullptr)
+    {
+      res++;
+    }
+  }
+
+  return res;
 }
 
 // =============================================================================
@@ -1621,6 +1844,8 @@ bool GameObject::CanRaiseAttribute(Attribute& attr)
 const std::unordered_map<uint64_t, std::vector<ItemBonusStruct>>&
 GameObject::GetActiveEffects()
 {
+  SyncEffects();
+
   return _activeEffects;
 }
 
@@ -1641,6 +1866,13 @@ const uint64_t& GameObject::ObjectId()
 
 // =============================================================================
 
+const GameObjectHandle& GameObject::Handle()
+{
+  return _handle;
+}
+
+// =============================================================================
+
 void GameObject::MaskToBoolFlags(const uint16_t mask)
 {
   std::map<int, bool&> traverseMap =
@@ -1816,17 +2048,24 @@ std::vector<std::string> GameObject::DebugInfo()
   str = Util::StringFormat("  BgColor: %06X", BgColor);
   res.push_back(str);
 
-  str = Util::StringFormat("  Components: %zu", _components.size());
+  str = Util::StringFormat("  Components: %zu", ComponentsSize());
   res.push_back(str);
 
-  for (auto& kvp : _components)
+  for (auto& c : _components)
   {
+    if (c == nullptr)
+    {
+      continue;
+    }
+
     str = Util::StringFormat("    %s [0x%X]",
-                             typeid(*kvp.second.get()).name(),
-                             kvp.second.get());
+                             typeid(*c.get()).name(),
+                             c.get());
     res.push_back(str);
   }
 
+  SyncEffects();
+
   str = Util::StringFormat("  Effects: %zu", _activeEffects.size());
   res.push_back(str);
 
@@ -2,6 +2,8 @@
 #define GAME_OBJECT_H
 
 #include <string>
+#include <array>
+#include <type_traits>
 #include <map>
 #include <memory>
 #include <functional>
@@ -12,6 +14,8 @@
 #endif
 
 #include "component.h"
+#include "trigger-component.h"
+#include "game-objects-registry.h"
 #include "constants.h"
 #include "enumerations.h"
 #include "attribute.h"
@@ -19,6 +23,7 @@
 #include "util.h"
 
 class GameObjectInfo;
+class UpdateList;
 class MapLevelBase;
 class Position;
 class Node;
@@ -69,15 +74,17 @@ class GameObject
     template <typename T, typename ... Args>
     inline T* AddComponent(Args ... args)
     {
-      if (_components.count(typeid(T).hash_code()) == 1)
+      auto& slot = _components[ComponentSlot<T>()];
+
+      if (slot != nullptr)
       {
         DebugLog("[WAR] trying to add existing component %s "
                  "on game object [0x%X] - returning existing 0x%X",
                  typeid(T).name(),
                  this,
-                 _components[typeid(T).hash_code()].get());
+                 slot.get());
 
-        return static_cast<T*>(_components[typeid(T).hash_code()].get());
+        return static_cast<T*>(slot.get());
       }
 
       std::unique_ptr<T> cp = std::make_unique<T>(args ...);
@@ -85,36 +92,30 @@ class GameObject
       cp->Prepare(this);
 
       // cp is null after std::move
-      _components[typeid(T).hash_code()] = std::move(cp);
+      slot = std::move(cp);
 
-      return static_cast<T*>(_components[typeid(T).hash_code()].get());
+      if (slot->IsTicking())
+      {
+        OnTickingComponentAdded(ComponentSlot<T>());
+      }
+
+      return static_cast<T*>(slot.get());
     }
 
     template <typename T>
     inline T* GetComponent()
     {
-      for (auto& c : _components)
-      {
-        if (c.second.get() != nullptr && typeid(*c.second.get()) == typeid(T))
-        {
-          return static_cast<T*>(c.second.get());
-        }
-      }
-
-      return nullptr;
+      return static_cast<T*>(_components[ComponentSlot<T>()].get());
     }
 
     template <typename T>
     inline bool HasComponent()
     {
-      return (GetComponent<T>() != nullptr);
+      return (_components[ComponentSlot<T>()] != nullptr);
     }
 
     void Serialize(NRS& section);
 
-    void MakeTile(const GameObjectInfo& t,
-                  GameObjectType typeOverride = GameObjectType::GROUND);
-
     void Update();
 
     // ---------------------------------------
@@ -216,6 +217,32 @@ class GameObject
     void FinishTurn();
     void WaitForTurn();
 
+    //
+    // Number of WaitForTurn() calls needed for action meter to fill up,
+    // provided that SPD doesn't change meanwhile.
+    //
+    int TicksUntilReady();
+
+    //
+    // Same as calling WaitForTurn() that many times,
+    // provided that it's not more than GetEffectsIdleTicks().
+    //
+    void SkipWaitingTicks(int ticks);
+
+    //
+    // Number of upcoming ProcessEffects() calls
+    // during which none of active effects does anything
+    // (no periodic action, nothing expires).
+    //
+    int GetEffectsIdleTicks();
+
+    //
+    // Minimum of ticking components' idle ticks and SkipTicks() on them
+    // (see Component::GetIdleTicks()).
+    //
+    int GetIdleTicks();
+    void SkipTicks(int ticks);
+
     virtual void AwardExperience(int amount);
     virtual void LevelUp(int baseHpOverride = -1);
     virtual void LevelDown();
@@ -239,8 +266,8 @@ class GameObject
     void RemoveEffect(const ItemBonusType& type, const uint64_t& causer);
 
     void AttachTrigger(TriggerType type,
-                       const std::function<bool()>& condition,
-                       const std::function<void()>& handler);
+                       const TriggerCondition& condition,
+                       const TriggerHandler& handler);
 
     void CheckPerish();
 
@@ -261,6 +288,11 @@ class GameObject
 
     const uint64_t& ObjectId();
 
+    //
+    // See GameObjectsRegistry.
+    //
+    const GameObjectHandle& Handle();
+
     uint64_t StackObjectId = 0;
 
     Attributes Attrs;
@@ -302,11 +334,61 @@ class GameObject
     const SaveDataMinimal& GetSaveDataMinimal();
 
   protected:
-    std::unordered_map<size_t, std::unique_ptr<Component>> _components;
+    //
+    // One slot per component type, indexed by T::TypeId.
+    //
+    std::array<std::unique_ptr<Component>,
+               (size_t)ComponentType::LAST_ELEMENT> _components;
     std::unordered_map<uint64_t, std::vector<ItemBonusStruct>> _activeEffects;
 
-    GameObject* _previousCell = nullptr;
-    GameObject* _currentCell = nullptr;
+    //
+    // Bit per ItemBonusType present in _activeEffects.
+    //
+    uint64_t _effectsMask = 0;
+
+    static_assert((size_t)ItemBonusType::LAST_ELEMENT <= 64,
+                  "Too many bonus types for effects mask");
+
+    //
+    // Number of ProcessEffects() calls so far.
+    //
+    // Calls that don't fire or expire anything are not carried out,
+    // Duration and EffectCounter of active effects are caught up
+    // in SyncEffects() instead when somebody needs them.
+    //
+    uint64_t _effectsClock = 0;
+
+    //
+    // Clock value Duration and EffectCounter are valid for.
+    //
+    uint64_t _effectsSyncedAt = 0;
+
+    static constexpr uint64_t kNoEffectsEvent = UINT64_MAX;
+
+    //
+    // Clock value of the call where something fires or expires.
+    //
+    uint64_t _nextEffectsEvent = kNoEffectsEvent;
+
+    //
+    // Some effect acts on every call (e.g. PARALYZE),
+    // so every ProcessEffects() call must be carried out.
+    //
+    bool _effectsActEveryTick = false;
+
+    //
+    // Bit per slot of components that need Update()
+    // (see Component::IsTicking()).
+    //
+    uint32_t _tickingComponents = 0;
+
+    static_assert((size_t)ComponentType::LAST_ELEMENT <= 32,
+                  "Too many component types for ticking mask");
+
+    //
+    // Set by the level's UpdateList this object is in, if any.
+    //
+    UpdateList* _updateList = nullptr;
 
     SaveDataMinimal _sdm;
 
@@ -323,12 +405,51 @@ class GameObject
     int _manaRegenTurnsCounter   = 0;
     int _skipTurnsCounter        = 0;
 
+    template <typename T>
+    static constexpr size_t ComponentSlot()
+    {
+      static_assert(std::is_base_of<Component, T>::value,
+                    "T must be derived from Component");
+
+      static_assert(T::TypeId < ComponentType::LAST_ELEMENT,
+                    "Bad component TypeId");
+
+      return (size_t)T::TypeId;
+    }
+
+    void OnTickingComponentAdded(size_t slot);
+
     void MoveGameObject(int dx, int dy);
+
+    //
+    // CELL_ENTERED and PLAYER_MOVED for triggers.
+    //
+    void PostMovedEvents();
     void ProcessEffects();
     void ProcessItemsEffects();
+
+    //
+    // Applies skipped ProcessEffects() calls up to _effectsClock.
+    //
+    void SyncEffects();
+
+    //
+    // Must be called after every change of _activeEffects,
+    // which must be synced by then.
+    //
+    void RebuildEffectsIndex();
+
+    //
+    // Unapplies effect that satisfies pred and erases
+    // the whole entry of its causer.
+    //
+    void EraseEffects(const std::function<bool(const ItemBonusStruct&)>& pred,
+                      bool firstOnly);
     void ApplyEffect(const ItemBonusStruct& e);
     void UnapplyEffect(const ItemBonusStruct& e);
     void EffectAction(const ItemBonusStruct& e);
+
+    static bool HasEffectAction(const ItemBonusType& t);
     void MarkAndCreateRemains();
     void ProcessNaturalRegenHP();
     void ProcessNaturalRegenMP();
@@ -337,7 +458,9 @@ class GameObject
     void TileStandingCheck();
 
     bool CanRaiseAttribute(Attribute& attr);
-    bool ShouldSkipTurn();
+    bool ShouldSkipTurn(int skipTurnsCounter);
+
+    void AccumulateActionMeter(int& actionMeter, int& skipTurnsCounter);
     bool IsImmune(const ItemBonusStruct& effectToAdd);
 
     void LevelUpFromHistory(int gainedLevel, bool positive);
@@ -348,6 +471,8 @@ class GameObject
     //
     uint64_t _objectId = 0;
 
+    GameObjectHandle _handle;
+
     const std::unordered_map<ItemBonusType, Attribute&> _attributesRefsByBonus =
     {
       { ItemBonusType::STR, Attrs.Str },
@@ -405,14 +530,11 @@ class GameObject
     };
 
     friend class GameObjectsFactory;
+    friend class UpdateList;
 
 #ifdef DEBUG_BUILD
     friend class DevConsole;
 #endif
 };
 
-#ifdef DEBUG_BUILD
-extern std::unordered_map<uint64_t, GameObject*> GameObjectsById;
-#endif
-
 #endif
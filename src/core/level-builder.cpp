@@ -12,15 +12,27 @@
 #include "rooms.h"
 #include "util.h"
 
+LevelBuilder::LevelBuilder()
+  : LevelBuilder(RNG::Instance().Seed)
+{
+}
+
+// =============================================================================
+
+LevelBuilder::LevelBuilder(uint64_t seed)
+  : _seed(seed)
+{
+}
+
+// =============================================================================
+
 void LevelBuilder::FeatureRoomsMethod(const Position& mapSize,
                                       const Position& roomSizes,
                                       const FeatureRoomsWeights& weightsMap,
                                       uint8_t doorPlacementChance,
                                       int maxIterations)
 {
-  _generator.reset(new FeatureRooms());
-
-  FeatureRooms* fr = static_cast<FeatureRooms*>(_generator.get());
+  FeatureRooms* fr = CreateGenerator<FeatureRooms>();
   fr->Generate(mapSize,
                roomSizes,
                weightsMap,
@@ -38,9 +50,7 @@ void LevelBuilder::CellularAutomataMethod(const Position& mapSize,
                                           int deathThreshold,
                                           int maxIterations)
 {
-  _generator.reset(new CellularAutomata());
-
-  CellularAutomata* ca = static_cast<CellularAutomata*>(_generator.get());
+  CellularAutomata* ca = CreateGenerator<CellularAutomata>();
   ca->Generate(mapSize,
                initialWallChance,
                birthThreshold,
@@ -57,9 +67,7 @@ void LevelBuilder::BacktrackingTunnelerMethod(const Position& mapSize,
                                               const Position& start,
                                               bool additionalTweaks)
 {
-  _generator.reset(new Tunneler());
-
-  Tunneler* t = static_cast<Tunneler*>(_generator.get());
+  Tunneler* t = CreateGenerator<Tunneler>();
   t->Backtracking(mapSize, tunnelMinMax, start, additionalTweaks);
 
   MapRaw = t->MapRaw;
@@ -72,9 +80,7 @@ void LevelBuilder::TunnelerMethod(const Position& mapSize,
                                   const Position& tunnelLengthMinMax,
                                   const Position& start)
 {
-  _generator.reset(new Tunneler());
-
-  Tunneler* t = static_cast<Tunneler*>(_generator.get());
+  Tunneler* t = CreateGenerator<Tunneler>();
   t->Normal(mapSize, tunnelLengthMinMax, start, maxIterations, true);
 
   MapRaw = t->MapRaw;
@@ -88,10 +94,7 @@ void LevelBuilder::RecursiveBacktrackerMethod(
     const RemovalParams& endWallsRemovalParams
     )
 {
-  _generator.reset(new RecursiveBacktracker());
-
-  RecursiveBacktracker* rb =
-      static_cast<RecursiveBacktracker*>(_generator.get());
+  RecursiveBacktracker* rb = CreateGenerator<RecursiveBacktracker>();
 
   rb->Generate(mapSize, startingPoint, endWallsRemovalParams);
 
@@ -105,9 +108,7 @@ void LevelBuilder::FromBlobTiles(int mapSizeX, int mapSizeY,
                                  int wallsSizeFactor,
                                  bool postProcess)
 {
-  _generator.reset(new BlobTiles());
-
-  BlobTiles* bt = static_cast<BlobTiles*>(_generator.get());
+  BlobTiles* bt = CreateGenerator<BlobTiles>();
   bt->Generate(mapSizeX,
                mapSizeY,
                tileSizeFactor,
@@ -123,9 +124,7 @@ void LevelBuilder::BSPRoomsMethod(const Position& mapSize,
                                   const Position& splitRatio,
                                   int minRoomSize)
 {
-  _generator.reset(new BSPRooms());
-
-  BSPRooms* fl = static_cast<BSPRooms*>(_generator.get());
+  BSPRooms* fl = CreateGenerator<BSPRooms>();
   fl->Generate(mapSize, splitRatio, minRoomSize);
 
   MapRaw = fl->MapRaw;
@@ -137,9 +136,7 @@ void LevelBuilder::RoomsMethod(const Position& mapSize,
                                const Position& roomSizes,
                                int maxIterations)
 {
-  _generator.reset(new Rooms());
-
-  Rooms* r = static_cast<Rooms*>(_generator.get());
+  Rooms* r = CreateGenerator<Rooms>();
   r->Generate(mapSize, roomSizes, maxIterations);
 
   MapRaw = r->MapRaw;
@@ -152,10 +149,7 @@ void LevelBuilder::FromPermutationTilesMethod(const Position& mapSize,
                                               bool postProcess,
                                               bool removeBias)
 {
-  _generator.reset(new FromPermutationTiles());
-
-  FromPermutationTiles* ft =
-      static_cast<FromPermutationTiles*>(_generator.get());
+  FromPermutationTiles* ft = CreateGenerator<FromPermutationTiles>();
 
   ft->Generate(mapSize, tileSetIndex, postProcess, removeBias);
 
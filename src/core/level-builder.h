@@ -8,6 +8,13 @@
 class LevelBuilder
 {
   public:
+    //
+    // Default seed is the world one,
+    // levels pass their own (see MapLevelBase::GetLayoutSeed()).
+    //
+    LevelBuilder();
+    explicit LevelBuilder(uint64_t seed);
+
     void FromBlobTiles(int mapSizeX, int mapSizeY,
                        int tileSizeFactor,
                        int wallsSizeFactor,
@@ -87,8 +94,19 @@ class LevelBuilder
     std::map<Position, ShrineType>& ShrinesByPosition();
 
   private:
+    template <typename T>
+    T* CreateGenerator()
+    {
+      _generator.reset(new T());
+      _generator->SetSeed(_seed);
+
+      return static_cast<T*>(_generator.get());
+    }
+
     std::unique_ptr<DGBase> _generator;
 
+    uint64_t _seed = 0;
+
     MapCell _cellInfo;
 
     std::vector<Rect> _emptyRoomsStub;
@@ -12,15 +12,14 @@
 #include "spells-database.h"
 #include "custom-class-state.h"
 #include "gid-generator.h"
-#include "timer.h"
+#include "profiler.h"
 
 void Player::Init()
 {
   _objectId = GID::Instance().GenerateGlobalId();
 
-#ifdef DEBUG_BUILD
-  GameObjectsById[_objectId] = this;
-#endif
+  GameObjectsRegistry::Instance().Release(_handle);
+  _handle = GameObjectsRegistry::Instance().Register(this);
 
   Type = GameObjectType::PLAYER;
 
@@ -37,8 +36,13 @@ void Player::Init()
 
   Attrs.ActionMeter = GlobalConstants::TurnReadyValue;
 
-  _components.clear();
+  for (auto& c : _components)
+  {
+    c.reset();
+  }
+
   _activeEffects.clear();
+  RebuildEffectsIndex();
 
   Inventory = AddComponent<ContainerComponent>();
   Equipment = AddComponent<EquipmentComponent>(Inventory);
@@ -48,17 +52,16 @@ void Player::Init()
   SetDefaultEquipment();
   SetDefaultSkills();
 
-  _previousCell = Map::Instance().CurrentLevel->MapArray[PosX][PosY].get();
-  _currentCell  = Map::Instance().CurrentLevel->MapArray[PosX][PosY].get();
-
-  _currentCell->Occupied = true;
+  Map::Instance().CurrentLevel->Tiles.SetOccupied(PosX, PosY, true);
 
   int expToLvlUp = Util::GetExpForNextLevel(Attrs.Lvl.Get());
 
   Attrs.Exp.Reset(0);
   Attrs.Exp.SetMax(expToLvlUp);
 
-  DistanceField.Init(this, kDistanceFieldRadius);
+  DistanceField.Init(this);
+  LevitatingDistanceField.Init(this, true);
+  FOV.Init(this);
 }
 
 // =============================================================================
@@ -84,7 +87,7 @@ void Player::Draw()
     }
     else
     {
-      bgColor = mapRef->MapArray[PosX][PosY]->BgColor;
+      bgColor = mapRef->Tiles.GetBgColor(PosX, PosY);
     }
   }
 
@@ -127,24 +130,26 @@ bool Player::Move(int dx, int dy)
 {
   MapLevelBase* curLvl = Map::Instance().CurrentLevel;
 
-  auto cell         = curLvl->MapArray[PosX + dx][PosY + dy].get();
-  auto staticObject = curLvl->StaticMapObjects[PosX + dx][PosY + dy].get();
+  int nx = PosX + dx;
+  int ny = PosY + dy;
+
+  auto staticObject = curLvl->StaticMapObjects[nx][ny].get();
 
   bool moveOk = false;
   bool passByNPC = false;
 
   bool isFlying = HasEffect(ItemBonusType::LEVITATION);
 
-  if (!cell->Blocking || isFlying)
+  if (!curLvl->Tiles.IsBlocking(nx, ny) || isFlying)
   {
     //
     // Occupied is set only by actors, so if actor is present on this cell,
     // it can be walked into so there's no need to check for static object
     // there.
     //
-    if (cell->Occupied)
+    if (curLvl->Tiles.IsOccupied(nx, ny))
     {
-      auto actor = Map::Instance().GetActorAtPosition(PosX + dx, PosY + dy);
+      auto actor = Map::Instance().GetActorAtPosition(nx, ny);
       if (actor != nullptr)
       {
         //
@@ -197,6 +202,7 @@ bool Player::Move(int dx, int dy)
   if (moveOk || passByNPC)
   {
     DistanceField.SetDirty();
+    LevitatingDistanceField.SetDirty();
   }
 
   return moveOk;
@@ -204,6 +210,48 @@ bool Player::Move(int dx, int dy)
 
 // =============================================================================
 
+bool Player::GetStepTowards(GameObject* actor, Position& res)
+{
+  bool levitating = actor->HasEffect(ItemBonusType::LEVITATION);
+
+  PotentialField& field = levitating ? LevitatingDistanceField : DistanceField;
+
+  if (field.IsDirty())
+  {
+    field.Emanate();
+  }
+
+  PotentialField::Cell* c = field.GetCellCloserToOwner(actor);
+  if (c != nullptr)
+  {
+    res = c->MapPos;
+    return true;
+  }
+
+  //
+  // Field doesn't know about actors, so if they're in the way
+  // we have to go around them the old fashioned way.
+  //
+  auto curLvl = Map::Instance().CurrentLevel;
+
+  auto path = curLvl->LevelPathfinder.BuildRoad(curLvl,
+                                                actor->GetPosition(),
+                                                GetPosition(),
+                                                std::vector<char>(),
+                                                false,
+                                                true);
+  if (path.empty())
+  {
+    return false;
+  }
+
+  res = path.top();
+
+  return true;
+}
+
+// =============================================================================
+
 bool Player::PassByNPC(GameObject* actor)
 {
   bool ok = true;
@@ -232,9 +280,23 @@ bool Player::PassByNPC(GameObject* actor)
 
 // =============================================================================
 
+int Player::GetVisibilityRadius()
+{
+  auto& tiles = Map::Instance().CurrentLevel->Tiles;
+
+  //
+  // FIXME: some objects can modify visibility radius
+  //
+  return (tiles.GetName(PosX, PosY) == Strings::TileNames::TreeText)
+         ? VisibilityRadius.Get() / 4
+         : VisibilityRadius.Get();
+}
+
+// =============================================================================
+
 void Player::CheckVisibility()
 {
-  Timer::Instance().StartProfiling("  Player::CheckVisibility()");
+  PROFILE_ZONE(ProfilerZone::CHECK_VISIBILITY);
 
   int tw = Printer::TerminalWidth;
   int th = Printer::TerminalHeight;
@@ -242,91 +304,70 @@ void Player::CheckVisibility()
   //
   // Update map around player.
   //
-  auto& map = Map::Instance().CurrentLevel->MapArray;
-  auto& staticObjects = Map::Instance().CurrentLevel->StaticMapObjects;
+  FOV.Compute(GetVisibilityRadius(), tw / 2, th / 2);
 
   //
-  // FIXME: some objects can modify visibility radius
+  // Hide only what was visible before instead of the whole screen.
   //
-  int radius = (map[PosX][PosY]->ObjectName == Strings::TileNames::TreeText)
-              ? VisibilityRadius.Get() / 4
-              : VisibilityRadius.Get();
-
-  auto mapCells = Util::GetRectAroundPoint(PosX,
-                                           PosY,
-                                           tw / 2,
-                                           th / 2,
-                                           Map::Instance().CurrentLevel->MapSize);
-
-#ifdef DEBUG_BUILD
-  for (auto& cell : mapCells)
+  MapLevelBase* prevLvl = FOV.GetPreviousLevel();
+  if (prevLvl != nullptr)
   {
-    map[cell.X][cell.Y]->Visible = ToggleFogOfWar;
-
-    if (staticObjects[cell.X][cell.Y] != nullptr)
+    for (auto& cell : FOV.GetPreviouslyVisibleCells())
     {
-      staticObjects[cell.X][cell.Y]->Visible = ToggleFogOfWar;
-    }
-  }
-#else
-  for (auto& cell : mapCells)
-  {
-    map[cell.X][cell.Y]->Visible = false;
+      prevLvl->Tiles.SetVisible(cell.X, cell.Y, false);
 
-    if (staticObjects[cell.X][cell.Y] != nullptr)
-    {
-      staticObjects[cell.X][cell.Y]->Visible = false;
+      auto& so = prevLvl->StaticMapObjects[cell.X][cell.Y];
+      if (so != nullptr)
+      {
+        so->Visible = false;
+      }
     }
   }
-#endif
 
-  //
-  // Update visibility around player.
-  //
-  for (auto& cell : mapCells)
+#ifdef DEBUG_BUILD
+  if (ToggleFogOfWar || _fogOfWarWasToggled)
   {
-    double d = Util::LinearDistance(PosX, PosY, cell.X, cell.Y);
+    auto& tiles = Map::Instance().CurrentLevel->Tiles;
+    auto& staticObjects = Map::Instance().CurrentLevel->StaticMapObjects;
 
-    if (d > (double)radius)
-    {
-      continue;
-    }
+    auto mapCells =
+        Util::GetRectAroundPoint(PosX,
+                                 PosY,
+                                 tw / 2,
+                                 th / 2,
+                                 Map::Instance().CurrentLevel->MapSize);
 
-    //
-    // Bresenham driven Field of Vision
-    //
-    // From what I understand it's considered most shitty implementation of one,
-    // but it'll do for now.
-    //
-    auto line = Util::BresenhamLine(PosX, PosY, cell.X, cell.Y);
-    for (auto& point : line)
+    for (auto& cell : mapCells)
     {
-      if (point.X == PosX && point.Y == PosY)
-      {
-        continue;
-      }
-
-      DiscoverCell(point.X, point.Y);
-
-      bool mapBlock = map[point.X][point.Y]->BlocksSight;
-      bool staticBlock = (staticObjects[point.X][point.Y] != nullptr
-                       && staticObjects[point.X][point.Y]->BlocksSight);
+      tiles.SetVisible(cell.X, cell.Y, ToggleFogOfWar);
 
-      if (mapBlock || staticBlock)
+      if (staticObjects[cell.X][cell.Y] != nullptr)
       {
-        break;
+        staticObjects[cell.X][cell.Y]->Visible = ToggleFogOfWar;
       }
     }
   }
 
-  Timer::Instance().FinishProfiling("  Player::CheckVisibility()");
+  _fogOfWarWasToggled = ToggleFogOfWar;
+#endif
+
+  //
+  // Update visibility around player.
+  //
+  // Every visible cell is visited only once by shadowcasting,
+  // unlike casting Bresenham line to every cell in radius.
+  //
+  for (auto& cell : FOV.GetVisibleCells())
+  {
+    DiscoverCell(cell.X, cell.Y);
+  }
 }
 
 // =============================================================================
 
 void Player::DiscoverCell(int x, int y)
 {
-  auto& map = Map::Instance().CurrentLevel->MapArray;
+  auto& tiles = Map::Instance().CurrentLevel->Tiles;
   auto& staticObjects = Map::Instance().CurrentLevel->StaticMapObjects;
 
   auto curLvl = Map::Instance().CurrentLevel;
@@ -338,7 +379,7 @@ void Player::DiscoverCell(int x, int y)
     curLvl->ExitFound = true;
   }
 
-  map[x][y]->Visible = true;
+  tiles.SetVisible(x, y, true);
 
   if (staticObjects[x][y] != nullptr)
   {
@@ -350,10 +391,14 @@ void Player::DiscoverCell(int x, int y)
   {
     curLvl->UpdateFowLayer(top);
   }
+  else
+  {
+    curLvl->UpdateFowLayerFromTile(x, y);
+  }
 
-  if (!map[x][y]->Revealed)
+  if (!tiles.IsRevealed(x, y))
   {
-    map[x][y]->Revealed = true;
+    tiles.SetRevealed(x, y, true);
 
     if (staticObjects[x][y] != nullptr)
     {
@@ -1450,11 +1495,23 @@ void Player::FinishTurn()
     Attrs.HP.Reset(0);
   }
 
+  Application::Instance().PlayerTurnsPassed++;
+
   //
   // So that triggers condition check happens
   // regardless of player's SPD.
   //
-  Map::Instance().UpdateTriggers(TriggerUpdateType::FINISH_TURN);
+  TriggerEvent e = { TriggerEventType::TURN_FINISHED,
+                     this,
+                     nullptr,
+                     GetPosition() };
+
+  Map::Instance().DispatchTriggerEvent(e);
+
+  e.Type = TriggerEventType::TURN_REACHED;
+  e.Turn = Application::Instance().PlayerTurnsPassed;
+
+  Map::Instance().DispatchTriggerEvent(e);
 
   //
   // If player killed an enemy but can still make another turn,
@@ -1468,8 +1525,6 @@ void Player::FinishTurn()
   // Probably bad design anyway but fuck it.
   //
   Map::Instance().RemoveDestroyed();
-
-  Application::Instance().PlayerTurnsPassed++;
 }
 
 // =============================================================================
@@ -15,6 +15,7 @@
 #include "item-component.h"
 #include "position.h"
 #include "potential-field.h"
+#include "field-of-view.h"
 
 class AIComponent;
 
@@ -29,6 +30,11 @@ class Player : public GameObject
 
     void CheckVisibility();
 
+    //
+    // VisibilityRadius adjusted by what player is standing on.
+    //
+    int GetVisibilityRadius();
+
     bool TryToMeleeAttack(int dx, int dy);
 
     int SelectedClass;
@@ -78,6 +84,19 @@ class Player : public GameObject
     std::unordered_map<std::string, int> TotalKills;
 
     PotentialField DistanceField;
+    PotentialField LevitatingDistanceField;
+
+    //
+    // Next cell for actor to move into on its way to player.
+    // Falls back to A* around other actors if distance field
+    // doesn't lead anywhere from actor's position.
+    //
+    bool GetStepTowards(GameObject* actor, Position& res);
+
+    //
+    // Cells currently visible by player.
+    //
+    FieldOfView FOV;
 
     #ifdef DEBUG_BUILD
     bool ToggleFogOfWar = false;
@@ -127,6 +146,10 @@ class Player : public GameObject
 
     int _starvingTimeout = 0;
 
+    #ifdef DEBUG_BUILD
+    bool _fogOfWarWasToggled = false;
+    #endif
+
     std::vector<std::string> GetPrettyLevelUpText();
 
     //
@@ -164,8 +187,6 @@ class Player : public GameObject
     Position _attackDir;
     Position _knockBackDir;
 
-    const uint8_t kDistanceFieldRadius = 40;
-
     friend class SpellsProcessor;
     friend class ServiceState;
     friend class InfoState;
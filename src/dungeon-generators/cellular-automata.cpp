@@ -32,55 +32,191 @@ void CellularAutomata::Generate(const Position& mapSize,
 
   _map = CreateRandomlyFilledMap(mapSize.X, mapSize.Y, initialWallChance);
 
-  //
-  // If we change data in-place we would mix old and
-  // new results, so we should perform check on initial map
-  // and store results in temporary one and copy them after
-  // whole initial map was scanned.
-  //
-  auto tmp = CreateFilledMap(mapSize.X, mapSize.Y, '.');
+  PackMap();
 
   for (int i = 0; i < maxIterations; i++)
   {
-    for (int x = 0; x < mapSize.X; x++)
+    Step(birthThreshold, deathThreshold);
+  }
+
+  UnpackMap();
+
+  ConnectIsolatedAreas();
+  CutProblemCorners();
+  FillMapRaw();
+}
+
+// =============================================================================
+
+void CellularAutomata::PackMap()
+{
+  _wordsPerColumn = (_mapSize.Y + 63) / 64;
+
+  size_t totalWords = _mapSize.X * _wordsPerColumn;
+
+  _cells.assign(totalWords, 0);
+  _next.assign(totalWords, 0);
+  _countMask.assign(totalWords, 0);
+
+  for (int x = 0; x < _mapSize.X; x++)
+  {
+    for (int y = 0; y < _mapSize.Y; y++)
     {
-      for (int y = 0; y < mapSize.Y; y++)
+      size_t index = x * _wordsPerColumn + (y / 64);
+      uint64_t bit = (uint64_t)1 << (y % 64);
+
+      if (_map[x][y].Image == '.')
+      {
+        _cells[index] |= bit;
+      }
+
+      if (IsInsideMap({ x, y }))
       {
-        tmp[x][y].Image = _map[x][y].Image;
+        _countMask[index] |= bit;
       }
     }
+  }
+}
+
+// =============================================================================
+
+void CellularAutomata::UnpackMap()
+{
+  for (int x = 0; x < _mapSize.X; x++)
+  {
+    for (int y = 0; y < _mapSize.Y; y++)
+    {
+      size_t index = x * _wordsPerColumn + (y / 64);
+      uint64_t bit = (uint64_t)1 << (y % 64);
+
+      _map[x][y].Image = (_cells[index] & bit) ? '.' : '#';
+    }
+  }
+}
+
+// =============================================================================
+
+void CellularAutomata::Step(int birthThreshold, int deathThreshold)
+{
+  int wpc = _wordsPerColumn;
+
+  //
+  // Empty cell stays empty if it has at least deathThreshold
+  // empty neighbours, wall becomes empty if it has more than
+  // birthThreshold of them.
+  //
+  bool survives[9];
+  bool born[9];
+
+  for (int n = 0; n <= 8; n++)
+  {
+    survives[n] = (n >= deathThreshold);
+    born[n]     = (n > birthThreshold);
+  }
+
+  //
+  // Word of column x (only countable cells) and its neighbours
+  // along Y shifted so that bit i holds cell at Y - 1 or Y + 1.
+  //
+  auto Get = [this, wpc](int x, int w) -> uint64_t
+  {
+    if (x < 0 || x >= _mapSize.X || w < 0 || w >= wpc)
+    {
+      return 0;
+    }
+
+    size_t index = x * wpc + w;
+    return _cells[index] & _countMask[index];
+  };
+
+  auto Prev = [&Get](int x, int w)
+  {
+    return (Get(x, w) << 1) | (Get(x, w - 1) >> 63);
+  };
+
+  auto Next = [&Get](int x, int w)
+  {
+    return (Get(x, w) >> 1) | (Get(x, w + 1) << 63);
+  };
+
+  //
+  // Adds one bit per cell to the 4-bit counters.
+  //
+  auto Add = [](uint64_t v, uint64_t& c0, uint64_t& c1,
+                            uint64_t& c2, uint64_t& c3)
+  {
+    uint64_t carry = c0 & v;
+    c0 ^= v;
+
+    uint64_t carry2 = c1 & carry;
+    c1 ^= carry;
+
+    uint64_t carry3 = c2 & carry2;
+    c2 ^= carry2;
 
-    for (int x = 0; x < mapSize.X; x++)
+    c3 |= carry3;
+  };
+
+  for (int x = 0; x < _mapSize.X; x++)
+  {
+    for (int w = 0; w < wpc; w++)
     {
-      for (int y = 0; y < mapSize.Y; y++)
+      uint64_t c0 = 0;
+      uint64_t c1 = 0;
+      uint64_t c2 = 0;
+      uint64_t c3 = 0;
+
+      Add(Prev(x - 1, w), c0, c1, c2, c3);
+      Add(Get (x - 1, w), c0, c1, c2, c3);
+      Add(Next(x - 1, w), c0, c1, c2, c3);
+      Add(Prev(x,     w), c0, c1, c2, c3);
+      Add(Next(x,     w), c0, c1, c2, c3);
+      Add(Prev(x + 1, w), c0, c1, c2, c3);
+      Add(Get (x + 1, w), c0, c1, c2, c3);
+      Add(Next(x + 1, w), c0, c1, c2, c3);
+
+      uint64_t survivesMask = 0;
+      uint64_t bornMask     = 0;
+
+      for (int n = 0; n <= 8; n++)
       {
-        if (_map[x][y].Visited)
+        if (!survives[n] && !born[n])
         {
           continue;
         }
 
-        int aliveCells = CountAround(x, y, '.');
-        if (_map[x][y].Image == '.')
+        uint64_t eq = ((n & 1) ? c0 : ~c0)
+                    & ((n & 2) ? c1 : ~c1)
+                    & ((n & 4) ? c2 : ~c2)
+                    & ((n & 8) ? c3 : ~c3);
+
+        if (survives[n])
         {
-          tmp[x][y].Image = (aliveCells < deathThreshold) ? '#' : '.';
+          survivesMask |= eq;
         }
-        else if (_map[x][y].Image == '#')
+
+        if (born[n])
         {
-          tmp[x][y].Image = (aliveCells > birthThreshold) ? '.' : '#';
+          bornMask |= eq;
         }
       }
+
+      size_t index = x * wpc + w;
+
+      uint64_t cur = _cells[index];
+
+      _next[index] = (cur & survivesMask) | (~cur & bornMask);
     }
 
-    for (int x = 0; x < mapSize.X; x++)
+    //
+    // Bits past map height must stay clear.
+    //
+    int tail = _mapSize.Y % 64;
+    if (tail != 0)
     {
-      for (int y = 0; y < mapSize.Y; y++)
-      {
-        _map[x][y].Image = tmp[x][y].Image;
-      }
+      _next[x * wpc + wpc - 1] &= ((uint64_t)1 << tail) - 1;
     }
   }
 
-  ConnectIsolatedAreas();
-  CutProblemCorners();
-  FillMapRaw();
+  _cells.swap(_next);
 }
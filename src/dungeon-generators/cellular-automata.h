@@ -3,6 +3,8 @@
 
 #include <queue>
 #include <map>
+#include <vector>
+#include <cstdint>
 
 #include "dg-base.h"
 
@@ -14,6 +16,30 @@ class CellularAutomata : public DGBase
                   int birthThreshold,
                   int deathThreshold,
                   int maxIterations);
+
+  protected:
+    void PackMap();
+    void UnpackMap();
+
+    void Step(int birthThreshold, int deathThreshold);
+
+  private:
+    //
+    // Map is processed as a bit grid: one bit per cell, set if cell is empty.
+    // Every column (fixed X) takes _wordsPerColumn 64-bit words,
+    // bit i of word w is the cell at Y = w * 64 + i.
+    // This way neighbours of 64 cells are counted at once
+    // with a handful of bitwise operations.
+    //
+    std::vector<uint64_t> _cells;
+    std::vector<uint64_t> _next;
+
+    //
+    // Cells that are counted as neighbours (see DGBase::CountAround()).
+    //
+    std::vector<uint64_t> _countMask;
+
+    int _wordsPerColumn = 0;
 };
 
 #endif // CELLULARAUTOMATA_H
@@ -2,13 +2,11 @@
 
 #include "util.h"
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
-DGBase::DGBase()
+void DGBase::SetSeed(uint64_t seed)
 {
-  _rng.seed(RNG::Instance().Seed);
+  _rng.seed(seed);
 }
 
 // =============================================================================
@@ -178,7 +176,7 @@ std::vector<std::vector<MapCell>> DGBase::CreateRandomlyFilledMap(int w,
 
     for (int y = 0; y < h; y++)
     {
-      bool isWall = Util::Rolld100(chance);
+      bool isWall = Util::Rolld100(chance, _rng);
 
       MapCell c;
       c.Coordinates.X = x;
@@ -950,7 +948,7 @@ void DGBase::TransformRooms(const TransformedRoomsWeights& weights)
       continue;
     }
 
-    auto res = Util::WeightedRandom(roomWeightByType);
+    auto res = Util::WeightedRandom(roomWeightByType, _rng);
 
     int maxAllowed = weights.at(res.first).second;
     if (maxAllowed > 0 && generatedSoFar[res.first] >= maxAllowed)
@@ -1238,7 +1236,7 @@ void DGBase::PlaceTreasury(const Rect& area)
       _map[x][y].Image = (counter % 2 == 0) ? '1' : '2';
       _map[x][y].ZoneMarker = TransformedRoom::TREASURY;
 
-      if (Util::Rolld100(40))
+      if (Util::Rolld100(40, _rng))
       {
         _map[x][y].ObjectHere = ItemType::COINS;
       }
@@ -1310,7 +1308,7 @@ void DGBase::PlaceStorage(const Rect& area)
     {
       _map[x][y].ZoneMarker = TransformedRoom::STORAGE;
 
-      if (Util::Rolld100(20))
+      if (Util::Rolld100(20, _rng))
       {
         _map[x][y].ObjectHere = GameObjectType::BREAKABLE;
       }
@@ -1642,211 +1640,263 @@ double DGBase::GetEmptyOverWallsRatio()
 
 // =============================================================================
 
-Position* DGBase::FindNonMarkedCell()
+int DGBase::MarkRegions()
 {
-  _nonMarkedCell = { -1, -1 };
+  int marker = 0;
+
+  std::vector<Position> toProcess;
+
+  //
+  // Cells are marked when they're added to process list,
+  // so every cell is visited exactly once.
+  //
+  auto TryAdd = [this, &toProcess, &marker](int x, int y)
+  {
+    if (!IsInsideMap({ x, y }))
+    {
+      return;
+    }
+
+    MapCell& cell = _map[x][y];
+    if (cell.Image == '.' && cell.AreaMarker == -1)
+    {
+      cell.AreaMarker = marker;
+      toProcess.push_back({ x, y });
+    }
+  };
 
   for (int x = 1; x < _mapSize.X - 1; x++)
   {
     for (int y = 1; y < _mapSize.Y - 1; y++)
     {
-      if (_map[x][y].AreaMarker == -1
-       && _map[x][y].Image == '.')
+      if (_map[x][y].Image != '.' || _map[x][y].AreaMarker != -1)
+      {
+        continue;
+      }
+
+      TryAdd(x, y);
+
+      while (!toProcess.empty())
       {
-        _nonMarkedCell = { x, y };
-        return &_nonMarkedCell;
+        Position p = toProcess.back();
+        toProcess.pop_back();
+
+        TryAdd(p.X,     p.Y - 1);
+        TryAdd(p.X,     p.Y + 1);
+        TryAdd(p.X - 1, p.Y    );
+        TryAdd(p.X + 1, p.Y    );
       }
+
+      marker++;
     }
   }
 
-  return nullptr;
+  return marker;
 }
 
 // =============================================================================
 
-void DGBase::AddCellToProcess(const Position& from,
-                              Direction dir,
-                              std::stack<Position>& addTo)
+void DGBase::ConnectIsolatedAreas()
 {
-  const std::unordered_map<Direction, Position> newPosByLookDir =
-  {
-    { Direction::WEST,  { from.X,     from.Y - 1 } },
-    { Direction::EAST,  { from.X,     from.Y + 1 } },
-    { Direction::NORTH, { from.X - 1, from.Y     } },
-    { Direction::SOUTH, { from.X + 1, from.Y     } }
-  };
+  int regionsFound = MarkRegions();
 
-  Position newPos = newPosByLookDir.at(dir);
-  if (!IsInsideMap(newPos))
-  {
-    return;
-  }
+  //DebugLog("\n\nRegions found: %i\n\n", regionsFound);
 
-  if (_map[newPos.X][newPos.Y].Image  == '.'
-   && _map[newPos.X][newPos.Y].AreaMarker == -1)
+  //
+  // If no isolated regions found.
+  //
+  if (regionsFound <= 1)
   {
-    addTo.push(newPos);
+    return;
   }
-}
 
-// =============================================================================
+  //
+  // Grow all regions at once through the walls (breadth first),
+  // remembering which region reached each cell first and from where.
+  // Wherever two different regions meet there is a shortest tunnel
+  // between them, so we only need to pick the cheapest set of such
+  // tunnels that connects everything (Kruskal's algorithm).
+  //
+  int sizeX = _mapSize.X;
+  int sizeY = _mapSize.Y;
 
-int DGBase::MarkRegions()
-{
-  int marker = 0;
+  auto ToIndex = [sizeY](int x, int y)
+  {
+    return x * sizeY + y;
+  };
 
-  _areaPointsByMarker.clear();
+  std::vector<int> owner(sizeX * sizeY, -1);
+  std::vector<int> dist(sizeX * sizeY, 0);
+  std::vector<int> cameFrom(sizeX * sizeY, -1);
 
-  std::stack<Position> toProcess;
+  std::vector<Position> queue;
+  queue.reserve(sizeX * sizeY);
 
-  while (true)
+  for (int x = 1; x < sizeX - 1; x++)
   {
-    Position* p = FindNonMarkedCell();
-    if (p == nullptr)
+    for (int y = 1; y < sizeY - 1; y++)
     {
-      break;
+      if (_map[x][y].AreaMarker != -1)
+      {
+        owner[ToIndex(x, y)] = _map[x][y].AreaMarker;
+        queue.push_back({ x, y });
+      }
     }
+  }
 
-    toProcess.push(*p);
+  struct Tunnel
+  {
+    int Length = 0;
+    int From   = -1;
+    int To     = -1;
 
-    while (!toProcess.empty())
-    {
-      Position p = toProcess.top();
-      toProcess.pop();
+    //
+    // How many tunnels of the same length were seen
+    // between these regions, to choose among them randomly.
+    //
+    int Variants = 0;
+  };
 
-      _map[p.X][p.Y].AreaMarker = marker;
+  //
+  // Best tunnel for each pair of regions (lower marker goes first).
+  //
+  std::map<std::pair<int, int>, Tunnel> tunnels;
 
-      bool alreadyExists = false;
-      for (auto& point : _areaPointsByMarker[marker])
-      {
-        if (point == p)
-        {
-          alreadyExists = true;
-          break;
-        }
-      }
+  auto TryTunnel = [&](int from, int to)
+  {
+    int r1 = owner[from];
+    int r2 = owner[to];
 
-      if (!alreadyExists)
+    std::pair<int, int> key = { std::min(r1, r2), std::max(r1, r2) };
+
+    Tunnel& t = tunnels[key];
+
+    int length = dist[from] + dist[to];
+
+    if (t.Variants == 0 || length < t.Length)
+    {
+      t = { length, from, to, 1 };
+    }
+    else if (length == t.Length)
+    {
+      t.Variants++;
+
+      if (Util::RandomRange(0, t.Variants, _rng) == 0)
       {
-        _areaPointsByMarker[marker].push_back(p);
+        t.From = from;
+        t.To   = to;
       }
-
-      AddCellToProcess(p, Direction::WEST,  toProcess);
-      AddCellToProcess(p, Direction::EAST,  toProcess);
-      AddCellToProcess(p, Direction::NORTH, toProcess);
-      AddCellToProcess(p, Direction::SOUTH, toProcess);
     }
+  };
 
-    marker++;
-  }
+  const std::vector<Position> offsets =
+  {
+    {  0, -1 }, { 0, 1 }, { -1, 0 }, { 1, 0 }
+  };
 
-  return marker;
-}
+  for (size_t i = 0; i < queue.size(); i++)
+  {
+    Position p = queue[i];
 
-// =============================================================================
+    int from = ToIndex(p.X, p.Y);
 
-void DGBase::ConnectPoints(const Position& p1, const Position& p2)
-{
-  int dirX = (p1.X > p2.X) ? -1 : 1;
-  int dirY = (p1.Y > p2.Y) ? -1 : 1;
+    for (auto& o : offsets)
+    {
+      Position np = { p.X + o.X, p.Y + o.Y };
+      if (!IsInsideMap(np))
+      {
+        continue;
+      }
 
-  Position tmp1 = p1;
-  Position tmp2 = p2;
+      int to = ToIndex(np.X, np.Y);
 
-  while (tmp1.X != tmp2.X)
-  {
-    _map[tmp1.X][tmp1.Y].Image = '.';
-    tmp1.X += dirX;
-  }
+      if (owner[to] == -1)
+      {
+        owner[to]    = owner[from];
+        dist[to]     = dist[from] + 1;
+        cameFrom[to] = from;
 
-  while (tmp1.Y != tmp2.Y)
-  {
-    _map[tmp1.X][tmp1.Y].Image = '.';
-    tmp1.Y += dirY;
+        queue.push_back(np);
+      }
+      else if (owner[to] != owner[from])
+      {
+        TryTunnel(from, to);
+      }
+    }
   }
-}
 
-// =============================================================================
-
-void DGBase::ConnectIsolatedAreas()
-{
-  const int minDistance = 3;
+  std::vector<Tunnel> candidates;
+  candidates.reserve(tunnels.size());
 
-  int regionsFound = MarkRegions();
+  for (auto& kvp : tunnels)
+  {
+    candidates.push_back(kvp.second);
+  }
 
-  //DebugLog("\n\nRegions found: %i\n\n", regionsFound);
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const Tunnel& lhs, const Tunnel& rhs)
+                   {
+                     return lhs.Length < rhs.Length;
+                   });
 
-  //
-  // If no isolated regions found.
-  //
-  if (regionsFound <= 1)
+  std::vector<int> parent(regionsFound);
+  for (int i = 0; i < regionsFound; i++)
   {
-    return;
+    parent[i] = i;
   }
 
-  while (regionsFound > 1)
+  std::function<int(int)> FindRoot = [&parent, &FindRoot](int r)
   {
-    std::pair<Position, Position> connectionPointCandidate;
-
-    std::vector<std::pair<Position, Position>> connectionPoints;
+    if (parent[r] != r)
+    {
+      parent[r] = FindRoot(parent[r]);
+    }
 
-    int minD = std::numeric_limits<int>::max();
+    return parent[r];
+  };
 
-    //
-    // Areas are marked left to right, top to bottom.
-    //
-    // Find all possible connection points of two adjacent regions.
-    //
-    for (auto& p1 : _areaPointsByMarker[0])
+  auto Dig = [this, &cameFrom, sizeY](int index)
+  {
+    while (index != -1)
     {
-      for (auto& p2 : _areaPointsByMarker[1])
-      {
-        int bd = Util::BlockDistance(p1, p2);
-        if (bd < minD)
-        {
-          connectionPointCandidate = { p1, p2 };
-          minD = bd;
-        }
-
-        if (minD <= minDistance)
-        {
-          minD = std::numeric_limits<int>::max();
-          connectionPoints.push_back(connectionPointCandidate);
-        }
-      }
+      _map[index / sizeY][index % sizeY].Image = '.';
+      index = cameFrom[index];
     }
+  };
 
-    //
-    // If walls are too thick and nothing could be found
-    // that suits the constraint, get by with at least something.
-    //
-    if (connectionPoints.empty())
+  int regionsLeft = regionsFound;
+
+  for (auto& t : candidates)
+  {
+    int r1 = FindRoot(owner[t.From]);
+    int r2 = FindRoot(owner[t.To]);
+
+    if (r1 == r2)
     {
-      connectionPoints.push_back(connectionPointCandidate);
+      continue;
     }
 
-    //
-    // Get random connection point from all possible variants.
-    //
-    int index = Util::RandomRange(0, connectionPoints.size(), _rng);
-    auto pointsToConnect = connectionPoints[index];
-    ConnectPoints(pointsToConnect.first, pointsToConnect.second);
+    parent[r2] = r1;
 
-    //DebugLog("\t\t\tconnecting [%i;%i] -> [%i;%i]\n",
-    //         pointsToConnect.first.X,
-    //         pointsToConnect.first.Y,
-    //         pointsToConnect.second.X,
-    //         pointsToConnect.second.Y);
+    Dig(t.From);
+    Dig(t.To);
 
-    //
-    // Rinse and repeat.
-    //
-    UnmarkRegions();
-
-    regionsFound = MarkRegions();
+    //DebugLog("\t\t\tconnecting regions %i -> %i, length %i\n",
+    //         owner[t.From], owner[t.To], t.Length);
 
-    //DebugLog("\n\n\tNew regions found: %i\n\n", regionsFound);
+    regionsLeft--;
+    if (regionsLeft == 1)
+    {
+      break;
+    }
   }
+
+  //
+  // Leave markers in the same state as before:
+  // everything is one region now.
+  //
+  UnmarkRegions();
+  MarkRegions();
 }
 
 // =============================================================================
@@ -85,9 +85,13 @@ struct RemovalParams
 class DGBase
 {
   public:
-    DGBase();
     virtual ~DGBase() = default;
 
+    //
+    // Must be called before generating anything (see LevelBuilder).
+    //
+    void SetSeed(uint64_t seed);
+
     void PrintMapRaw();
     void LogPrintMapRaw();
 
@@ -183,6 +187,9 @@ class DGBase
     //
     // Will use its own RNG as well to decouple dungeon generation from
     // any code changes.
+    // Seeded per level, so that levels made by the same generator
+    // with the same parameters are still different
+    // (see MapLevelBase::GetLayoutSeed()).
     //
     std::mt19937_64 _rng;
 
@@ -190,18 +197,14 @@ class DGBase
     // Algorithm specific data and methods, no need to expose these
     //
   private:
-    void AddCellToProcess(const Position& from,
-                          Direction dir,
-                          std::stack<Position>& addTo);
-
+    //
+    // Sets AreaMarker of every floor cell inside the map
+    // to the index of its region, returns number of regions found.
+    //
     int MarkRegions();
 
     void UnmarkRegions();
 
-    Position* FindNonMarkedCell();
-
-    void ConnectPoints(const Position& p1, const Position& p2);
-
     bool TransformArea(TransformedRoom type, size_t emptyRoomIndex);
     bool DoesAreaFit(const Rect& area, int minSize, int maxSize);
     bool DoesAreaFitExactly(const Rect& area, const PairII& size);
@@ -234,7 +237,6 @@ class DGBase
     void CheckBlockedPassages(const Rect& area, const StringV& layout,
                               int offsetX, int offsetY);
 
-    Position _nonMarkedCell;
     Position _cornerPos;
 
     //
@@ -258,11 +260,6 @@ class DGBase
     TryToFindSuitableRooms(const std::vector<PairII>& exactSizes,
                            size_t skipRoomIndex);
 
-    //
-    // Must be sorted.
-    //
-    std::map<int, std::vector<Position>> _areaPointsByMarker;
-
     //
     // Rooms that cannot be placed for this map due to no suitable room found
     // and thus shouldn't be checked again if rolled.
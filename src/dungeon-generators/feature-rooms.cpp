@@ -65,7 +65,7 @@ void FeatureRooms::Generate(const Position& mapSize,
     newRoomStartPos.X = doorPos.X + carveOffsets.X;
     newRoomStartPos.Y = doorPos.Y + carveOffsets.Y;
 
-    auto res = Util::WeightedRandom(_roomWeightByType);
+    auto res = Util::WeightedRandom(_roomWeightByType, _rng);
 
     FeatureRoomType typeRolled = res.first;
     std::pair<int, int> weightAndMax = _weightsMap[res.first];
@@ -180,10 +180,6 @@ namespace Strings
   const std::string NoActionText           = "Nothing happens";
   const std::string UnidentifiedEffectText = "?not sure?";
 
-  const std::string BlackboardKeyPlayerPos    = "pl_pos";
-  const std::string BlackboardKeyLastMinedPos = "last_mined_pos";
-  const std::string BlackboardKeyObjectId     = "object_id";
-
   const std::string MessageBoxInformationHeaderText = "Information";
   const std::string MessageBoxEpicFailHeaderText    = "Epic Fail!";
 
@@ -370,6 +366,8 @@ namespace GlobalConstants
   const int MinHitChance                = 1;
   const int MaxHitChance                = 99;
   const int DisplayAttackDelayMs        = 50;
+  const int ProjectileStepDelayMs       = 10;
+  const int KnockBackStepDelayMs        = 30;
   const int InventoryMaxSize            = 20;
   const int MaxNameLength               = 21;
   const int MaxSeedStringLength         = 65;
@@ -210,10 +210,6 @@ namespace Strings
   extern const std::string UnidentifiedEffectText;
   extern const std::string TripleQuestionMarks;
   // ---------------------------------------------------------------------------
-  extern const std::string BlackboardKeyPlayerPos;
-  extern const std::string BlackboardKeyLastMinedPos;
-  extern const std::string BlackboardKeyObjectId;
-  // ---------------------------------------------------------------------------
   extern const char InventoryEmptySlotChar;
   // ---------------------------------------------------------------------------
   extern const std::string ItemDefaultDescAccessory;
@@ -357,6 +353,8 @@ namespace GlobalConstants
   extern const int MinHitChance;
   extern const int MaxHitChance;
   extern const int DisplayAttackDelayMs;
+  extern const int ProjectileStepDelayMs;
+  extern const int KnockBackStepDelayMs;
   extern const int InventoryMaxSize;
   extern const int TurnReadyValue;
   extern const int TurnTickValue;
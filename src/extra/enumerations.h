@@ -37,6 +37,38 @@ enum class TransformedRoom
   , ZOO
 };
 
+//
+// Index of component slot in GameObject.
+// Every Component subclass must have its own value here
+// (see Component::TypeId).
+//
+enum class ComponentType
+{
+    AI = 0
+  , CONTAINER
+  , DOOR
+  , EQUIPMENT
+  , ITEM
+  , SHRINE
+  , STAIRS
+  , TIMED_DESTROYER
+  , TOWN_PORTAL
+  , TRADER
+  , TRIGGER
+  , LAST_ELEMENT
+};
+
+//
+// Typed slots in Blackboard.
+//
+enum class BlackboardKey
+{
+    PLAYER_POS = 0
+  , LAST_MINED_POS
+  , OBJECT_ID
+  , LAST_ELEMENT
+};
+
 enum class CornerType
 {
     UL = 0
@@ -65,6 +97,17 @@ enum class TriggerUpdateType
   , FINISH_TURN
 };
 
+enum class TriggerEventType
+{
+    MAP_UPDATE = 0    // every Map::Update() cycle
+  , TURN_FINISHED     // any actor (player included) finished turn
+  , PLAYER_MOVED
+  , CELL_ENTERED      // any actor stepped on subscribed cell
+  , ITEM_PICKED_UP
+  , TURN_REACHED      // Application::PlayerTurnsPassed reached subscribed value
+  , LAST_ELEMENT
+};
+
 enum class TriggerType
 {
     ONE_SHOT = 0
@@ -408,6 +451,7 @@ enum class ItemBonusType
   , ILLUMINATED     // monsters can see you further away (?) (not implemented)
   , POISONED        // anti-regen
   , WEAKNESS        // penalties to STR, DEF, SKL and SPD
+  , LAST_ELEMENT
 };
 
 enum class FoodType
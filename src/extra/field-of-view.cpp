@@ -0,0 +1,310 @@
+#include "field-of-view.h"
+
+#include "map.h"
+#include "game-object.h"
+
+void FieldOfView::Init(GameObject* owner)
+{
+  _owner = owner;
+  _level = nullptr;
+
+  _previousLevel = nullptr;
+
+  _visibility.clear();
+  _visibleCells.clear();
+  _previousCells.clear();
+
+  _isComputed = false;
+}
+
+// =============================================================================
+
+void FieldOfView::Compute(int radius, int rangeX, int rangeY)
+{
+  auto curLvl = Map::Instance().CurrentLevel;
+
+  if (_owner == nullptr || curLvl == nullptr)
+  {
+    return;
+  }
+
+  //
+  // Only cells that were visible need to be cleared.
+  //
+  for (auto& p : _visibleCells)
+  {
+    _visibility[p.X * _mapSize.Y + p.Y] = false;
+  }
+
+  _previousLevel = _level;
+
+  _previousCells.swap(_visibleCells);
+  _visibleCells.clear();
+
+  if (_level != curLvl || _mapSize != curLvl->MapSize)
+  {
+    _level   = curLvl;
+    _mapSize = curLvl->MapSize;
+
+    _visibility.assign(_mapSize.X * _mapSize.Y, false);
+  }
+
+  _origin        = _owner->GetPosition();
+  _radius        = std::max(radius, 0);
+  _rangeX        = rangeX;
+  _rangeY        = rangeY;
+  _layoutVersion = curLvl->LayoutVersion;
+  _isComputed    = true;
+
+  if (!IsInsideMap(_origin.X, _origin.Y))
+  {
+    return;
+  }
+
+  MarkVisible(_origin.X, _origin.Y);
+
+  //
+  // North, south, east, west.
+  //
+  ScanQuadrant(0, std::min(_radius, _rangeY));
+  ScanQuadrant(1, std::min(_radius, _rangeY));
+  ScanQuadrant(2, std::min(_radius, _rangeX));
+  ScanQuadrant(3, std::min(_radius, _rangeX));
+}
+
+// =============================================================================
+
+void FieldOfView::ScanQuadrant(int quadrant, int maxDepth)
+{
+  _rowsToScan.clear();
+  _rowsToScan.push_back(Row());
+
+  while (!_rowsToScan.empty())
+  {
+    Row row = _rowsToScan.back();
+    _rowsToScan.pop_back();
+
+    if (row.Depth > maxDepth)
+    {
+      continue;
+    }
+
+    //
+    // Round ties up for start and down for end.
+    //
+    int minCol = FloorDiv(2 * row.Depth * row.StartNum + row.StartDen,
+                          2 * row.StartDen);
+    int maxCol = CeilDiv(2 * row.Depth * row.EndNum - row.EndDen,
+                         2 * row.EndDen);
+
+    //
+    // -1 - no previous tile, 0 - floor, 1 - wall.
+    //
+    int prevTile = -1;
+
+    for (int col = minCol; col <= maxCol; col++)
+    {
+      Position p = Transform(quadrant, row.Depth, col);
+
+      bool isWall = IsBlocking(p.X, p.Y);
+
+      bool isSymmetric = (col * row.StartDen >= row.Depth * row.StartNum
+                       && col * row.EndDen   <= row.Depth * row.EndNum);
+
+      if (isWall || isSymmetric)
+      {
+        MarkVisible(p.X, p.Y);
+      }
+
+      //
+      // Slope of the left edge of the tile.
+      //
+      int slopeNum = 2 * col - 1;
+      int slopeDen = 2 * row.Depth;
+
+      if (prevTile == 1 && !isWall)
+      {
+        row.StartNum = slopeNum;
+        row.StartDen = slopeDen;
+      }
+
+      if (prevTile == 0 && isWall)
+      {
+        Row next = row;
+
+        next.Depth++;
+        next.EndNum = slopeNum;
+        next.EndDen = slopeDen;
+
+        _rowsToScan.push_back(next);
+      }
+
+      prevTile = isWall ? 1 : 0;
+    }
+
+    if (prevTile == 0)
+    {
+      Row next = row;
+      next.Depth++;
+
+      _rowsToScan.push_back(next);
+    }
+  }
+}
+
+// =============================================================================
+
+Position FieldOfView::Transform(int quadrant, int depth, int col)
+{
+  switch (quadrant)
+  {
+    case 0:
+      return { _origin.X + col, _origin.Y - depth };
+
+    case 1:
+      return { _origin.X + col, _origin.Y + depth };
+
+    case 2:
+      return { _origin.X + depth, _origin.Y + col };
+
+    default:
+      return { _origin.X - depth, _origin.Y + col };
+  }
+}
+
+// =============================================================================
+
+void FieldOfView::MarkVisible(int x, int y)
+{
+  if (!IsInRange(x, y))
+  {
+    return;
+  }
+
+  int index = x * _mapSize.Y + y;
+
+  if (!_visibility[index])
+  {
+    _visibility[index] = true;
+    _visibleCells.push_back({ x, y });
+  }
+}
+
+// =============================================================================
+
+bool FieldOfView::IsBlocking(int x, int y)
+{
+  if (!IsInsideMap(x, y))
+  {
+    return true;
+  }
+
+  //
+  // Object can be blocking but not blocking the sight (e.g. lava, chasm)
+  // so check against BlocksSight only is needed.
+  //
+  if (_level->Tiles.IsBlockingSight(x, y))
+  {
+    return true;
+  }
+
+  auto& so = _level->StaticMapObjects[x][y];
+
+  return (so != nullptr && so->BlocksSight);
+}
+
+// =============================================================================
+
+bool FieldOfView::IsInsideMap(int x, int y)
+{
+  return (x >= 0 && y >= 0 && x < _mapSize.X && y < _mapSize.Y);
+}
+
+// =============================================================================
+
+bool FieldOfView::IsInRange(int x, int y)
+{
+  if (!_isComputed || !IsInsideMap(x, y))
+  {
+    return false;
+  }
+
+  int dx = x - _origin.X;
+  int dy = y - _origin.Y;
+
+  return (std::abs(dx) <= _rangeX
+       && std::abs(dy) <= _rangeY
+       && (dx * dx + dy * dy) <= (_radius * _radius));
+}
+
+// =============================================================================
+
+bool FieldOfView::IsVisible(int x, int y)
+{
+  if (!IsInsideMap(x, y) || _visibility.empty())
+  {
+    return false;
+  }
+
+  return _visibility[x * _mapSize.Y + y];
+}
+
+// =============================================================================
+
+bool FieldOfView::IsDirty(int radius)
+{
+  if (!_isComputed || _owner == nullptr)
+  {
+    return true;
+  }
+
+  auto curLvl = Map::Instance().CurrentLevel;
+
+  return (_level != curLvl
+       || (curLvl != nullptr && curLvl->LayoutVersion != _layoutVersion)
+       || _owner->PosX != _origin.X
+       || _owner->PosY != _origin.Y
+       || std::max(radius, 0) != _radius);
+}
+
+// =============================================================================
+
+const std::vector<Position>& FieldOfView::GetVisibleCells()
+{
+  return _visibleCells;
+}
+
+// =============================================================================
+
+const std::vector<Position>& FieldOfView::GetPreviouslyVisibleCells()
+{
+  return _previousCells;
+}
+
+// =============================================================================
+
+MapLevelBase* FieldOfView::GetPreviousLevel()
+{
+  return _previousLevel;
+}
+
+// =============================================================================
+
+int FieldOfView::FloorDiv(int a, int b)
+{
+  int q = a / b;
+
+  if ((a % b != 0) && ((a < 0) != (b < 0)))
+  {
+    q--;
+  }
+
+  return q;
+}
+
+// =============================================================================
+
+int FieldOfView::CeilDiv(int a, int b)
+{
+  return -FloorDiv(-a, b);
+}
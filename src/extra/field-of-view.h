@@ -0,0 +1,106 @@
+#ifndef FIELDOFVIEW_H
+#define FIELDOFVIEW_H
+
+#include <vector>
+#include <cstdint>
+
+#include "position.h"
+
+class GameObject;
+class MapLevelBase;
+
+//
+// Symmetric recursive shadowcasting (well, iterative in our case).
+//
+// Every cell in range is visited once and visibility result
+// is stored in a bit grid sized to the current level,
+// so "is cell visible from owner" becomes a simple lookup.
+//
+// https://www.albertford.com/shadowcasting/
+//
+class FieldOfView
+{
+  public:
+    void Init(GameObject* owner);
+
+    //
+    // Recalculates visibility around owner in a circle of given radius,
+    // additionally limited by rectangle (usually a screen) of
+    // (2 * rangeX + 1) x (2 * rangeY + 1).
+    //
+    void Compute(int radius, int rangeX, int rangeY);
+
+    //
+    // True if owner has moved, level layout changed
+    // or owner's visibility radius is no longer the same
+    // (e.g. because of light or blindness) since last Compute().
+    //
+    bool IsDirty(int radius);
+
+    //
+    // Whether cell was inside calculated area during last Compute().
+    // Visibility of cells outside of it is unknown.
+    //
+    bool IsInRange(int x, int y);
+
+    bool IsVisible(int x, int y);
+
+    const std::vector<Position>& GetVisibleCells();
+
+    //
+    // Cells that were visible before last Compute().
+    // They belong to GetPreviousLevel(), which is not necessarily
+    // the current one (e.g. if player went down the stairs).
+    //
+    const std::vector<Position>& GetPreviouslyVisibleCells();
+
+    MapLevelBase* GetPreviousLevel();
+
+  private:
+    struct Row
+    {
+      int Depth = 1;
+
+      //
+      // Slopes are stored as fractions to avoid floating point.
+      // Denominators are always positive.
+      //
+      int StartNum = -1;
+      int StartDen = 1;
+      int EndNum   = 1;
+      int EndDen   = 1;
+    };
+
+    std::vector<bool>     _visibility;
+    std::vector<Position> _visibleCells;
+    std::vector<Position> _previousCells;
+    std::vector<Row>      _rowsToScan;
+
+    Position _origin;
+    Position _mapSize;
+
+    int _radius = 0;
+    int _rangeX = 0;
+    int _rangeY = 0;
+
+    uint32_t _layoutVersion = 0;
+
+    bool _isComputed = false;
+
+    GameObject*   _owner         = nullptr;
+    MapLevelBase* _level         = nullptr;
+    MapLevelBase* _previousLevel = nullptr;
+
+    void ScanQuadrant(int quadrant, int maxDepth);
+    void MarkVisible(int x, int y);
+
+    bool IsBlocking(int x, int y);
+    bool IsInsideMap(int x, int y);
+
+    int FloorDiv(int a, int b);
+    int CeilDiv(int a, int b);
+
+    Position Transform(int quadrant, int depth, int col);
+};
+
+#endif // FIELDOFVIEW_H
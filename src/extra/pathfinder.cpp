@@ -2,24 +2,6 @@
 
 #include "map-level-base.h"
 
-PathNode::PathNode(const Position &coord)
-{
-  Coordinate.X = coord.X;
-  Coordinate.Y = coord.Y;
-}
-
-// =============================================================================
-
-PathNode::PathNode(const Position &coord, const Position &parentNodePos)
-{
-  Coordinate.X = coord.X;
-  Coordinate.Y = coord.Y;
-
-  ParentNodePosition = parentNodePos;
-}
-
-// =============================================================================
-
 std::vector<Position> Pathfinder::BuildRoad(const CharV2& map,
                                             const Position& mapSize,
                                             const Position& start,
@@ -27,52 +9,36 @@ std::vector<Position> Pathfinder::BuildRoad(const CharV2& map,
                                             const std::vector<char>& obstacles,
                                             bool eightDirs)
 {
-  _mapSize = mapSize;
-
-  _start = start;
-  _end = end;
-
   _pathVector.clear();
 
-  _openList.clear();
-  _closedList.clear();
-
-  PathNode node(start);
-  node.CostH = Util::BlockDistance(start, end);
-  node.CostF = node.CostG + node.CostH;
+  PrepareGrid(mapSize);
 
-  _openList.push_back(node);
-
-  while (!_openList.empty())
+  auto IsWalkable = [&map, &obstacles](const Position& p)
   {
-    int index = FindCheapestElement(_openList);
-
-    _closedList.push_back(_openList[index]);
-
-    if (_openList[index].Coordinate == end)
+    for (auto& o : obstacles)
     {
-      PathNode n = FindNodeWithPosition(_closedList, end);
-      while (n.ParentNodePosition.X != -1 && n.ParentNodePosition.Y != -1)
+      if (map[p.X][p.Y] == o)
       {
-        _pathVector.push_back(n.Coordinate);
-        n = FindNodeWithPosition(_closedList, n.ParentNodePosition);
+        return false;
       }
+    }
 
-      _pathVector.push_back(start);
-
-      std::reverse(_pathVector.begin(), _pathVector.end());
+    return true;
+  };
 
-      break;
+  int found = Search(start, end, eightDirs, 0, IsWalkable);
+  if (found != -1)
+  {
+    int index = found;
+    while (_nodes[index].Parent != -1)
+    {
+      _pathVector.push_back(ToPosition(index));
+      index = _nodes[index].Parent;
     }
 
-    LookAround(map,
-               _openList[index],
-               _openList,
-               _closedList,
-               obstacles,
-               eightDirs);
+    _pathVector.push_back(start);
 
-    _openList.erase(_openList.begin() + index);
+    std::reverse(_pathVector.begin(), _pathVector.end());
   }
 
   return _pathVector;
@@ -89,54 +55,56 @@ Pathfinder::BuildRoad(MapLevelBase* mapRef,
                       bool eightDirs,
                       size_t maxPathLength)
 {
-  _mapSize = mapRef->MapSize;
-
-  _start = start;
-  _end = end;
-
   _pathStack = std::stack<Position>();
 
-  _openList.clear();
-  _closedList.clear();
-
-  PathNode node(start);
-  node.CostH = Util::BlockDistance(start, end);
-  node.CostF = node.CostG + node.CostH;
-
-  _openList.push_back(node);
+  PrepareGrid(mapRef->MapSize);
 
-  while (!_openList.empty())
+  if (!ignoreActors)
   {
-    if (maxPathLength != 0 && _closedList.size() > maxPathLength)
+    //
+    // Mark cells with actors beforehand
+    // instead of checking every actor for every neighbour.
+    //
+    for (auto& o : mapRef->ActorGameObjects)
     {
-      break;
+      Position p = o->GetPosition();
+      if (IsInsideGrid(p))
+      {
+        _nodes[ToIndex(p)].ActorId = _searchId;
+      }
     }
+  }
 
-    int index = FindCheapestElement(_openList);
+  auto IsWalkable = [this, mapRef, &mapTilesToIgnore](const Position& p)
+  {
+    auto& staticObj = mapRef->StaticMapObjects[p.X][p.Y];
+    if (staticObj != nullptr && staticObj->Blocking)
+    {
+      return false;
+    }
 
-    _closedList.push_back(_openList[index]);
+    int image = mapRef->Tiles.GetImage(p.X, p.Y);
 
-    if (_openList[index].Coordinate == end)
+    for (auto& o : mapTilesToIgnore)
     {
-      PathNode n = FindNodeWithPosition(_closedList, end);
-      while (n.ParentNodePosition.X != -1 && n.ParentNodePosition.Y != -1)
+      if (image == o)
       {
-        _pathStack.push(n.Coordinate);
-        n = FindNodeWithPosition(_closedList, n.ParentNodePosition);
+        return false;
       }
-
-      break;
     }
 
-    LookAround(mapRef,
-               _openList[index],
-               _openList,
-               _closedList,
-               mapTilesToIgnore,
-               ignoreActors,
-               eightDirs);
+    return (_nodes[ToIndex(p)].ActorId != _searchId);
+  };
 
-    _openList.erase(_openList.begin() + index);
+  int found = Search(start, end, eightDirs, maxPathLength, IsWalkable);
+  if (found != -1)
+  {
+    int index = found;
+    while (_nodes[index].Parent != -1)
+    {
+      _pathStack.push(ToPosition(index));
+      index = _nodes[index].Parent;
+    }
   }
 
   return _pathStack;
@@ -144,183 +112,223 @@ Pathfinder::BuildRoad(MapLevelBase* mapRef,
 
 // =============================================================================
 
-void Pathfinder::LookAround(const CharV2& map,
-                            const PathNode& currentNode,
-                            std::vector<PathNode>& openList,
-                            std::vector<PathNode>& closedList,
-                            const std::vector<char>& mapTilesToIgnore,
-                            bool eightDirs)
+void Pathfinder::PrepareGrid(const Position& mapSize)
 {
-  auto& directions = eightDirs ? _eightDirs : _fourDirs;
+  size_t gridSize = mapSize.X * mapSize.Y;
+
+  if (_mapSize != mapSize || _nodes.size() != gridSize)
+  {
+    _mapSize = mapSize;
+
+    _nodes.assign(gridSize, Node());
+    _searchId = 0;
+  }
 
-  std::vector<PathNode> nodesAround;
+  _searchId++;
 
-  for (auto& p : directions)
+  //
+  // Once in a blue moon.
+  //
+  if (_searchId == 0)
   {
-    Position coordinate;
+    _nodes.assign(gridSize, Node());
+    _searchId = 1;
+  }
+
+  _openHeap.clear();
+}
 
-    coordinate.X = currentNode.Coordinate.X + p.X;
-    coordinate.Y = currentNode.Coordinate.Y + p.Y;
+// =============================================================================
 
-    bool walkable = true;
-    for (auto& o : mapTilesToIgnore)
-    {
-      if (map[coordinate.X][coordinate.Y] == o)
-      {
-        walkable = false;
-        break;
-      }
-    }
+template <typename IsWalkable>
+int Pathfinder::Search(const Position& start,
+                       const Position& end,
+                       bool eightDirs,
+                       size_t maxPathLength,
+                       const IsWalkable& isWalkable)
+{
+  if (!IsInsideGrid(start) || !IsInsideGrid(end))
+  {
+    return -1;
+  }
 
-    if (!IsInsideMap(coordinate) || !walkable)
+  _start = start;
+  _end   = end;
+
+  int endIndex = ToIndex(end);
+
+  int startIndex = ToIndex(start);
+
+  Node& startNode = _nodes[startIndex];
+
+  startNode.SearchId = _searchId;
+  startNode.CostG    = 0;
+  startNode.CostF    = Heuristic(start);
+  startNode.Parent   = -1;
+  startNode.Closed   = false;
+
+  HeapPush(startIndex);
+
+  auto& directions = eightDirs ? _eightDirs : _fourDirs;
+
+  size_t closedNodes = 0;
+
+  while (!_openHeap.empty())
+  {
+    if (maxPathLength != 0 && closedNodes > maxPathLength)
     {
-      continue;
+      break;
     }
 
-    PathNode newNode(coordinate, currentNode.Coordinate);
-    nodesAround.push_back(newNode);
-  }
+    int currentIndex = HeapPop();
 
-  for (auto& nodeAround : nodesAround)
-  {
-    if (IsNodePresent(nodeAround, closedList))
+    Node& current = _nodes[currentIndex];
+
+    current.Closed = true;
+    closedNodes++;
+
+    if (currentIndex == endIndex)
     {
-      continue;
+      return currentIndex;
     }
 
-    if (IsNodePresent(nodeAround, openList))
+    Position currentPos = ToPosition(currentIndex);
+
+    for (auto& d : directions)
     {
-      int newG = nodeAround.CostG + TraverseCost(nodeAround.Coordinate,
-                                                 currentNode.Coordinate);
-      if (newG < nodeAround.CostG)
+      Position p = { currentPos.X + d.X, currentPos.Y + d.Y };
+
+      if (!IsInsideMap(p) || !isWalkable(p))
       {
-        nodeAround.CostG = newG;
-        nodeAround.CostH = Util::BlockDistance(nodeAround.Coordinate, _end);
-        nodeAround.CostF = nodeAround.CostG + nodeAround.CostH;
-        nodeAround.ParentNodePosition = currentNode.Coordinate;
+        continue;
       }
-    }
-    else
-    {
-      nodeAround.CostG = currentNode.CostG +
-                         TraverseCost(currentNode.Coordinate,
-                                      nodeAround.Coordinate);
-      nodeAround.CostH = Util::BlockDistance(nodeAround.Coordinate, _end);
-      nodeAround.CostF = nodeAround.CostG + nodeAround.CostH;
 
-      openList.push_back(nodeAround);
+      int index = ToIndex(p);
+
+      Node& n = _nodes[index];
+
+      int newG = current.CostG + TraverseCost(currentPos, p);
+
+      if (n.SearchId != _searchId)
+      {
+        n.SearchId = _searchId;
+        n.CostG    = newG;
+        n.CostF    = newG + Heuristic(p);
+        n.Parent   = currentIndex;
+        n.Closed   = false;
+
+        HeapPush(index);
+      }
+      else if (!n.Closed && newG < n.CostG)
+      {
+        n.CostG  = newG;
+        n.CostF  = newG + Heuristic(p);
+        n.Parent = currentIndex;
+
+        HeapSiftUp(n.HeapIndex);
+      }
     }
   }
+
+  return -1;
 }
 
 // =============================================================================
 
-void Pathfinder::LookAround(MapLevelBase* mapRef,
-                            const PathNode& currentNode,
-                            std::vector<PathNode>& openList,
-                            std::vector<PathNode>& closedList,
-                            const std::vector<char>& mapTilesToIgnore,
-                            bool ignoreActors,
-                            bool eightDirs)
+void Pathfinder::HeapPush(int index)
 {
-  auto& directions = eightDirs ? _eightDirs : _fourDirs;
+  _openHeap.push_back(index);
+  _nodes[index].HeapIndex = _openHeap.size() - 1;
 
-  std::vector<PathNode> nodesAround;
+  HeapSiftUp(_openHeap.size() - 1);
+}
 
-  for (auto& p : directions)
-  {
-    Position coordinate;
+// =============================================================================
 
-    coordinate.X = currentNode.Coordinate.X + p.X;
-    coordinate.Y = currentNode.Coordinate.Y + p.Y;
+int Pathfinder::HeapPop()
+{
+  int res = _openHeap.front();
 
-    bool walkable = true;
+  _nodes[res].HeapIndex = -1;
 
-    auto& staticObj = mapRef->StaticMapObjects[coordinate.X][coordinate.Y];
-    if (staticObj != nullptr && staticObj->Blocking)
-    {
-      walkable = false;
-    }
+  int last = _openHeap.back();
+  _openHeap.pop_back();
 
-    for (auto& o : mapTilesToIgnore)
-    {
-      if (mapRef->MapArray[coordinate.X][coordinate.Y]->Image == o)
-      {
-        walkable = false;
-        break;
-      }
-    }
+  if (!_openHeap.empty())
+  {
+    _openHeap[0] = last;
+    _nodes[last].HeapIndex = 0;
 
-    if (!ignoreActors)
-    {
-      for (auto& o : mapRef->ActorGameObjects)
-      {
-        if (o->PosX == coordinate.X && o->PosY == coordinate.Y)
-        {
-          walkable = false;
-          break;
-        }
-      }
-    }
+    HeapSiftDown(0);
+  }
 
-    if (!IsInsideMap(coordinate) || !walkable)
-    {
-      continue;
-    }
+  return res;
+}
 
-    PathNode newNode(coordinate, currentNode.Coordinate);
-    nodesAround.push_back(newNode);
-  }
+// =============================================================================
+
+void Pathfinder::HeapSiftUp(int heapPos)
+{
+  int index = _openHeap[heapPos];
+  int cost  = _nodes[index].CostF;
 
-  for (auto& nodeAround : nodesAround)
+  while (heapPos > 0)
   {
-    if (IsNodePresent(nodeAround, closedList))
-    {
-      continue;
-    }
+    int parentPos = (heapPos - 1) / 2;
+    int parentIndex = _openHeap[parentPos];
 
-    if (IsNodePresent(nodeAround, openList))
+    if (_nodes[parentIndex].CostF <= cost)
     {
-      int newG = nodeAround.CostG + TraverseCost(nodeAround.Coordinate,
-                                                 currentNode.Coordinate);
-      if (newG < nodeAround.CostG)
-      {
-        nodeAround.CostG = newG;
-        nodeAround.CostH = Util::BlockDistance(nodeAround.Coordinate, _end);
-        nodeAround.CostF = nodeAround.CostG + nodeAround.CostH;
-        nodeAround.ParentNodePosition = currentNode.Coordinate;
-      }
+      break;
     }
-    else
-    {
-      nodeAround.CostG = currentNode.CostG +
-                         TraverseCost(currentNode.Coordinate,
-                                      nodeAround.Coordinate);
-      nodeAround.CostH = Util::BlockDistance(nodeAround.Coordinate, _end);
-      nodeAround.CostF = nodeAround.CostG + nodeAround.CostH;
 
-      openList.push_back(nodeAround);
-    }
+    _openHeap[heapPos] = parentIndex;
+    _nodes[parentIndex].HeapIndex = heapPos;
+
+    heapPos = parentPos;
   }
+
+  _openHeap[heapPos] = index;
+  _nodes[index].HeapIndex = heapPos;
 }
 
 // =============================================================================
 
-int Pathfinder::FindCheapestElement(const std::vector<PathNode>& list)
+void Pathfinder::HeapSiftDown(int heapPos)
 {
-  int f = INT_MAX;
-  int index = -1;
+  int size  = _openHeap.size();
+  int index = _openHeap[heapPos];
+  int cost  = _nodes[index].CostF;
 
-  for (size_t i = 0; i < list.size(); i++)
+  while (true)
   {
-    if (list[i].CostF < f)
+    int childPos = 2 * heapPos + 1;
+    if (childPos >= size)
+    {
+      break;
+    }
+
+    int rightPos = childPos + 1;
+    if (rightPos < size
+     && _nodes[_openHeap[rightPos]].CostF < _nodes[_openHeap[childPos]].CostF)
+    {
+      childPos = rightPos;
+    }
+
+    int childIndex = _openHeap[childPos];
+    if (_nodes[childIndex].CostF >= cost)
     {
-      f = list[i].CostF;
-      index = i;
+      break;
     }
+
+    _openHeap[heapPos] = childIndex;
+    _nodes[childIndex].HeapIndex = heapPos;
+
+    heapPos = childPos;
   }
 
-  return index;
+  _openHeap[heapPos] = index;
+  _nodes[index].HeapIndex = heapPos;
 }
 
 // =============================================================================
@@ -337,19 +345,27 @@ int Pathfinder::TraverseCost(const Position& p1, const Position& p2)
 
 // =============================================================================
 
-bool Pathfinder::IsNodePresent(const PathNode& n,
-                               const std::vector<PathNode>& list)
+int Pathfinder::Heuristic(const Position& p)
 {
-  for (auto& item : list)
-  {
-    if (n.Coordinate.X == item.Coordinate.X
-     && n.Coordinate.Y == item.Coordinate.Y)
-    {
-      return true;
-    }
-  }
+  //
+  // Since diagonal move costs the same as two orthogonal ones,
+  // block distance scaled by orthogonal cost never overestimates.
+  //
+  return Util::BlockDistance(p, _end) * _hvCost;
+}
+
+// =============================================================================
 
-  return false;
+int Pathfinder::ToIndex(const Position& p)
+{
+  return p.X * _mapSize.Y + p.Y;
+}
+
+// =============================================================================
+
+Position Pathfinder::ToPosition(int index)
+{
+  return { index / _mapSize.Y, index % _mapSize.Y };
 }
 
 // =============================================================================
@@ -366,19 +382,12 @@ bool Pathfinder::IsInsideMap(const Position& c)
 
 // =============================================================================
 
-PathNode Pathfinder::FindNodeWithPosition(const std::vector<PathNode>& list,
-                                          const Position& p)
+bool Pathfinder::IsInsideGrid(const Position& c)
 {
-  PathNode res;
+  bool cond = (c.X >= 0
+            && c.Y >= 0
+            && c.X < _mapSize.X
+            && c.Y < _mapSize.Y);
 
-  for (auto& i : list)
-  {
-    if (i.Coordinate.X == p.X && i.Coordinate.Y == p.Y)
-    {
-      res = i;
-      break;
-    }
-  }
-
-  return res;
+  return cond;
 }
@@ -7,43 +7,13 @@
 
 class MapLevelBase;
 
-struct PathNode
-{
-  PathNode() = default;
-  PathNode(const Position& coord);
-  PathNode(const Position& coord, const Position& parentNodePos);
-
-  //
-  // Map coordinate of this node.
-  //
-  Position Coordinate;
-
-  //
-  // Can't use PathNode* here, beacuse it's not C# and .NET
-  // and we can't just assign "reference to previous node"
-  // and assume it will stay there no matter the containers.
-  //
-  Position ParentNodePosition = { -1, -1 };
-
-  //
-  // Total cost.
-  //
-  int CostF = 0;
-
-  //
-  // Cost of traversal here from the starting point
-  // with regard to already traversed path.
-  //
-  int CostG = 0;
-
-  //
-  // Heuristic cost.
-  //
-  int CostH = 0;
-};
-
-// =============================================================================
-
+//
+// A* over dense per-map node grid with binary heap as open list.
+//
+// Grid is sized to map dimensions and is reused between calls,
+// so it's better to keep one instance around (see MapLevelBase)
+// instead of creating it every time path is needed.
+//
 class Pathfinder
 {
   public:
@@ -63,6 +33,43 @@ class Pathfinder
                                    size_t maxPathLength = 0);
 
   private:
+    struct Node
+    {
+      //
+      // Cost of traversal here from the starting point
+      // with regard to already traversed path.
+      //
+      int CostG = 0;
+
+      //
+      // CostG + heuristic cost.
+      //
+      int CostF = 0;
+
+      //
+      // Linear index of previous node in path, -1 for starting node.
+      //
+      int Parent = -1;
+
+      //
+      // Position of this node inside _openHeap or -1 if it's not there.
+      //
+      int HeapIndex = -1;
+
+      //
+      // Node data is valid only if it equals to current _searchId,
+      // this way we don't have to clear the whole grid on every call.
+      //
+      uint32_t SearchId = 0;
+
+      //
+      // Cell is occupied by an actor if this equals to current _searchId.
+      //
+      uint32_t ActorId = 0;
+
+      bool Closed = false;
+    };
+
     Position _mapSize;
 
     Position _start;
@@ -71,32 +78,34 @@ class Pathfinder
     int _hvCost = 10;
     int _diagonalCost = 20;
 
-    int FindCheapestElement(const std::vector<PathNode>& list);
-    int TraverseCost(const Position& p1, const Position& p2);
+    uint32_t _searchId = 0;
 
-    void LookAround(const CharV2& map,
-                    const PathNode& node,
-                    std::vector<PathNode>& openList,
-                    std::vector<PathNode>& closedList,
-                    const std::vector<char>& mapTilesToIgnore,
-                    bool eightDirs);
-
-    void LookAround(MapLevelBase* mapRef,
-                    const PathNode& node,
-                    std::vector<PathNode>& openList,
-                    std::vector<PathNode>& closedList,
-                    const std::vector<char>& mapTilesToIgnore,
-                    bool ignoreActors,
-                    bool eightDirs);
-
-    bool IsNodePresent(const PathNode& n, const std::vector<PathNode>& list);
-    bool IsInsideMap(const Position& c);
+    std::vector<Node> _nodes;
+    std::vector<int>  _openHeap;
+
+    void PrepareGrid(const Position& mapSize);
+
+    template <typename IsWalkable>
+    int Search(const Position& start,
+               const Position& end,
+               bool eightDirs,
+               size_t maxPathLength,
+               const IsWalkable& isWalkable);
+
+    void HeapPush(int index);
+    void HeapSiftUp(int heapPos);
+    void HeapSiftDown(int heapPos);
 
-    PathNode FindNodeWithPosition(const std::vector<PathNode>& list,
-                                  const Position& p);
+    int HeapPop();
 
-    std::vector<PathNode> _openList;
-    std::vector<PathNode> _closedList;
+    int TraverseCost(const Position& p1, const Position& p2);
+    int Heuristic(const Position& p);
+    int ToIndex(const Position& p);
+
+    Position ToPosition(int index);
+
+    bool IsInsideMap(const Position& c);
+    bool IsInsideGrid(const Position& c);
 
     std::vector<Position> _pathVector;
     std::stack<Position>  _pathStack;
@@ -6,7 +6,7 @@
 
 #include <sstream>
 
-void PotentialField::Init(GameObject* owner, int fieldRadius)
+void PotentialField::Init(GameObject* owner, bool levitating)
 {
   if (owner == nullptr)
   {
@@ -14,40 +14,32 @@ void PotentialField::Init(GameObject* owner, int fieldRadius)
     return;
   }
 
-  if (fieldRadius <= 0)
-  {
-    DebugLog("!!! Wrong field radius = %i !!!", fieldRadius);
-    return;
-  }
+  _owner      = owner;
+  _levitating = levitating;
 
   _field.clear();
 
-  _owner = owner;
-  _fieldRadius = fieldRadius;
+  _level   = nullptr;
+  _mapSize = { 0, 0 };
 
-  _fieldOrigin = _owner->GetPosition();
-
-  int size = _fieldRadius * 2;
+  _isDirty = true;
+}
 
-  _field.reserve(size + 1);
+// =============================================================================
 
-  for (int x = 0; x <= size; x++)
-  {
-    std::vector<Cell> row;
+void PotentialField::Resize(MapLevelBase* level)
+{
+  _level   = level;
+  _mapSize = level->MapSize;
 
-    row.reserve(size + 1);
+  _field.resize(_mapSize.X * _mapSize.Y);
 
-    for (int y = 0; y <= size; y++)
+  for (int x = 0; x < _mapSize.X; x++)
+  {
+    for (int y = 0; y < _mapSize.Y; y++)
     {
-      Cell c;
-
-      c.MapPos = FieldToMapCoords({ x, y });
-      c.FieldPos = { x, y };
-
-      row.push_back(c);
+      _field[x * _mapSize.Y + y].MapPos = { x, y };
     }
-
-    _field.push_back(row);
   }
 }
 
@@ -55,186 +47,188 @@ void PotentialField::Init(GameObject* owner, int fieldRadius)
 
 void PotentialField::Emanate()
 {
-  std::queue<Position> cellsToVisit;
+  auto curLvl = Map::Instance().CurrentLevel;
 
-  _fieldOrigin = _owner->GetPosition();
-
-  cellsToVisit.push(_fieldOrigin);
-
-  int size = _fieldRadius * 2;
-  for (int x = 0; x <= size; x++)
+  if (_owner == nullptr || curLvl == nullptr)
   {
-    for (int y = 0; y <= size; y++)
-    {
-      _field[x][y].Cost = kBlockedCellCost;
-      _field[x][y].Visited = false;
-    }
+    return;
   }
 
-  //
-  // Center is on the actor.
-  //
-  _field[_fieldRadius][_fieldRadius].Cost = 0;
-
-  while (!cellsToVisit.empty())
+  if (_level != curLvl || _mapSize != curLvl->MapSize)
   {
-    Position p = cellsToVisit.front();
+    Resize(curLvl);
+  }
 
-    LookAround(p, cellsToVisit);
+  _fieldOrigin   = _owner->GetPosition();
+  _layoutVersion = curLvl->LayoutVersion;
 
-    cellsToVisit.pop();
+  for (auto& c : _field)
+  {
+    c.Cost = kBlockedCellCost;
   }
 
   _isDirty = false;
-}
 
-// =============================================================================
+  if (IsOutOfBounds(_fieldOrigin.X, _fieldOrigin.Y))
+  {
+    return;
+  }
 
-void PotentialField::LookAround(const Position& mapPos,
-                                std::queue<Position>& cellsToVisit)
-{
-  auto& curLvl = Map::Instance().CurrentLevel;
+  //
+  // Center is on the actor.
+  //
+  int originIndex = _fieldOrigin.X * _mapSize.Y + _fieldOrigin.Y;
 
-  Position fieldPos = MapToFieldCoords(mapPos);
+  _field[originIndex].Cost = 0;
+
+  _cellsToVisit.clear();
+  _cellsToVisit.push_back(originIndex);
 
   //
-  // Check bounds on point.
+  // Plain vector is used as a queue, so that memory is reused between calls.
   //
-  if (IsOutOfBounds(fieldPos))
+  for (size_t i = 0; i < _cellsToVisit.size(); i++)
   {
-    return;
-  }
+    const Cell& parent = _field[_cellsToVisit[i]];
 
-  Cell& parent = _field[fieldPos.X][fieldPos.Y];
-  if (parent.Cost == kBlockedCellCost)
-  {
-    return;
-  }
+    for (auto& d : _neighbours)
+    {
+      int x = parent.MapPos.X + d.X;
+      int y = parent.MapPos.Y + d.Y;
 
-  const std::vector<Position> pointsToCheck =
-  {
-    { fieldPos.X,     fieldPos.Y - 1 },
-    { fieldPos.X,     fieldPos.Y + 1 },
-    { fieldPos.X - 1, fieldPos.Y     },
-    { fieldPos.X + 1, fieldPos.Y     }
-  };
+      if (IsOutOfBounds(x, y))
+      {
+        continue;
+      }
 
-  bool isFlying = _owner->HasEffect(ItemBonusType::LEVITATION);
+      int index = x * _mapSize.Y + y;
 
-  auto IsCellBlocked = [this, isFlying, curLvl](const Position& pos)
-  {
-    if (!Util::IsInsideMap(pos, curLvl->MapSize))
-    {
-      return true;
-    }
+      Cell& c = _field[index];
 
-    bool groundBlock = (curLvl->MapArray[pos.X][pos.Y]->Blocking && !isFlying);
+      //
+      // Cell was either already visited or is blocked.
+      //
+      if (c.Cost != kBlockedCellCost || IsCellBlocked(curLvl, x, y))
+      {
+        continue;
+      }
 
-    bool staticBlock = false;
-    if (curLvl->StaticMapObjects[pos.X][pos.Y] != nullptr)
-    {
-      staticBlock = curLvl->StaticMapObjects[pos.X][pos.Y]->Blocking;
+      c.Cost = parent.Cost + 1;
+
+      _cellsToVisit.push_back(index);
     }
+  }
+}
 
-    return (groundBlock || staticBlock);
-  };
+// =============================================================================
 
-  for (auto& p : pointsToCheck)
+bool PotentialField::IsCellBlocked(MapLevelBase* level, int x, int y)
+{
+  auto& so = level->StaticMapObjects[x][y];
+  if (so != nullptr && so->Blocking)
   {
-    if (!IsOutOfBounds(p) && !_field[p.X][p.Y].Visited)
-    {
-      Position mapPos = FieldToMapCoords(p);
-
-      bool cellBlocked = IsCellBlocked(mapPos);
-
-      Cell& c = _field[p.X][p.Y];
+    return true;
+  }
 
-      c.FieldPos = p;
-      c.MapPos = mapPos;
-      c.Cost = cellBlocked ? kBlockedCellCost : (parent.Cost + 1);
-      c.Visited = true;
+  //
+  // Ground doesn't matter if you're levitating over it.
+  //
+  if (_levitating)
+  {
+    return false;
+  }
 
-      cellsToVisit.push(mapPos);
-    }
+  if (level->Tiles.IsBlocking(x, y))
+  {
+    return true;
   }
 
-  parent.Visited = true;
+  //
+  // See GameObject::CanMoveTo()
+  //
+  auto tileType = level->Tiles.GetType(x, y);
+
+  return (tileType == GameObjectType::DEEP_WATER
+       || tileType == GameObjectType::CHASM
+       || tileType == GameObjectType::LAVA);
 }
 
 // =============================================================================
 
 PotentialField::Cell* PotentialField::GetCell(int mapX, int mapY)
 {
-  Position p = MapToFieldCoords({ mapX, mapY });
-  if (IsOutOfBounds(p))
+  if (IsOutOfBounds(mapX, mapY))
   {
     return nullptr;
   }
 
-  return &_field[p.X][p.Y];
+  return &_field[mapX * _mapSize.Y + mapY];
 }
 
 // =============================================================================
 
-bool PotentialField::IsOutOfBounds(const Position& fieldPos)
+PotentialField::Cell* PotentialField::GetCellCloserToOwner(GameObject* actor)
 {
-  const int size = _fieldRadius * 2;
+  Cell* res = nullptr;
 
-  if (fieldPos.X < 0 || fieldPos.X > size
-   || fieldPos.Y < 0 || fieldPos.Y > size)
+  Cell* current = GetCell(actor->PosX, actor->PosY);
+  if (current == nullptr)
   {
-    return true;
+    return res;
   }
 
-  return false;
-}
+  int minCost = current->Cost;
 
-// =============================================================================
-
-void PotentialField::SetDirty()
-{
-  //
-  // Probably makes no sense in terms of optimization, but still...
-  //
-  if (!_isDirty)
+  for (auto& d : _neighbours)
   {
-    _isDirty = true;
+    Cell* c = GetCell(actor->PosX + d.X, actor->PosY + d.Y);
+    if (c == nullptr || c->Cost >= minCost)
+    {
+      continue;
+    }
+
+    if (actor->CanMoveTo(c->MapPos))
+    {
+      minCost = c->Cost;
+      res = c;
+    }
   }
+
+  return res;
 }
 
 // =============================================================================
 
-bool PotentialField::IsDirty()
+bool PotentialField::IsOutOfBounds(int x, int y)
 {
-  return _isDirty;
+  return (x < 0 || y < 0 || x >= _mapSize.X || y >= _mapSize.Y);
 }
 
 // =============================================================================
 
-Position PotentialField::MapToFieldCoords(const Position& mapPos)
+void PotentialField::SetDirty()
 {
-  int dx = mapPos.X - _fieldOrigin.X;
-  int dy = mapPos.Y - _fieldOrigin.Y;
-
-  int ix = dx + _fieldRadius;
-  int iy = dy + _fieldRadius;
-
-  //
-  // Because (2;1) in world coordinates is (1;2) in array coordinates.
-  //
-  return { iy, ix };
+  _isDirty = true;
 }
 
 // =============================================================================
 
-Position PotentialField::FieldToMapCoords(const Position& fieldIndices)
+bool PotentialField::IsDirty()
 {
-  Position res;
+  if (_isDirty || _owner == nullptr)
+  {
+    return true;
+  }
 
-  res.X = _owner->PosX + (fieldIndices.Y - _fieldRadius);
-  res.Y = _owner->PosY + (fieldIndices.X - _fieldRadius);
+  auto curLvl = Map::Instance().CurrentLevel;
 
-  return res;
+  bool levelChanged  = (_level != curLvl);
+  bool layoutChanged = (curLvl != nullptr
+                     && curLvl->LayoutVersion != _layoutVersion);
+  bool ownerMoved    = (_owner->PosX != _fieldOrigin.X
+                     || _owner->PosY != _fieldOrigin.Y);
+
+  return (levelChanged || layoutChanged || ownerMoved);
 }
 
 // =============================================================================
@@ -243,15 +237,20 @@ std::string PotentialField::GetFieldString()
 {
   std::stringstream ss;
 
-  int size = _fieldRadius * 2;
-
-  for (int x = 0; x <= size; x++)
+  for (int y = 0; y < _mapSize.Y; y++)
   {
-    for (int y = 0; y <= size; y++)
+    for (int x = 0; x < _mapSize.X; x++)
     {
-      Cell& c = _field[x][y];
-      ss << "(" << c.MapPos.X << ";" << c.MapPos.Y << ")"
-         << " [" << c.Cost << "] ";
+      int cost = _field[x * _mapSize.Y + y].Cost;
+
+      if (cost == kBlockedCellCost)
+      {
+        ss << "  #";
+      }
+      else
+      {
+        ss << Util::StringFormat("%3i", cost);
+      }
     }
 
     ss << "\n";
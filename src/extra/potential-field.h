@@ -2,26 +2,36 @@
 #define POTENTIALFIELD_H
 
 #include <vector>
-#include <queue>
 #include <string>
 #include <limits>
 
 #include "position.h"
 
 class GameObject;
-
+class MapLevelBase;
+
+//
+// Level-wide distance map from the owner (i.e. player),
+// computed with breadth-first search over 8 neighbouring cells.
+//
+// Since it's shared between all actors interested in owner's whereabouts,
+// it's rebuilt only when owner moves, level changes
+// or something on the level changes blocking status of a cell
+// (see MapLevelBase::LayoutVersion).
+//
+// Levitating actors can go over tiles walking ones can't,
+// so they need separate field (see Player::LevitatingDistanceField).
+//
 class PotentialField
 {
   public:
     struct Cell
     {
       Position MapPos;
-      Position FieldPos;
-      bool Visited = false;
-      int Cost = 0;
+      int Cost = kBlockedCellCost;
     };
 
-    void Init(GameObject* owner, int fieldRadius);
+    void Init(GameObject* owner, bool levitating = false);
     void Emanate();
     void SetDirty();
 
@@ -31,26 +41,45 @@ class PotentialField
 
     Cell* GetCell(int mapX, int mapY);
 
-    Position FieldToMapCoords(const Position& fieldIndices);
-    Position MapToFieldCoords(const Position& mapPos);
+    //
+    // Returns neighbour cell of actor's position that is closer to the owner
+    // and actor can move into, or nullptr if there is no such cell.
+    //
+    Cell* GetCellCloserToOwner(GameObject* actor);
 
     static const int kBlockedCellCost = std::numeric_limits<int>::max();
 
   private:
-    std::vector<std::vector<Cell>> _field;
-
-    int _fieldRadius = 0;
+    std::vector<Cell> _field;
+    std::vector<int>  _cellsToVisit;
 
-    bool _isDirty = true;
+    bool _isDirty    = true;
+    bool _levitating = false;
 
     Position _fieldOrigin;
+    Position _mapSize;
+
+    uint32_t _layoutVersion = 0;
 
-    GameObject* _owner = nullptr;
+    GameObject*   _owner = nullptr;
+    MapLevelBase* _level = nullptr;
 
-    void LookAround(const Position& mapPos,
-                    std::queue<Position>& cellsToVisit);
+    void Resize(MapLevelBase* level);
 
-    bool IsOutOfBounds(const Position& fieldPos);
+    bool IsCellBlocked(MapLevelBase* level, int x, int y);
+    bool IsOutOfBounds(int x, int y);
+
+    const std::vector<Position> _neighbours =
+    {
+      { -1,  0 },
+      {  0, -1 },
+      {  0,  1 },
+      {  1,  0 },
+      { -1, -1 },
+      { -1,  1 },
+      {  1, -1 },
+      {  1,  1 }
+    };
 };
 
 #endif // POTENTIALFIELD_H
@@ -2,9 +2,7 @@
 
 #include "util.h"
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
 Rect::Rect(const Position &p1, const Position &p2)
 {
@@ -4,10 +4,11 @@
 #include "printer.h"
 #include "timer.h"
 #include "map.h"
+#include "animation-timeline.h"
+
+#include <thread>
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
 namespace Util
 {
@@ -841,18 +842,7 @@ namespace Util
     int hx = from->PosX + range;
     int hy = from->PosY + range;
 
-    for (auto& a : curLvl->ActorGameObjects)
-    {
-      if (a->PosX >= lx &&
-          a->PosY >= ly &&
-          a->PosX <= hx &&
-          a->PosY <= hy)
-      {
-        res.push_back(a.get());
-      }
-    }
-
-    return res;
+    return curLvl->ActorsIndex.GetInRect(lx, ly, hx, hy);
   }
 
   // ===========================================================================
@@ -1361,6 +1351,13 @@ namespace Util
 
   // ===========================================================================
 
+  bool Rolld100(int successChance, std::mt19937_64& rng)
+  {
+    return (RandomRange(0, 100, rng) < successChance);
+  }
+
+  // ===========================================================================
+
   void Sleep(uint32_t delayMs)
   {
     if (delayMs == 0)
@@ -1368,12 +1365,7 @@ namespace Util
       return;
     }
 
-    auto tp1 = Clock::now();
-    auto tp2 = tp1;
-    while (std::chrono::duration_cast<Ms>(tp2 - tp1).count() < (int32_t)delayMs)
-    {
-      tp2 = Clock::now();
-    }
+    std::this_thread::sleep_for(Ms(delayMs));
   }
 
   // ===========================================================================
@@ -1816,27 +1808,22 @@ namespace Util
                         const uint32_t& fgColor,
                         const uint32_t& bgColor)
   {
+    AnimationTrack track;
+
     //
     // Start from 1 to exclude starting position.
     //
     for (size_t i = 1; i < line.size(); i++)
     {
-      int mx = line[i].X;
-      int my = line[i].Y;
+      AnimationFrame frame;
 
-      Application::Instance().ForceDrawCurrentState();
+      frame.DurationMs = GlobalConstants::ProjectileStepDelayMs;
+      frame.Cells.push_back({ line[i], image, fgColor, bgColor });
 
-      int drawingPosX = mx + Map::Instance().CurrentLevel->MapOffsetX;
-      int drawingPosY = my + Map::Instance().CurrentLevel->MapOffsetY;
-
-      Printer::Instance().PrintFB(drawingPosX,
-                                  drawingPosY,
-                                  image,
-                                  fgColor,
-                                  bgColor);
-
-      Printer::Instance().Render();
+      track.push_back(frame);
     }
+
+    AnimationTimeline::Instance().AddTrack(track);
   }
 
   // ===========================================================================
@@ -1859,7 +1846,6 @@ namespace Util
                  const Position& attackDir,
                  int tiles)
   {
-    auto& mapRef = Map::Instance().CurrentLevel->MapArray;
     auto curLvl = Map::Instance().CurrentLevel;
 
     Position newPos = receiver->GetPosition();
@@ -1867,6 +1853,12 @@ namespace Util
     int attackDirClampedX = Clamp(attackDir.X, -1, 1);
     int attackDirClampedY = Clamp(attackDir.Y, -1, 1);
 
+    //
+    // Whatever was queued before (e.g. projectile that caused this)
+    // must be shown before receiver starts moving.
+    //
+    AnimationTimeline::Instance().Play();
+
     for (int i = 1; i <= tiles; i++)
     {
       //
@@ -1883,7 +1875,7 @@ namespace Util
       newPos.X += attackDirClampedX;
       newPos.Y += attackDirClampedY;
 
-      if (mapRef[newPos.X][newPos.Y]->Occupied
+      if (curLvl->Tiles.IsOccupied(newPos.X, newPos.Y)
        || curLvl->IsCellBlocking(newPos))
       {
         break;
@@ -1891,7 +1883,23 @@ namespace Util
 
       receiver->MoveTo(newPos, true);
 
-      Application::Instance().ForceDrawCurrentState();
+      //
+      // Every step changes the state drawn underneath,
+      // so knockback track is played one tile at a time.
+      //
+      if (!Application::Instance().GameConfig.FastCombat)
+      {
+        AnimationFrame step;
+
+        step.DurationMs = GlobalConstants::KnockBackStepDelayMs;
+        step.Cells.push_back({ newPos,
+                               receiver->Image,
+                               receiver->FgColor,
+                               receiver->BgColor });
+
+        AnimationTimeline::Instance().AddTrack({ step });
+        AnimationTimeline::Instance().Play();
+      }
 
       //
       // Ground units should perish on dangerous tiles.
@@ -2931,18 +2939,16 @@ namespace Util
 
   void DrawLaserAttack(const std::vector<Position>& line)
   {
+    AnimationFrame frame;
+
+    frame.DurationMs = 100;
+
     for (auto& p : line)
     {
-      Printer::Instance().PrintFB(p.X,
-                                  p.Y,
-                                  '*',
-                                  Colors::YellowColor,
-                                  Colors::RedColor);
+      frame.Cells.push_back({ p, '*', Colors::YellowColor, Colors::RedColor });
     }
 
-    Printer::Instance().Render();
-    Sleep(100);
-    Application::Instance().ForceDrawMainState();
+    AnimationTimeline::Instance().AddTrack({ frame });
   }
 
   // ===========================================================================
@@ -3006,21 +3012,20 @@ namespace Util
 
         MapLevelBase* curLvl = Map::Instance().CurrentLevel;
 
-        GameObject* cell = curLvl->MapArray[point.X][point.Y].get();
-        GameObject* obj  = curLvl->StaticMapObjects[point.X][point.Y].get();
+        GameObject* obj = curLvl->StaticMapObjects[point.X][point.Y].get();
 
-        bool cellOk = (!cell->Blocking);
+        bool cellOk = (!curLvl->Tiles.IsBlocking(point.X, point.Y));
         bool objOk  = (obj == nullptr);
 
         if (cellOk && objOk && d <= range)
         {
-          res.push_back(cell->GetPosition());
+          res.push_back(point);
         }
         else
         {
           if (obj != nullptr && !obj->Attrs.Indestructible)
           {
-            res.push_back(cell->GetPosition());
+            res.push_back(point);
           }
 
           break;
@@ -3149,17 +3154,17 @@ namespace Util
 
   // ===========================================================================
 
-  std::string GetDestroyedByMapString(GameObject* what, GameObject* tileRef)
+  std::string GetDestroyedByMapString(GameObject* what,
+                                      GameObjectType tileType,
+                                      const std::string& tileName)
   {
     std::string res;
 
-    if (what == nullptr || tileRef == nullptr)
+    if (what == nullptr)
     {
       return res;
     }
 
-    GameObjectType tile = tileRef->Type;
-
     std::string objName;
 
     bool isStackable = false;
@@ -3186,9 +3191,8 @@ namespace Util
     }
 
     std::string verb;
-    std::string tileName = tileRef->ObjectName;
 
-    switch (tile)
+    switch (tileType)
     {
       case GameObjectType::DEEP_WATER:
         verb = (isStackable && amount > 1) ? "drown" : "drowns";
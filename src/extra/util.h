@@ -48,11 +48,11 @@
 
 #define STRINGIFY(ARG) #ARG
 
-#ifdef DEBUG_BUILD
-    #define LogPrint(str, ...) Logger::Instance().Print(str, ##__VA_ARGS__)
-  #else
-    #define LogPrint(str, ...)
-#endif
+//
+// Logger is there in every build, what actually gets written
+// is decided by LOGGER_MIN_LEVEL and config (see logger.h).
+//
+#define LogPrint(str, ...) Logger::Instance().Print(str, ##__VA_ARGS__)
 
 #ifdef USE_SDL
   #define ConsoleLog(format, ...) SDL_Log(format, ##__VA_ARGS__)
@@ -179,6 +179,12 @@ namespace Util
 
   extern bool Rolld100(int successChance, bool twoRN = false);
 
+  //
+  // Same as above but uses provided RNG and doesn't log anything,
+  // so it's safe to use outside of the main thread (e.g. in generators).
+  //
+  extern bool Rolld100(int successChance, std::mt19937_64& rng);
+
   extern int RollDices(int numRolls, int diceSides);
 
   extern int GetExpForNextLevel(int curLvl);
@@ -292,7 +298,8 @@ namespace Util
   extern bool ShouldAwardExp(GameObjectType type);
 
   extern std::string GetDestroyedByMapString(GameObject* what,
-                                             GameObject* tileRef);
+                                             GameObjectType tileType,
+                                             const std::string& tileName);
 
   // ---------------------------------------------------------------------------
 
@@ -356,7 +363,7 @@ namespace Util
   //
   template <typename Map>
   std::pair<typename Map::key_type, typename Map::mapped_type>
-  WeightedRandom(const Map& weightsByType)
+  WeightedRandom(const Map& weightsByType, std::mt19937_64& rng)
   {
     using ResultType = std::pair<typename Map::key_type,
                                  typename Map::mapped_type>;
@@ -369,7 +376,7 @@ namespace Util
       sum += i.second;
     }
 
-    int target = RNG::Instance().RandomRange(1, sum + 1);
+    int target = RandomRange(1, sum + 1, rng);
 
     for (auto& i : weightsByType)
     {
@@ -387,6 +394,15 @@ namespace Util
 
   // ===========================================================================
 
+  template <typename Map>
+  std::pair<typename Map::key_type, typename Map::mapped_type>
+  WeightedRandom(const Map& weightsByType)
+  {
+    return WeightedRandom(weightsByType, RNG::Instance().Random);
+  }
+
+  // ===========================================================================
+
   template <typename T>
   std::unordered_map<T, double>
   WeightsToProbability(const std::unordered_map<T, int>& weightsMap)
@@ -5,9 +5,7 @@
 #include "game-objects-factory.h"
 #include "door-component.h"
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
 MapLevelAbyss::MapLevelAbyss(int sizeX,
                              int sizeY,
@@ -47,6 +45,16 @@ void MapLevelAbyss::PrepareMap()
 
 // =============================================================================
 
+void MapLevelAbyss::GenerateLayout(LevelBuilder& lb)
+{
+  if (MapType_ != MapType::ABYSS_5)
+  {
+    lb.CellularAutomataMethod(MapSize, 40, 5, 4, 12);
+  }
+}
+
+// =============================================================================
+
 void MapLevelAbyss::CreateLevel()
 {
   VisibilityRadius = 40;
@@ -57,16 +65,11 @@ void MapLevelAbyss::CreateLevel()
                0x440000,
                Strings::TileNames::AbyssalFloorText);
 
-  LevelBuilder lb;
-  switch (MapType_)
-  {
-    case MapType::ABYSS_5:
-      CreateSpecialLevel();
-      break;
+  auto lb = TakeLayout();
 
-    default:
-      lb.CellularAutomataMethod(MapSize, 40, 5, 4, 12);
-      break;
+  if (MapType_ == MapType::ABYSS_5)
+  {
+    CreateSpecialLevel();
   }
 
   CreateBorders(' ',
@@ -76,7 +79,7 @@ void MapLevelAbyss::CreateLevel()
 
   if (MapType_ != MapType::ABYSS_5)
   {
-    ConstructFromBuilder(lb);
+    ConstructFromBuilder(*lb.get());
 
     RecordEmptyCells();
     PlaceStairs();
@@ -11,6 +11,8 @@ class MapLevelAbyss : public MapLevelBase
     void PrepareMap() override;
     void DisplayWelcomeText() override;
 
+    void GenerateLayout(LevelBuilder& lb) override;
+
   protected:
     void CreateLevel() override;
 
@@ -12,9 +12,7 @@
 #include "door-component.h"
 #include "map.h"
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
 MapLevelBase::MapLevelBase(int sizeX,
                            int sizeY,
@@ -58,66 +56,56 @@ MapLevelBase::MapLevelBase(int sizeX,
 
 MapLevelBase::~MapLevelBase()
 {
-  GlobalTriggers.clear();
-  FinishTurnTriggers.clear();
+  Triggers.clear();
+  TriggersDispatcher.Clear();
   ActorGameObjects.clear();
   GameObjects.clear();
+  ActorsIndex.Clear();
+  GameObjectsIndex.Clear();
+  GameObjectsUpdateList.Clear();
   StaticMapObjects.clear();
-  MapArray.clear();
+  Tiles.Clear();
 }
 
 // =============================================================================
 
 void MapLevelBase::PrepareMap()
 {
-  MapArray.reserve(MapSize.X);
+  Tiles.Init(this, MapSize);
+
+  ActorsIndex.Init(MapSize);
+  GameObjectsIndex.Init(MapSize);
+  TriggersDispatcher.Init(MapSize);
+
   StaticMapObjects.reserve(MapSize.X);
 
   GameObjects.reserve(100);
   ActorGameObjects.reserve(100);
 
-  FinishTurnTriggers.reserve(100);
-  GlobalTriggers.reserve(100);
+  Triggers.reserve(100);
 
   FowLayer.reserve(MapSize.X);
 
   for (int x = 0; x < MapSize.X; x++)
   {
-    std::vector<std::unique_ptr<GameObject>> row;
     std::vector<std::unique_ptr<GameObject>> rowStatic;
 
     std::vector<FowObj> fowLine;
     fowLine.reserve(MapSize.Y);
 
-    row.reserve(MapSize.Y);
     rowStatic.reserve(MapSize.Y);
 
     for (int y = 0; y < MapSize.Y; y++)
     {
-      row.push_back(std::unique_ptr<GameObject>(new GameObject()));
       rowStatic.push_back(nullptr);
 
       fowLine.push_back(FowObj());
     }
 
-    MapArray.push_back(std::move(row));
     StaticMapObjects.push_back(std::move(rowStatic));
 
     FowLayer.push_back(fowLine);
   }
-
-  for (int x = 0; x < MapSize.X; x++)
-  {
-    for (int y = 0; y < MapSize.Y; y++)
-    {
-      MapArray[x][y]->Init(this,
-                           x,
-                           y,
-                           '?',
-                           Colors::WhiteColor,
-                           Colors::MagentaColor);
-    }
-  }
 }
 
 // =============================================================================
@@ -157,20 +145,24 @@ GameObject* MapLevelBase::FindObjectByAddress(const std::string& addressString)
     return _playerRef;
   }
 
-  res = FindInVV(MapArray, addressString);
+  for (auto& kvp : Tiles.GetTileObjects())
+  {
+    if (kvp.second->HexAddressString == addressString)
+    {
+      return kvp.second.get();
+    }
+  }
+
+  res = FindInVV(StaticMapObjects, addressString);
   if (res == nullptr)
   {
-    res = FindInVV(StaticMapObjects, addressString);
+    res = FindInV(GameObjects, addressString);
     if (res == nullptr)
     {
-      res = FindInV(GameObjects, addressString);
+      res = FindInV(ActorGameObjects, addressString);
       if (res == nullptr)
       {
-        res = FindInV(ActorGameObjects, addressString);
-        if (res == nullptr)
-        {
-          res = FindInV(FinishTurnTriggers, addressString);
-        }
+        res = FindInV(Triggers, addressString);
       }
     }
   }
@@ -196,6 +188,7 @@ void MapLevelBase::PlaceActor(GameObject* actor)
   }
 
   ActorGameObjects.push_back(std::unique_ptr<GameObject>(actor));
+  ActorsIndex.Add(actor);
 
   //
   // NOTE: standing danger check for actors is performed in
@@ -225,7 +218,7 @@ void MapLevelBase::PlaceGameObject(GameObject* goToInsert)
   GameObjects.push_back(std::unique_ptr<GameObject>(goToInsert));
 
   GameObject* what = GameObjects.back().get();
-  GameObjectType t = MapArray[what->PosX][what->PosY]->Type;
+  GameObjectType t = Tiles.GetType(what->PosX, what->PosY);
 
   //
   // Assuming all items can perish this way, contrary to actors.
@@ -236,14 +229,76 @@ void MapLevelBase::PlaceGameObject(GameObject* goToInsert)
 
   if (danger)
   {
-    int x = what->PosX;
-    int y = what->PosY;
-
-    std::string msg = Util::GetDestroyedByMapString(what, MapArray[x][y].get());
+    std::string msg =
+        Util::GetDestroyedByMapString(what,
+                                      t,
+                                      Tiles.GetName(what->PosX, what->PosY));
     Printer::Instance().AddMessage(msg);
 
     GameObjects.pop_back();
   }
+  else
+  {
+    GameObjectsIndex.Add(what);
+    GameObjectsUpdateList.Add(what);
+  }
+}
+
+// =============================================================================
+
+void MapLevelBase::EraseGameObject(int index)
+{
+  GameObjectsIndex.Remove(GameObjects[index].get());
+  GameObjectsUpdateList.Remove(GameObjects[index].get());
+  GameObjects.erase(GameObjects.begin() + index);
+}
+
+// =============================================================================
+
+GameObject* MapLevelBase::ReleaseGameObject(int index)
+{
+  GameObjectsIndex.Remove(GameObjects[index].get());
+  GameObjectsUpdateList.Remove(GameObjects[index].get());
+
+  GameObject* go = GameObjects[index].release();
+  GameObjects.erase(GameObjects.begin() + index);
+
+  return go;
+}
+
+// =============================================================================
+
+void MapLevelBase::EraseGameObject(GameObject* go)
+{
+  int index = FindGameObjectIndex(go);
+  if (index != -1)
+  {
+    EraseGameObject(index);
+  }
+}
+
+// =============================================================================
+
+GameObject* MapLevelBase::ReleaseGameObject(GameObject* go)
+{
+  int index = FindGameObjectIndex(go);
+
+  return (index != -1) ? ReleaseGameObject(index) : nullptr;
+}
+
+// =============================================================================
+
+int MapLevelBase::FindGameObjectIndex(GameObject* go)
+{
+  for (size_t i = 0; i < GameObjects.size(); i++)
+  {
+    if (GameObjects[i].get() == go)
+    {
+      return (int)i;
+    }
+  }
+
+  return -1;
 }
 
 // =============================================================================
@@ -284,12 +339,13 @@ void MapLevelBase::PlaceStaticObject(GameObject* goToInsert)
   int y = goToInsert->PosY;
 
   StaticMapObjects[x][y].reset(goToInsert);
+
+  LayoutVersion++;
 }
 
 // =============================================================================
 
-void MapLevelBase::PlaceTrigger(GameObject* trigger,
-                                TriggerUpdateType updateType)
+bool MapLevelBase::TakeTrigger(GameObject* trigger)
 {
   if (trigger == nullptr)
   {
@@ -299,17 +355,58 @@ void MapLevelBase::PlaceTrigger(GameObject* trigger,
     Logger::Instance().Print(str);
     DebugLog("%s\n", str.data());
     #endif
-    return;
+    return false;
+  }
+
+  Triggers.push_back(std::unique_ptr<GameObject>(trigger));
+
+  return true;
+}
+
+// =============================================================================
+
+void MapLevelBase::PlaceTrigger(GameObject* trigger,
+                                TriggerEventType eventType)
+{
+  if (TakeTrigger(trigger))
+  {
+    TriggersDispatcher.Subscribe(trigger, eventType);
+  }
+}
+
+// =============================================================================
+
+void MapLevelBase::PlaceTrigger(GameObject* trigger, const Position& cell)
+{
+  if (TakeTrigger(trigger))
+  {
+    TriggersDispatcher.SubscribeCell(trigger, cell);
   }
+}
+
+// =============================================================================
+
+void MapLevelBase::PlaceTurnTrigger(GameObject* trigger, uint64_t turn)
+{
+  if (TakeTrigger(trigger))
+  {
+    TriggersDispatcher.SubscribeTurn(trigger, turn);
+  }
+}
+
+// =============================================================================
 
+void MapLevelBase::PlaceTrigger(GameObject* trigger,
+                                TriggerUpdateType updateType)
+{
   switch (updateType)
   {
     case TriggerUpdateType::FINISH_TURN:
-      FinishTurnTriggers.push_back(std::unique_ptr<GameObject>(trigger));
+      PlaceTrigger(trigger, TriggerEventType::TURN_FINISHED);
       break;
 
     case TriggerUpdateType::GLOBAL:
-      GlobalTriggers.push_back(std::unique_ptr<GameObject>(trigger));
+      PlaceTrigger(trigger, TriggerEventType::MAP_UPDATE);
       break;
   }
 }
@@ -325,8 +422,8 @@ void MapLevelBase::RecordEmptyCells()
     for (int y = 0; y < MapSize.Y; y++)
     {
       if (!IsCellBlocking({ x, y })
-       && (MapArray[x][y]->ZoneMarker == TransformedRoom::UNMARKED
-        || MapArray[x][y]->ZoneMarker == TransformedRoom::EMPTY))
+       && (Tiles.GetZoneMarker(x, y) == TransformedRoom::UNMARKED
+        || Tiles.GetZoneMarker(x, y) == TransformedRoom::EMPTY))
       {
         Position pos(x, y);
         _emptyCells.push_back(pos);
@@ -561,15 +658,17 @@ bool MapLevelBase::IsOutOfBounds(int x, int y)
 
 bool MapLevelBase::IsSpotValidForSpawn(const Position& pos)
 {
-  auto& map = Map::Instance().CurrentLevel->MapArray;
+  auto& tiles = Map::Instance().CurrentLevel->Tiles;
+
+  TransformedRoom zone = tiles.GetZoneMarker(pos.X, pos.Y);
 
   bool blocked   = IsCellBlocking(pos);
   bool occupied  = false;
   bool danger    = Map::Instance().IsTileDangerous(pos);
   bool farEnough = false;
-  bool unmarked  = (map[pos.X][pos.Y]->ZoneMarker == TransformedRoom::UNMARKED
-                 || map[pos.X][pos.Y]->ZoneMarker == TransformedRoom::EMPTY);
-  bool special   = map[pos.X][pos.Y]->Special;
+  bool unmarked  = (zone == TransformedRoom::UNMARKED
+                 || zone == TransformedRoom::EMPTY);
+  bool special   = tiles.IsSpecial(pos.X, pos.Y);
 
   int distanceToPlayer = Util::BlockDistance(_playerRef->GetPosition(), pos);
 
@@ -631,39 +730,94 @@ bool MapLevelBase::IsSpotValidForSpawn(const Position& pos)
     return false;
   }
 
-  for (auto& i : ActorGameObjects)
-  {
-    if (i->PosX == pos.X && i->PosY == pos.Y)
-    {
-      occupied = true;
-      break;
-    }
-  }
+  occupied = !ActorsIndex.IsEmpty(pos.X, pos.Y);
 
   return (!blocked && !occupied && !danger && unmarked && !special);
 }
 
 // =============================================================================
 
-void MapLevelBase::TryToSpawnMonsters()
+int MapLevelBase::GetRespawnCounterIncrement()
+{
+  //
+  // To average out monsters' respawning speed,
+  // adjust respawn counter with regards to player's SPD.
+  //
+  return (_playerRef->Attrs.Spd.Get() <= 0)
+         ? 1
+         : (_playerRef->Attrs.Spd.Get() * GlobalConstants::TurnTickValue);
+}
+
+// =============================================================================
+
+bool MapLevelBase::AdvanceRespawnCounter()
 {
   if (_respawnCounter < MonstersRespawnTurns)
   {
-    //
-    // To average out monsters' respawning speed,
-    // adjust respawn counter with regards to player's SPD.
-    //
-    _respawnCounter += (_playerRef->Attrs.Spd.Get() <= 0)
-                       ? 1
-                       : (_playerRef->Attrs.Spd.Get() *
-                          GlobalConstants::TurnTickValue);
-    return;
+    _respawnCounter += GetRespawnCounterIncrement();
+    return false;
   }
 
   _respawnCounter = 0;
 
-  if (_monstersSpawnRateForThisLevel.empty()
-    || (ActorGameObjects.size() >= MaxMonsters))
+  return true;
+}
+
+// =============================================================================
+
+bool MapLevelBase::CanSpawnMonsters()
+{
+  return !(_monstersSpawnRateForThisLevel.empty()
+        || (ActorGameObjects.size() >= MaxMonsters));
+}
+
+// =============================================================================
+
+int MapLevelBase::GetIdleTicks()
+{
+  //
+  // Counter just goes round if there's nothing to spawn,
+  // and actors count doesn't change while ticks are skipped.
+  //
+  if (!CanSpawnMonsters())
+  {
+    return Component::kUnlimitedIdleTicks;
+  }
+
+  int res = 0;
+
+  int counter = _respawnCounter;
+  int inc     = GetRespawnCounterIncrement();
+
+  while (counter < MonstersRespawnTurns)
+  {
+    counter += inc;
+    res++;
+  }
+
+  return res;
+}
+
+// =============================================================================
+
+void MapLevelBase::SkipTicks(int ticks)
+{
+  for (int i = 0; i < ticks; i++)
+  {
+    AdvanceRespawnCounter();
+  }
+}
+
+// =============================================================================
+
+void MapLevelBase::TryToSpawnMonsters()
+{
+  if (!AdvanceRespawnCounter())
+  {
+    return;
+  }
+
+  if (!CanSpawnMonsters())
   {
     return;
   }
@@ -676,7 +830,7 @@ void MapLevelBase::TryToSpawnMonsters()
   //
   // Spawn monsters on cells invisible to the player.
   //
-  if (!MapArray[cx][cy]->Visible
+  if (!Tiles.IsVisible(cx, cy)
    && IsSpotValidForSpawn({ cx, cy }))
   {
     auto res = Util::WeightedRandom(_monstersSpawnRateForThisLevel);
@@ -748,15 +902,8 @@ void MapLevelBase::SerializeLayout(NRS& saveTo)
   using SDM = GameObject::SaveDataMinimal;
   std::unordered_map<std::string, SDM> saveData;
 
-  auto WriteSaveData = [this, &saveData](GameObject* go)
+  auto WriteSaveData = [&saveData](const SDM& d)
   {
-    if (go == nullptr)
-    {
-      return;
-    }
-
-    const SDM& d = go->GetSaveDataMinimal();
-
     std::string key = d.ToStringKey();
 
     if (saveData.count(key) == 0)
@@ -769,13 +916,13 @@ void MapLevelBase::SerializeLayout(NRS& saveTo)
   {
     for (int x = 0; x < MapSize.X; x++)
     {
-      WriteSaveData(MapArray[x][y].get());
+      WriteSaveData(Tiles.GetSaveDataMinimal(x, y));
 
       GameObject* so = StaticMapObjects[x][y].get();
       if (so != nullptr && (so->Type == GameObjectType::PICKAXEABLE
                          || so->Type == GameObjectType::BORDER))
       {
-        WriteSaveData(StaticMapObjects[x][y].get());
+        WriteSaveData(so->GetSaveDataMinimal());
       }
     }
   }
@@ -828,7 +975,7 @@ void MapLevelBase::SerializeLayout(NRS& saveTo)
 
     for (int x = 0; x < MapSize.X; x++)
     {
-      const SDM& sdm = MapArray[x][y]->GetSaveDataMinimal();
+      const SDM& sdm = Tiles.GetSaveDataMinimal(x, y);
 
       const std::string& key = sdm.ToStringKey();
 
@@ -928,7 +1075,7 @@ bool MapLevelBase::IsCellBlocking(const Position& pos)
     return true;
   }
 
-  bool groundBlock = MapArray[pos.X][pos.Y]->Blocking;
+  bool groundBlock = Tiles.IsBlocking(pos.X, pos.Y);
   bool staticBlock = false;
   if (StaticMapObjects[pos.X][pos.Y] != nullptr)
   {
@@ -954,6 +1101,22 @@ void MapLevelBase::UpdateFowLayer(GameObject* obj)
 
 // =============================================================================
 
+void MapLevelBase::UpdateFowLayerFromTile(int x, int y)
+{
+  //
+  // Same as Util::GetFowName() for object without components.
+  //
+  const std::string& fowName = Tiles.GetFowName(x, y);
+
+  FowLayer[x][y].Image   = Tiles.GetImage(x, y);
+  FowLayer[x][y].FowName = fowName.empty()
+                         ? Util::StringFormat("?%s?",
+                                              Tiles.GetName(x, y).data())
+                         : fowName;
+}
+
+// =============================================================================
+
 GameObject* MapLevelBase::GetTopmostObject(const Position& pos)
 {
   if (pos.X < 0 || pos.X >= MapSize.X || pos.Y < 0 || pos.Y >= MapSize.Y)
@@ -964,29 +1127,19 @@ GameObject* MapLevelBase::GetTopmostObject(const Position& pos)
   //
   // There shouldn't be more than 1 actor per tile.
   //
-  for (auto& i : ActorGameObjects)
+  auto& actors = ActorsIndex.Get(pos.X, pos.Y);
+  if (!actors.empty())
   {
-    if (i->PosX == pos.X && i->PosY == pos.Y)
-    {
-      return i.get();
-    }
+    return actors.front();
   }
 
   //
   // To get topmost object, we need to get last item for this tile.
   //
-  std::stack<GameObject*> itemsHere;
-  for (auto& i : GameObjects)
-  {
-    if (i->PosX == pos.X && i->PosY == pos.Y)
-    {
-      itemsHere.push(i.get());
-    }
-  }
-
+  auto& itemsHere = GameObjectsIndex.Get(pos.X, pos.Y);
   if (!itemsHere.empty())
   {
-    return itemsHere.top();
+    return itemsHere.back();
   }
 
   //
@@ -997,10 +1150,7 @@ GameObject* MapLevelBase::GetTopmostObject(const Position& pos)
     return StaticMapObjects[pos.X][pos.Y].get();
   }
 
-  //
-  // Fallback to map tile otherwise.
-  //
-  return MapArray[pos.X][pos.Y].get();
+  return nullptr;
 }
 
 // =============================================================================
@@ -1018,7 +1168,7 @@ void MapLevelBase::PlaceGroundTile(int x, int y,
 
   GameObjectInfo t;
   t.Set(false, false, image, fgColor, bgColor, objName);
-  MapArray[x][y]->MakeTile(t);
+  Tiles.MakeTile(x, y, t);
 }
 
 // =============================================================================
@@ -1065,7 +1215,7 @@ void MapLevelBase::PlaceGrassTile(int x, int y, int maxDiceRoll)
   GameObjectInfo t;
   t.Set(false, false, img, flowerColor, Colors::GrassColor, tileName);
 
-  MapArray[x][y]->MakeTile(t);
+  Tiles.MakeTile(x, y, t);
 }
 
 // =============================================================================
@@ -1084,7 +1234,7 @@ void MapLevelBase::PlaceShallowWaterTile(int x, int y)
         Colors::WhiteColor,
         Colors::ShallowWaterColor,
         Strings::TileNames::ShallowWaterText);
-  MapArray[x][y]->MakeTile(t, GameObjectType::SHALLOW_WATER);
+  Tiles.MakeTile(x, y, t, GameObjectType::SHALLOW_WATER);
 }
 
 // =============================================================================
@@ -1113,7 +1263,7 @@ void MapLevelBase::PlaceDeepWaterTile(int x, int y)
         Colors::WhiteColor,
         Colors::DeepWaterColor,
         Strings::TileNames::DeepWaterText);
-  MapArray[x][y]->MakeTile(t, GameObjectType::DEEP_WATER);
+  Tiles.MakeTile(x, y, t, GameObjectType::DEEP_WATER);
 }
 
 // =============================================================================
@@ -1132,7 +1282,7 @@ void MapLevelBase::PlaceLavaTile(int x, int y)
         Colors::LavaWavesColor,
         Colors::LavaColor,
         Strings::TileNames::LavaText);
-  MapArray[x][y]->MakeTile(t, GameObjectType::LAVA);
+  Tiles.MakeTile(x, y, t, GameObjectType::LAVA);
 }
 
 // =============================================================================
@@ -1163,7 +1313,7 @@ void MapLevelBase::PlaceChasmTile(int x, int y)
         fgColor,
         bgColor,
         Strings::TileNames::ChasmText);
-  MapArray[x][y]->MakeTile(t, GameObjectType::CHASM);
+  Tiles.MakeTile(x, y, t, GameObjectType::CHASM);
 }
 
 // =============================================================================
@@ -1322,19 +1472,29 @@ void MapLevelBase::CreateLevel()
 
 void MapLevelBase::ConstructFromBuilder(LevelBuilder& lb)
 {
+  //
+  // Generator owns the cells, just read them in place.
+  //
+  const auto& map = lb.GeneratedMap();
+
+  //
+  // Builder without generator returns empty stub.
+  //
+  bool hasCells = (map.size() >= (size_t)MapSize.X);
+
   for (int x = 0; x < MapSize.X; x++)
   {
+    const auto& column = lb.MapRaw[x];
+
     for (int y = 0; y < MapSize.Y; y++)
     {
-      auto map = lb.GeneratedMap();
-
       //
       // This ensures that all common objects will share the same
       // visual style that is defined for the current map.
       //
-      CreateCommonObjects(x, y, lb.MapRaw[x][y]);
+      CreateCommonObjects(x, y, column[y]);
 
-      if (map[x][y].ZoneMarker != TransformedRoom::UNMARKED)
+      if (hasCells && map[x][y].ZoneMarker != TransformedRoom::UNMARKED)
       {
         CreateSpecialObjects(x, y, map[x][y]);
       }
@@ -1344,6 +1504,44 @@ void MapLevelBase::ConstructFromBuilder(LevelBuilder& lb)
 
 // =============================================================================
 
+void MapLevelBase::GenerateLayout(LevelBuilder& lb)
+{
+  // For levels that use dungeon generators
+}
+
+// =============================================================================
+
+uint64_t MapLevelBase::GetLayoutSeed()
+{
+  return (uint64_t)RNG::Instance().Seed
+       ^ ((uint64_t)MapType_ * 0x9E3779B97F4A7C15ULL);
+}
+
+// =============================================================================
+
+void MapLevelBase::SetPregeneratedLayout(std::unique_ptr<LevelBuilder> lb)
+{
+  _pregeneratedLayout = std::move(lb);
+}
+
+// =============================================================================
+
+std::unique_ptr<LevelBuilder> MapLevelBase::TakeLayout()
+{
+  if (_pregeneratedLayout)
+  {
+    return std::move(_pregeneratedLayout);
+  }
+
+  auto lb = std::make_unique<LevelBuilder>(GetLayoutSeed());
+
+  GenerateLayout(*lb.get());
+
+  return lb;
+}
+
+// =============================================================================
+
 void MapLevelBase::CreateGround(char img,
                                 uint32_t fgColor,
                                 uint32_t bgColor,
@@ -1367,7 +1565,7 @@ void MapLevelBase::FillArea(int ax,
   {
     for (int y = ay; y <= ay + ah; y++)
     {
-      MapArray[x][y]->MakeTile(tileToFill);
+      Tiles.MakeTile(x, y, tileToFill);
     }
   }
 }
@@ -1388,7 +1586,7 @@ void MapLevelBase::CreateSpecialMonsters()
 
 void MapLevelBase::CreateSpecialObjects(int x, int y, const MapCell& cell)
 {
-  MapArray[x][y]->ZoneMarker = cell.ZoneMarker;
+  Tiles.SetZoneMarker(x, y, cell.ZoneMarker);
 
   switch (cell.ZoneMarker)
   {
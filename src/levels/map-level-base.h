@@ -6,6 +6,11 @@
 #include "game-object.h"
 #include "level-builder.h"
 #include "string-obfuscator.h"
+#include "pathfinder.h"
+#include "tile-layer.h"
+#include "occupancy-index.h"
+#include "update-list.h"
+#include "trigger-dispatcher.h"
 
 class Player;
 
@@ -18,22 +23,77 @@ class MapLevelBase
 
     void PlaceActor(GameObject* actor);
     void PlaceGameObject(GameObject* goToInsert);
+
+    //
+    // Index is position in GameObjects.
+    // Released object is no longer owned by the level.
+    //
+    void EraseGameObject(int index);
+    GameObject* ReleaseGameObject(int index);
+
+    //
+    // Same as above, but object is looked up in GameObjects first.
+    // Does nothing and returns nullptr if it's not there.
+    //
+    void EraseGameObject(GameObject* go);
+    GameObject* ReleaseGameObject(GameObject* go);
+
     void PlaceStaticObject(GameObject* goToInsert);
     void PlaceStaticObject(int x, int y,
                            const GameObjectInfo& objectInfo,
                            int hitPoints = -1,
                            GameObjectType type = GameObjectType::HARMLESS);
+
+    //
+    // Level takes ownership of trigger object
+    // and subscribes it to specified event.
+    //
+    void PlaceTrigger(GameObject* trigger, TriggerEventType eventType);
+    void PlaceTrigger(GameObject* trigger, const Position& cell);
+    void PlaceTurnTrigger(GameObject* trigger, uint64_t turn);
+
+    //
+    // GLOBAL is MAP_UPDATE, FINISH_TURN is TURN_FINISHED.
+    //
     void PlaceTrigger(GameObject* trigger, TriggerUpdateType updateType);
+
     void TryToSpawnMonsters();
 
+    //
+    // Respawn counter part of TryToSpawnMonsters()
+    // for Map::SkipIdleTicks().
+    //
+    int GetIdleTicks();
+    void SkipTicks(int ticks);
+
     virtual void PrepareMap();
     virtual void DisplayWelcomeText();
     virtual void OnLevelChanged(MapType from);
 
+    //
+    // Runs dungeon generator for this level (if it uses one).
+    // Can be called from background thread (see Map::PregenerateLevel()),
+    // so it mustn't touch anything besides MapSize, MapType_ and builder.
+    //
+    virtual void GenerateLayout(LevelBuilder& lb);
+
+    //
+    // World seed with level type mixed in, so that levels
+    // generated by the same method with the same parameters
+    // (e.g. ABYSS_1 - ABYSS_4) don't end up identical.
+    //
+    uint64_t GetLayoutSeed();
+
+    //
+    // Layout generated in advance, will be used by CreateLevel()
+    // instead of running generator again.
+    //
+    void SetPregeneratedLayout(std::unique_ptr<LevelBuilder> lb);
+
     //
     // TODO: save plan:
     //
-    // - MapArray
+    // - Tiles
     // - StaticMapObjects (without components)
     // - StaticMapObjects (with components)
     // - Items
@@ -67,7 +127,7 @@ class MapLevelBase
     // Map ground tiles (floor, water, ground etc.).
     // Drawn under fog of war.
     //
-    std::vector<std::vector<std::unique_ptr<GameObject>>> MapArray;
+    TileLayer Tiles;
 
     //
     // Static map objects without global update (walls, doors etc.)
@@ -78,7 +138,8 @@ class MapLevelBase
     //
     // Globally updated objects (traps with timers, shrines, etc.)
     // or objects that can be picked up (e.g. items).
-    // Updated every frame. Aren't drawn under fog of war.
+    // Those that need it are updated every frame (see GameObjectsUpdateList).
+    // Aren't drawn under fog of war.
     //
     std::vector<std::unique_ptr<GameObject>> GameObjects;
 
@@ -88,14 +149,31 @@ class MapLevelBase
     std::vector<std::unique_ptr<GameObject>> ActorGameObjects;
 
     //
-    // In-game events that are checked on GameObject::FinishTurn()
+    // Cell lookup for GameObjects and ActorGameObjects.
     //
-    std::vector<std::unique_ptr<GameObject>> FinishTurnTriggers;
+    OccupancyIndex GameObjectsIndex;
+    OccupancyIndex ActorsIndex;
 
     //
-    // In-game events that are checked on every Map::Update()
+    // Ticking components of GameObjects.
     //
-    std::vector<std::unique_ptr<GameObject>> GlobalTriggers;
+    UpdateList GameObjectsUpdateList;
+
+    //
+    // Invisible objects with TriggerComponent.
+    //
+    std::vector<std::unique_ptr<GameObject>> Triggers;
+
+    //
+    // Triggers by events they're subscribed to.
+    //
+    TriggerDispatcher TriggersDispatcher;
+
+    //
+    // Shared by everyone who needs a path on this level,
+    // so that A* grids are allocated only once.
+    //
+    Pathfinder LevelPathfinder;
 
     // -------------------------------------------------------------------------
     struct FowObj
@@ -132,6 +210,14 @@ class MapLevelBase
     int DungeonLevel     = 0;
     int VisibilityRadius = 0;
 
+    //
+    // Incremented every time something changes blocking status of a cell
+    // (door opened, wall destroyed etc.), so that cached data
+    // that depends on level layout (e.g. Player::DistanceField)
+    // knows when to be rebuilt.
+    //
+    uint32_t LayoutVersion = 0;
+
     bool WelcomeTextDisplayed   = false;
     bool Peaceful               = false;
     bool ExitFound              = false;
@@ -145,7 +231,11 @@ class MapLevelBase
     bool IsCellBlocking(const Position& pos);
 
     void UpdateFowLayer(GameObject* obj);
+    void UpdateFowLayerFromTile(int x, int y);
 
+    //
+    // Returns nullptr if there is only ground tile at pos.
+    //
     GameObject* GetTopmostObject(const Position& pos);
 
 #ifdef DEBUG_BUILD
@@ -159,6 +249,8 @@ class MapLevelBase
 
     StringV _specialLevel;
 
+    std::unique_ptr<LevelBuilder> _pregeneratedLayout;
+
     Player* _playerRef = nullptr;
 
     int _respawnCounter = 0;
@@ -167,6 +259,19 @@ class MapLevelBase
 
     void MaskToBoolFlags(const uint16_t mask);
 
+    bool TakeTrigger(GameObject* trigger);
+
+    int FindGameObjectIndex(GameObject* go);
+
+    int GetRespawnCounterIncrement();
+
+    //
+    // Returns true if it's time to try to spawn monster.
+    //
+    bool AdvanceRespawnCounter();
+
+    bool CanSpawnMonsters();
+
     void SerializeLayout(NRS& saveTo);
     void SerializeObjects(NRS& saveTo);
     void SerializeItems(NRS& saveTo);
@@ -177,6 +282,12 @@ class MapLevelBase
 
     void ConstructFromBuilder(LevelBuilder& lb);
 
+    //
+    // Returns pregenerated layout if there is one,
+    // otherwise calls GenerateLayout() right away.
+    //
+    std::unique_ptr<LevelBuilder> TakeLayout();
+
     void CreateGround(char img,
                       uint32_t fgColor,
                       uint32_t bgColor,
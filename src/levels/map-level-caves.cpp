@@ -11,9 +11,7 @@
 #include "stairs-component.h"
 #include "printer.h"
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
 MapLevelCaves::MapLevelCaves(int sizeX,
                              int sizeY,
@@ -106,21 +104,11 @@ void MapLevelCaves::PrepareMap()
 
 // =============================================================================
 
-void MapLevelCaves::CreateLevel()
+void MapLevelCaves::GenerateLayout(LevelBuilder& lb)
 {
-  VisibilityRadius = 6;
-  MonstersRespawnTurns = GlobalConstants::MonstersRespawnTimeout;
-
-  CreateGround('.',
-               Colors::ShadesOfGrey::Four,
-               Colors::BlackColor,
-               Strings::TileNames::StoneFloorText);
-
   int tunnelLengthMax = 5; //MapSize.X / 10;
   int tunnelLengthMin = 1; //tunnelLengthMax / 2;
 
-  LevelBuilder lb;
-
   switch (MapType_)
   {
     case MapType::CAVES_1:
@@ -157,11 +145,28 @@ void MapLevelCaves::CreateLevel()
     }
     break;
 
-    case MapType::CAVES_5:
-    {
-      CreateSpecialLevel();
-    }
-    break;
+    default:
+      break;
+  }
+}
+
+// =============================================================================
+
+void MapLevelCaves::CreateLevel()
+{
+  VisibilityRadius = 6;
+  MonstersRespawnTurns = GlobalConstants::MonstersRespawnTimeout;
+
+  CreateGround('.',
+               Colors::ShadesOfGrey::Four,
+               Colors::BlackColor,
+               Strings::TileNames::StoneFloorText);
+
+  auto lb = TakeLayout();
+
+  if (MapType_ == MapType::CAVES_5)
+  {
+    CreateSpecialLevel();
   }
 
   if (MapType_ != MapType::CAVES_5)
@@ -181,7 +186,7 @@ void MapLevelCaves::CreateLevel()
 
   if (MapType_ != MapType::CAVES_5)
   {
-    ConstructFromBuilder(lb);
+    ConstructFromBuilder(*lb.get());
 
     CreateRivers();
     RecordEmptyCells();
@@ -284,23 +289,30 @@ void MapLevelCaves::CreateSpecialLevel()
   const int startY = 7;
 
   GameObjectsFactory::Instance().CreateTrigger(TriggerType::ONE_SHOT,
-                                               TriggerUpdateType::FINISH_TURN,
-  [this, startX, startY]()
+                                               TriggerEventType::PLAYER_MOVED,
+  [this, startX, startY](const TriggerEvent&)
   {
     return !(_playerRef->PosX == startX
           && _playerRef->PosY == startY);
   },
-  [this, startX, startY]()
+  [this, startX, startY](const TriggerEvent&)
   {
     //
     // TODO: restore back after boss death.
     //
+    GameObjectInfo t;
+    t.Set(Tiles.IsBlocking(startX, startY),
+          Tiles.IsBlockingSight(startX, startY),
+          '.',
+          Colors::ShadesOfGrey::Four,
+          Colors::BlackColor,
+          Strings::TileNames::GroundText,
+          Tiles.GetFowName(startX, startY));
+
+    Tiles.MakeTile(startX, startY, t, Tiles.GetType(startX, startY));
+
     StairsComponent* sc =
-        MapArray[startX][startY]->GetComponent<StairsComponent>();
-    sc->OwnerGameObject->Image = '.';
-    sc->OwnerGameObject->FgColor = Colors::ShadesOfGrey::Four;
-    sc->OwnerGameObject->BgColor = Colors::BlackColor;
-    sc->OwnerGameObject->ObjectName = Strings::TileNames::GroundText;
+        Tiles.FindTileObject(startX, startY)->GetComponent<StairsComponent>();
     sc->IsEnabled = false;
 
     Printer::Instance().AddMessage("Suddenly the stairs slide up!");
@@ -419,7 +431,7 @@ void MapLevelCaves::CreateRivers()
     auto line = Util::BresenhamLine(start, end);
     for (auto& p : line)
     {
-      if (MapArray[p.X][p.Y]->Image == '.')
+      if (Tiles.GetImage(p.X, p.Y) == '.')
       {
         GameObjectInfo t;
         std::string objName = Strings::TileNames::ShallowWaterText;
@@ -429,7 +441,7 @@ void MapLevelCaves::CreateRivers()
               Colors::WhiteColor,
               Colors::ShallowWaterColor,
               objName);
-        MapArray[p.X][p.Y]->MakeTile(t, GameObjectType::SHALLOW_WATER);
+        Tiles.MakeTile(p.X, p.Y, t, GameObjectType::SHALLOW_WATER);
       }
     }
   }
@@ -13,6 +13,8 @@ class MapLevelCaves : public MapLevelBase
     void PrepareMap() override;
     void DisplayWelcomeText() override;
 
+    void GenerateLayout(LevelBuilder& lb) override;
+
   protected:
     void CreateLevel() override;
     void CreateSpecialLevel() override;
@@ -6,9 +6,7 @@
 #include "items-factory.h"
 #include "door-component.h"
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
 MapLevelDeepDark::MapLevelDeepDark(int sizeX,
                                    int sizeY,
@@ -52,23 +50,13 @@ void MapLevelDeepDark::PrepareMap()
 
 // =============================================================================
 
-void MapLevelDeepDark::CreateLevel()
+void MapLevelDeepDark::GenerateLayout(LevelBuilder& lb)
 {
-  VisibilityRadius = 3;
-  MonstersRespawnTurns = GlobalConstants::MonstersRespawnTimeout;
-
-  CreateGround('.',
-               Colors::ShadesOfGrey::Four,
-               Colors::BlackColor,
-               Strings::TileNames::GroundText);
-
   // NOTE: find out what was planned to do with these
 
   //int tunnelLengthMax = MapSize.X / 10;
   //int tunnelLengthMin = tunnelLengthMax / 2;
 
-  LevelBuilder lb;
-
   switch (MapType_)
   {
     case MapType::DEEP_DARK_1:
@@ -99,11 +87,28 @@ void MapLevelDeepDark::CreateLevel()
     }
     break;
 
-    case MapType::DEEP_DARK_5:
-    {
-      CreateSpecialLevel();
-    }
-    break;
+    default:
+      break;
+  }
+}
+
+// =============================================================================
+
+void MapLevelDeepDark::CreateLevel()
+{
+  VisibilityRadius = 3;
+  MonstersRespawnTurns = GlobalConstants::MonstersRespawnTimeout;
+
+  CreateGround('.',
+               Colors::ShadesOfGrey::Four,
+               Colors::BlackColor,
+               Strings::TileNames::GroundText);
+
+  auto lb = TakeLayout();
+
+  if (MapType_ == MapType::DEEP_DARK_5)
+  {
+    CreateSpecialLevel();
   }
 
   CreateBorders(' ',
@@ -113,7 +118,7 @@ void MapLevelDeepDark::CreateLevel()
 
   if (MapType_ != MapType::DEEP_DARK_5)
   {
-    ConstructFromBuilder(lb);
+    ConstructFromBuilder(*lb.get());
 
     RecordEmptyCells();
     PlaceStairs();
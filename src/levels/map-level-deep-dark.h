@@ -11,6 +11,8 @@ class MapLevelDeepDark : public MapLevelBase
     void PrepareMap() override;
     void DisplayWelcomeText() override;
 
+    void GenerateLayout(LevelBuilder& lb) override;
+
   protected:
     void CreateLevel() override;
     void CreateSpecialLevel() override;
@@ -4,9 +4,7 @@
 #include "game-object-info.h"
 #include "application.h"
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
 MapLevelLostCity::MapLevelLostCity(int sizeX,
                                    int sizeY,
@@ -27,18 +25,8 @@ void MapLevelLostCity::PrepareMap()
 
 // =============================================================================
 
-void MapLevelLostCity::CreateLevel()
+void MapLevelLostCity::GenerateLayout(LevelBuilder& lb)
 {
-  VisibilityRadius = 20;
-  MonstersRespawnTurns = GlobalConstants::MonstersRespawnTimeout;
-
-  CreateGround('.',
-               Colors::ShadesOfGrey::Four,
-               Colors::BlackColor,
-               Strings::TileNames::GroundText);
-
-  LevelBuilder lb;
-
   FeatureRoomsWeights weights =
   {
     { FeatureRoomType::EMPTY,    { 10, 0 } },
@@ -55,8 +43,23 @@ void MapLevelLostCity::CreateLevel()
   Position roomSize = { 1, 11 };
 
   lb.FeatureRoomsMethod(MapSize, roomSize, weights, 30, MapSize.X * MapSize.Y);
+}
+
+// =============================================================================
+
+void MapLevelLostCity::CreateLevel()
+{
+  VisibilityRadius = 20;
+  MonstersRespawnTurns = GlobalConstants::MonstersRespawnTimeout;
+
+  CreateGround('.',
+               Colors::ShadesOfGrey::Four,
+               Colors::BlackColor,
+               Strings::TileNames::GroundText);
+
+  auto lb = TakeLayout();
 
-  ConstructFromBuilder(lb);
+  ConstructFromBuilder(*lb.get());
 
   CreateBorders(' ',
                 Colors::BlackColor,
@@ -67,7 +70,7 @@ void MapLevelLostCity::CreateLevel()
   PlaceStairs();
   //CreateInitialMonsters();
 
-  CreateShrines(lb);
+  CreateShrines(*lb.get());
 
   int itemsToCreate = GetEstimatedNumberOfItemsToCreate();
   CreateItemsForLevel(itemsToCreate);
@@ -13,6 +13,8 @@ class MapLevelLostCity : public MapLevelBase
     void PrepareMap() override;
     void DisplayWelcomeText() override;
 
+    void GenerateLayout(LevelBuilder& lb) override;
+
   protected:
     void CreateLevel() override;
 
@@ -15,9 +15,7 @@
 #include "player.h"
 #include "printer.h"
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
 MapLevelMines::MapLevelMines(int sizeX,
                              int sizeY,
@@ -112,18 +110,8 @@ void MapLevelMines::PrepareMap()
 
 // =============================================================================
 
-void MapLevelMines::CreateLevel()
+void MapLevelMines::GenerateLayout(LevelBuilder& lb)
 {
-  VisibilityRadius = 8;
-  MonstersRespawnTurns = GlobalConstants::MonstersRespawnTimeout;
-
-  CreateGround('.',
-               Colors::ShadesOfGrey::Four,
-               Colors::BlackColor,
-               Strings::TileNames::DirtText);
-
-  LevelBuilder lb;
-
   switch (MapType_)
   {
     case MapType::MINES_1:
@@ -141,7 +129,14 @@ void MapLevelMines::CreateLevel()
         { 40, 60 }
       };
 
-      int ind = RNG::Instance().RandomRange(0, splitRatios.size());
+      //
+      // Global RNG mustn't be touched here (see Map::PregenerateLevel()).
+      // Seed is inverted, otherwise this would be the same stream
+      // the generator itself gets from lb.
+      //
+      std::mt19937_64 rng(~GetLayoutSeed());
+
+      int ind = Util::RandomRange(0, splitRatios.size(), rng);
 
       lb.BSPRoomsMethod(MapSize, splitRatios[ind], 7);
     }
@@ -158,9 +153,38 @@ void MapLevelMines::CreateLevel()
       lb.BacktrackingTunnelerMethod(MapSize, { 5, 10 }, { 1, 1 }, true);
       break;
 
-    case MapType::MINES_5:
-      CreateSpecialLevel();
-      break;
+    default:
+      return;
+  }
+
+  TransformedRoomsWeights weights =
+  {
+    { TransformedRoom::EMPTY,   {  1, 0 } },
+    { TransformedRoom::SHRINE,  {  5, 1 } },
+    { TransformedRoom::STORAGE, { 10, 2 } },
+    { TransformedRoom::FLOODED, {  3, 1 } },
+  };
+
+  lb.TransformRooms(weights);
+}
+
+// =============================================================================
+
+void MapLevelMines::CreateLevel()
+{
+  VisibilityRadius = 8;
+  MonstersRespawnTurns = GlobalConstants::MonstersRespawnTimeout;
+
+  CreateGround('.',
+               Colors::ShadesOfGrey::Four,
+               Colors::BlackColor,
+               Strings::TileNames::DirtText);
+
+  auto lb = TakeLayout();
+
+  if (MapType_ == MapType::MINES_5)
+  {
+    CreateSpecialLevel();
   }
 
   CreateBorders(' ',
@@ -170,17 +194,7 @@ void MapLevelMines::CreateLevel()
 
   if (MapType_ != MapType::MINES_5)
   {
-    TransformedRoomsWeights weights =
-    {
-      { TransformedRoom::EMPTY,   {  1, 0 } },
-      { TransformedRoom::SHRINE,  {  5, 1 } },
-      { TransformedRoom::STORAGE, { 10, 2 } },
-      { TransformedRoom::FLOODED, {  3, 1 } },
-    };
-
-    lb.TransformRooms(weights);
-
-    ConstructFromBuilder(lb);
+    ConstructFromBuilder(*lb.get());
 
     RecordEmptyCells();
 
@@ -319,8 +333,8 @@ void MapLevelMines::CreateSpecialLevel()
 
           GameObjectsFactory::Instance().CreateTrigger(
                 TriggerType::ONE_SHOT,
-                TriggerUpdateType::FINISH_TURN,
-          [this]()
+                TriggerEventType::PLAYER_MOVED,
+          [this](const TriggerEvent&)
           {
             //
             // Mark area where trigger shouldn't activate...
@@ -333,7 +347,7 @@ void MapLevelMines::CreateSpecialLevel()
             //
             return !activate;
           },
-          [this, boss]()
+          [this, boss](const TriggerEvent&)
           {
             //
             // Place cave-in.
@@ -442,6 +456,7 @@ void MapLevelMines::OnLevelChanged(MapType from)
     if (StaticMapObjects[2][2] != nullptr)
     {
       StaticMapObjects[2][2].reset();
+      LayoutVersion++;
     }
   }
 }
@@ -476,7 +491,7 @@ void MapLevelMines::CreateSpecialMonsters()
       int index = RNG::Instance().RandomRange(0, _emptyCells.size());
       int x = _emptyCells[index].X;
       int y = _emptyCells[index].Y;
-      if (!MapArray[x][y]->Occupied)
+      if (!Tiles.IsOccupied(x, y))
       {
         GameObject* m =
             MonstersInc::Instance().CreateMonster(x,
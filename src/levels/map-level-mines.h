@@ -14,6 +14,8 @@ class MapLevelMines : public MapLevelBase
     void DisplayWelcomeText() override;
     void OnLevelChanged(MapType from) override;
 
+    void GenerateLayout(LevelBuilder& lb) override;
+
   protected:
     void CreateLevel() override;
     void CreateSpecialLevel() override;
@@ -5,9 +5,7 @@
 #include "game-objects-factory.h"
 #include "door-component.h"
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
 MapLevelNether::MapLevelNether(int sizeX,
                                int sizeY,
@@ -45,6 +43,16 @@ void MapLevelNether::PrepareMap()
 
 // =============================================================================
 
+void MapLevelNether::GenerateLayout(LevelBuilder& lb)
+{
+  if (MapType_ != MapType::NETHER_5)
+  {
+    lb.CellularAutomataMethod(MapSize, 40, 5, 4, 12);
+  }
+}
+
+// =============================================================================
+
 void MapLevelNether::CreateLevel()
 {
   VisibilityRadius = 20;
@@ -55,16 +63,11 @@ void MapLevelNether::CreateLevel()
                Colors::BlackColor,
                Strings::TileNames::HellstoneText);
 
-  LevelBuilder lb;
-  switch (MapType_)
-  {
-    case MapType::NETHER_5:
-      CreateSpecialLevel();
-      break;
+  auto lb = TakeLayout();
 
-    default:
-      lb.CellularAutomataMethod(MapSize, 40, 5, 4, 12);
-      break;
+  if (MapType_ == MapType::NETHER_5)
+  {
+    CreateSpecialLevel();
   }
 
   CreateBorders(' ',
@@ -74,7 +77,7 @@ void MapLevelNether::CreateLevel()
 
   if (MapType_ != MapType::NETHER_5)
   {
-    ConstructFromBuilder(lb);
+    ConstructFromBuilder(*lb.get());
 
     RecordEmptyCells();
     PlaceStairs();
@@ -11,6 +11,8 @@ class MapLevelNether : public MapLevelBase
     void PrepareMap() override;
     void DisplayWelcomeText() override;
 
+    void GenerateLayout(LevelBuilder& lb) override;
+
   protected:
     void CreateLevel() override;
 
@@ -359,8 +359,13 @@ void MapLevelTown::BuildRoads()
 void MapLevelTown::BuildAndDrawRoad(const Position& start,
                                     const Position& end)
 {
-  Pathfinder pf;
-  auto path = pf.BuildRoad(this, start, end, { '~' }, true, false, 0);
+  auto path = LevelPathfinder.BuildRoad(this,
+                                        start,
+                                        end,
+                                        { '~' },
+                                        true,
+                                        false,
+                                        0);
 
   PlaceGroundTile(start.X,
                   start.Y,
@@ -401,7 +406,7 @@ void MapLevelTown::ReplaceGroundWithGrass()
   {
     for (int y = 1; y < MapSize.Y - 1; y++)
     {
-      if (MapArray[x][y]->Image == '.')
+      if (Tiles.GetImage(x, y) == '.')
       {
         PlaceGrassTile(x, y, FlowersFrequency);
       }
@@ -831,14 +836,14 @@ void MapLevelTown::CreateNPCs()
         }
 
         bool isBlocking = IsCellBlocking({ x, y });
-        bool isSpecial = MapArray[x][y]->Special;
+        bool isSpecial = Tiles.IsSpecial(x, y);
 
         //
         // Also avoid shallow water tiles
         // or NPC may spawn inside walled fountain.
         //
         if (!alreadyAdded && !isBlocking
-         && !isSpecial && MapArray[x][y]->Image != '~')
+         && !isSpecial && Tiles.GetImage(x, y) != '~')
         {
           emptyCells.push_back(Position(x, y));
         }
@@ -1034,8 +1039,8 @@ void MapLevelTown::PlacePortalSquare(int x, int y)
                 Colors::BlackColor,
                 Colors::ShadesOfGrey::Ten,
                 Strings::TileNames::StoneTilesText);
-          MapArray[posX][posY]->MakeTile(t);
-          MapArray[posX][posY]->Special = true;
+          Tiles.MakeTile(posX, posY, t);
+          Tiles.SetSpecial(posX, posY, true);
         }
         break;
 
@@ -1047,8 +1052,8 @@ void MapLevelTown::PlacePortalSquare(int x, int y)
                 Colors::BlackColor,
                 Colors::ShadesOfGrey::Ten,
                 Strings::TileNames::StoneTilesText);
-          MapArray[posX][posY]->MakeTile(t);
-          MapArray[posX][posY]->Special = true;
+          Tiles.MakeTile(posX, posY, t);
+          Tiles.SetSpecial(posX, posY, true);
         }
         break;
       }
@@ -0,0 +1,220 @@
+#include "occupancy-index.h"
+
+#include "game-object.h"
+#include "util.h"
+
+#include <algorithm>
+
+void OccupancyIndex::Init(const Position& mapSize)
+{
+  Clear();
+
+  _mapSize = mapSize;
+
+  int chunkSize = (1 << kChunkShift);
+
+  _chunksSize.X = (_mapSize.X + chunkSize - 1) >> kChunkShift;
+  _chunksSize.Y = (_mapSize.Y + chunkSize - 1) >> kChunkShift;
+
+  _cells.resize(_mapSize.X * _mapSize.Y);
+  _chunkCounts.assign(_chunksSize.X * _chunksSize.Y, 0);
+}
+
+// =============================================================================
+
+void OccupancyIndex::Clear()
+{
+  _cells.clear();
+  _chunkCounts.clear();
+
+  _count = 0;
+}
+
+// =============================================================================
+
+void OccupancyIndex::Add(GameObject* go)
+{
+  if (go == nullptr || !IsInside(go->PosX, go->PosY))
+  {
+    DebugLog("[WAR] OccupancyIndex::Add() bad object!");
+    return;
+  }
+
+  _cells[ToIndex(go->PosX, go->PosY)].push_back(go);
+  _chunkCounts[ToChunkIndex(go->PosX, go->PosY)]++;
+
+  _count++;
+}
+
+// =============================================================================
+
+void OccupancyIndex::Remove(GameObject* go)
+{
+  if (go == nullptr)
+  {
+    return;
+  }
+
+  if (RemoveFromCell(go, go->PosX, go->PosY))
+  {
+    return;
+  }
+
+  //
+  // Shouldn't happen unless position was changed bypassing Move(),
+  // but leaving dangling pointer here is worse than full scan.
+  //
+  DebugLog("[WAR] OccupancyIndex::Remove() object not found at (%i;%i)!",
+           go->PosX, go->PosY);
+
+  for (int x = 0; x < _mapSize.X; x++)
+  {
+    for (int y = 0; y < _mapSize.Y; y++)
+    {
+      if (RemoveFromCell(go, x, y))
+      {
+        return;
+      }
+    }
+  }
+}
+
+// =============================================================================
+
+void OccupancyIndex::Move(GameObject* go, int fromX, int fromY)
+{
+  if (fromX == go->PosX && fromY == go->PosY)
+  {
+    return;
+  }
+
+  if (RemoveFromCell(go, fromX, fromY))
+  {
+    Add(go);
+  }
+}
+
+// =============================================================================
+
+const std::vector<GameObject*>& OccupancyIndex::Get(int x, int y)
+{
+  return IsInside(x, y) ? _cells[ToIndex(x, y)] : _empty;
+}
+
+// =============================================================================
+
+bool OccupancyIndex::IsEmpty(int x, int y)
+{
+  return Get(x, y).empty();
+}
+
+// =============================================================================
+
+bool OccupancyIndex::Contains(GameObject* go)
+{
+  const auto& cell = Get(go->PosX, go->PosY);
+
+  return (std::find(cell.begin(), cell.end(), go) != cell.end());
+}
+
+// =============================================================================
+
+std::vector<GameObject*> OccupancyIndex::GetInRect(int lx, int ly,
+                                                   int hx, int hy)
+{
+  std::vector<GameObject*> res;
+
+  if (_count == 0)
+  {
+    return res;
+  }
+
+  lx = std::max(lx, 0);
+  ly = std::max(ly, 0);
+  hx = std::min(hx, _mapSize.X - 1);
+  hy = std::min(hy, _mapSize.Y - 1);
+
+  for (int cx = (lx >> kChunkShift); cx <= (hx >> kChunkShift); cx++)
+  {
+    for (int cy = (ly >> kChunkShift); cy <= (hy >> kChunkShift); cy++)
+    {
+      if (_chunkCounts[cx * _chunksSize.Y + cy] == 0)
+      {
+        continue;
+      }
+
+      int sx = std::max(lx, cx << kChunkShift);
+      int sy = std::max(ly, cy << kChunkShift);
+      int ex = std::min(hx, ((cx + 1) << kChunkShift) - 1);
+      int ey = std::min(hy, ((cy + 1) << kChunkShift) - 1);
+
+      for (int x = sx; x <= ex; x++)
+      {
+        for (int y = sy; y <= ey; y++)
+        {
+          auto& cell = _cells[ToIndex(x, y)];
+          res.insert(res.end(), cell.begin(), cell.end());
+        }
+      }
+    }
+  }
+
+  return res;
+}
+
+// =============================================================================
+
+size_t OccupancyIndex::Count()
+{
+  return _count;
+}
+
+// =============================================================================
+
+bool OccupancyIndex::IsInside(int x, int y)
+{
+  return (x >= 0 && x < _mapSize.X && y >= 0 && y < _mapSize.Y);
+}
+
+// =============================================================================
+
+bool OccupancyIndex::RemoveFromCell(GameObject* go, int x, int y)
+{
+  if (!IsInside(x, y))
+  {
+    return false;
+  }
+
+  auto& cell = _cells[ToIndex(x, y)];
+
+  auto it = std::find(cell.begin(), cell.end(), go);
+  if (it == cell.end())
+  {
+    return false;
+  }
+
+  //
+  // Keep the order, topmost object is the last one.
+  //
+  cell.erase(it);
+
+  _chunkCounts[ToChunkIndex(x, y)]--;
+
+  _count--;
+
+  return true;
+}
+
+// =============================================================================
+
+int OccupancyIndex::ToIndex(int x, int y)
+{
+  return x * _mapSize.Y + y;
+}
+
+// =============================================================================
+
+int OccupancyIndex::ToChunkIndex(int x, int y)
+{
+  return (x >> kChunkShift) * _chunksSize.Y + (y >> kChunkShift);
+}
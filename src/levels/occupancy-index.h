@@ -0,0 +1,84 @@
+#ifndef OCCUPANCYINDEX_H
+#define OCCUPANCYINDEX_H
+
+#include <vector>
+#include <cstddef>
+
+#include "position.h"
+
+class GameObject;
+
+//
+// Per-cell list of objects from one of the level collections
+// (actors or game objects), so that "what is at (x, y)" questions
+// don't require going through the whole collection.
+//
+// Objects are kept in the order they were added,
+// so the last one in the cell is the topmost one.
+//
+// Cells are also grouped into chunks with object counters,
+// which allows rectangular queries to skip empty parts of the map.
+//
+// Index doesn't own anything: whoever adds or removes objects
+// from the collection must do the same here
+// (see MapLevelBase::PlaceActor() and friends).
+//
+class OccupancyIndex
+{
+  public:
+    void Init(const Position& mapSize);
+    void Clear();
+
+    void Add(GameObject* go);
+
+    //
+    // Object is expected to be at its current position.
+    //
+    void Remove(GameObject* go);
+
+    //
+    // Object's PosX and PosY must already be updated.
+    // Does nothing if object wasn't in the index at (fromX, fromY).
+    //
+    void Move(GameObject* go, int fromX, int fromY);
+
+    const std::vector<GameObject*>& Get(int x, int y);
+
+    bool IsEmpty(int x, int y);
+
+    //
+    // Checks only the cell object is currently at.
+    //
+    bool Contains(GameObject* go);
+
+    //
+    // Inclusive bounds, clamped to map size.
+    //
+    std::vector<GameObject*> GetInRect(int lx, int ly, int hx, int hy);
+
+    size_t Count();
+
+  private:
+    static const int kChunkShift = 3;
+
+    std::vector<std::vector<GameObject*>> _cells;
+    std::vector<int> _chunkCounts;
+
+    //
+    // Returned by Get() for out of bounds positions.
+    //
+    std::vector<GameObject*> _empty;
+
+    Position _mapSize;
+    Position _chunksSize;
+
+    size_t _count = 0;
+
+    bool IsInside(int x, int y);
+    bool RemoveFromCell(GameObject* go, int x, int y);
+
+    int ToIndex(int x, int y);
+    int ToChunkIndex(int x, int y);
+};
+
+#endif // OCCUPANCYINDEX_H
@@ -0,0 +1,448 @@
+#include "tile-layer.h"
+
+#include "map-level-base.h"
+#include "printer.h"
+
+void TileLayer::Init(MapLevelBase* levelOwner, const Position& mapSize)
+{
+  Clear();
+
+  _levelOwner = levelOwner;
+  _mapSize    = mapSize;
+
+  size_t size = _mapSize.X * _mapSize.Y;
+
+  //
+  // Same as default GameObject before MakeTile() is called on it.
+  //
+  _images.assign(size, '?');
+  _fgColors.assign(size, Colors::WhiteColor);
+  _bgColors.assign(size, Colors::MagentaColor);
+  _types.assign(size, GameObjectType::HARMLESS);
+  _zoneMarkers.assign(size, TransformedRoom::UNMARKED);
+  _flags.assign(size, 0);
+  _nameIndices.assign(size, 0);
+  _fowNameIndices.assign(size, 0);
+
+  //
+  // Index 0 is always empty string.
+  //
+  GetNameIndex(std::string());
+}
+
+// =============================================================================
+
+void TileLayer::Clear()
+{
+  _tileObjects.clear();
+
+  _images.clear();
+  _fgColors.clear();
+  _bgColors.clear();
+  _types.clear();
+  _zoneMarkers.clear();
+  _flags.clear();
+  _nameIndices.clear();
+  _fowNameIndices.clear();
+
+  _names.clear();
+  _nameIndexByString.clear();
+}
+
+// =============================================================================
+
+void TileLayer::MakeTile(int x, int y,
+                         const GameObjectInfo& t,
+                         GameObjectType typeOverride)
+{
+  int index = ToIndex(x, y);
+
+  bool layoutChanged = (IsBlocking(x, y)      != t.IsBlocking
+                     || IsBlockingSight(x, y) != t.BlocksSight
+                     || _types[index]         != typeOverride);
+
+  SetFlag(x, y, kFlagBlocking,    t.IsBlocking);
+  SetFlag(x, y, kFlagBlocksSight, t.BlocksSight);
+
+  _images[index]         = t.Image;
+  _fgColors[index]       = t.FgColor;
+  _bgColors[index]       = t.BgColor;
+  _nameIndices[index]    = GetNameIndex(t.ObjectName);
+  _fowNameIndices[index] = GetNameIndex(t.FogOfWarName);
+  _types[index]          = typeOverride;
+
+  GameObject* obj = FindTileObject(x, y);
+  if (obj != nullptr)
+  {
+    SyncTileObject(index, obj);
+  }
+
+  if (layoutChanged)
+  {
+    OnLayoutChanged();
+  }
+}
+
+// =============================================================================
+
+void TileLayer::Draw(int x, int y)
+{
+  int index = ToIndex(x, y);
+
+  uint32_t fgColor = _fgColors[index];
+  uint32_t bgColor = _bgColors[index];
+
+  if (fgColor == Colors::None && bgColor == Colors::None)
+  {
+    return;
+  }
+
+  //
+  // See comments in GameObject::Draw()
+  //
+  if (bgColor == Colors::None)
+  {
+    bgColor = Colors::BlackColor;
+  }
+
+  Printer::Instance().PrintFB(x + _levelOwner->MapOffsetX,
+                              y + _levelOwner->MapOffsetY,
+                              _images[index],
+                              fgColor,
+                              bgColor);
+}
+
+// =============================================================================
+
+bool TileLayer::IsBlocking(int x, int y)
+{
+  return HasFlag(x, y, kFlagBlocking);
+}
+
+// =============================================================================
+
+bool TileLayer::IsBlockingSight(int x, int y)
+{
+  return HasFlag(x, y, kFlagBlocksSight);
+}
+
+// =============================================================================
+
+bool TileLayer::IsVisible(int x, int y)
+{
+  return HasFlag(x, y, kFlagVisible);
+}
+
+// =============================================================================
+
+bool TileLayer::IsRevealed(int x, int y)
+{
+  return HasFlag(x, y, kFlagRevealed);
+}
+
+// =============================================================================
+
+bool TileLayer::IsOccupied(int x, int y)
+{
+  return HasFlag(x, y, kFlagOccupied);
+}
+
+// =============================================================================
+
+bool TileLayer::IsSpecial(int x, int y)
+{
+  return HasFlag(x, y, kFlagSpecial);
+}
+
+// =============================================================================
+
+void TileLayer::SetVisible(int x, int y, bool value)
+{
+  SetFlag(x, y, kFlagVisible, value);
+}
+
+// =============================================================================
+
+void TileLayer::SetRevealed(int x, int y, bool value)
+{
+  SetFlag(x, y, kFlagRevealed, value);
+}
+
+// =============================================================================
+
+void TileLayer::SetOccupied(int x, int y, bool value)
+{
+  SetFlag(x, y, kFlagOccupied, value);
+}
+
+// =============================================================================
+
+void TileLayer::SetSpecial(int x, int y, bool value)
+{
+  SetFlag(x, y, kFlagSpecial, value);
+}
+
+// =============================================================================
+
+int TileLayer::GetImage(int x, int y)
+{
+  return _images[ToIndex(x, y)];
+}
+
+// =============================================================================
+
+const uint32_t& TileLayer::GetFgColor(int x, int y)
+{
+  return _fgColors[ToIndex(x, y)];
+}
+
+// =============================================================================
+
+const uint32_t& TileLayer::GetBgColor(int x, int y)
+{
+  return _bgColors[ToIndex(x, y)];
+}
+
+// =============================================================================
+
+GameObjectType TileLayer::GetType(int x, int y)
+{
+  return _types[ToIndex(x, y)];
+}
+
+// =============================================================================
+
+void TileLayer::SetType(int x, int y, GameObjectType type)
+{
+  int index = ToIndex(x, y);
+
+  if (_types[index] != type)
+  {
+    OnLayoutChanged();
+  }
+
+  _types[index] = type;
+
+  GameObject* obj = FindTileObject(x, y);
+  if (obj != nullptr)
+  {
+    obj->Type = type;
+  }
+}
+
+// =============================================================================
+
+TransformedRoom TileLayer::GetZoneMarker(int x, int y)
+{
+  return _zoneMarkers[ToIndex(x, y)];
+}
+
+// =============================================================================
+
+void TileLayer::SetZoneMarker(int x, int y, TransformedRoom zoneMarker)
+{
+  _zoneMarkers[ToIndex(x, y)] = zoneMarker;
+}
+
+// =============================================================================
+
+const std::string& TileLayer::GetName(int x, int y)
+{
+  return _names[_nameIndices[ToIndex(x, y)]];
+}
+
+// =============================================================================
+
+const std::string& TileLayer::GetFowName(int x, int y)
+{
+  return _names[_fowNameIndices[ToIndex(x, y)]];
+}
+
+// =============================================================================
+
+const GameObject::SaveDataMinimal& TileLayer::GetSaveDataMinimal(int x, int y)
+{
+  int index = ToIndex(x, y);
+
+  _sdm.Type       = _types[index];
+  _sdm.ZoneMarker = _zoneMarkers[index];
+  _sdm.Image      = _images[index];
+  _sdm.PosX       = x;
+  _sdm.PosY       = y;
+  _sdm.FgColor    = _fgColors[index];
+  _sdm.BgColor    = _bgColors[index];
+  _sdm.Name       = _names[_nameIndices[index]];
+  _sdm.FowName    = _names[_fowNameIndices[index]];
+
+  //
+  // Must be in the same order as in GameObject::GetSaveDataMinimal().
+  // Tiles are always corporeal and never living.
+  //
+  _sdm.Mask = Util::BoolFlagsToMask({
+                                      IsSpecial(x, y),
+                                      IsBlocking(x, y),
+                                      IsBlockingSight(x, y),
+                                      IsRevealed(x, y),
+                                      true,
+                                      IsVisible(x, y),
+                                      false
+                                    });
+
+  return _sdm;
+}
+
+// =============================================================================
+
+GameObject* TileLayer::GetTileObject(int x, int y)
+{
+  int index = ToIndex(x, y);
+
+  auto& obj = _tileObjects[index];
+
+  if (obj == nullptr)
+  {
+    obj = MakeTileObject(x, y);
+  }
+  else
+  {
+    SyncTileObject(index, obj.get());
+  }
+
+  return obj.get();
+}
+
+// =============================================================================
+
+std::unique_ptr<GameObject> TileLayer::MakeTileObject(int x, int y)
+{
+  int index = ToIndex(x, y);
+
+  auto obj = std::make_unique<GameObject>(_levelOwner);
+  obj->Init(_levelOwner,
+            x,
+            y,
+            _images[index],
+            _fgColors[index],
+            _bgColors[index]);
+
+  SyncTileObject(index, obj.get());
+
+  return obj;
+}
+
+// =============================================================================
+
+GameObject* TileLayer::FindTileObject(int x, int y)
+{
+  auto it = _tileObjects.find(ToIndex(x, y));
+
+  return (it != _tileObjects.end()) ? it->second.get() : nullptr;
+}
+
+// =============================================================================
+
+GameObject* TileLayer::FindTileObject(const uint64_t& objId)
+{
+  GameObject* go = GameObjectsRegistry::Instance().FindById(objId);
+  if (go == nullptr)
+  {
+    return nullptr;
+  }
+
+  //
+  // Tile objects sit at their own cell,
+  // anything else with this id doesn't belong to us.
+  //
+  return (FindTileObject(go->PosX, go->PosY) == go) ? go : nullptr;
+}
+
+// =============================================================================
+
+const std::unordered_map<int, std::unique_ptr<GameObject>>&
+TileLayer::GetTileObjects()
+{
+  return _tileObjects;
+}
+
+// =============================================================================
+
+void TileLayer::SyncTileObject(int index, GameObject* obj)
+{
+  int x = obj->PosX;
+  int y = obj->PosY;
+
+  obj->Image        = _images[index];
+  obj->FgColor      = _fgColors[index];
+  obj->BgColor      = _bgColors[index];
+  obj->ObjectName   = _names[_nameIndices[index]];
+  obj->FogOfWarName = _names[_fowNameIndices[index]];
+  obj->Type         = _types[index];
+  obj->ZoneMarker   = _zoneMarkers[index];
+  obj->Blocking     = IsBlocking(x, y);
+  obj->BlocksSight  = IsBlockingSight(x, y);
+  obj->Visible      = IsVisible(x, y);
+  obj->Revealed     = IsRevealed(x, y);
+  obj->Occupied     = IsOccupied(x, y);
+  obj->Special      = IsSpecial(x, y);
+}
+
+// =============================================================================
+
+int TileLayer::ToIndex(int x, int y)
+{
+  return x * _mapSize.Y + y;
+}
+
+// =============================================================================
+
+uint16_t TileLayer::GetNameIndex(const std::string& name)
+{
+  auto it = _nameIndexByString.find(name);
+  if (it != _nameIndexByString.end())
+  {
+    return it->second;
+  }
+
+  uint16_t index = _names.size();
+
+  _names.push_back(name);
+  _nameIndexByString[name] = index;
+
+  return index;
+}
+
+// =============================================================================
+
+bool TileLayer::HasFlag(int x, int y, uint8_t flag)
+{
+  return (_flags[ToIndex(x, y)] & flag);
+}
+
+// =============================================================================
+
+void TileLayer::SetFlag(int x, int y, uint8_t flag, bool value)
+{
+  uint8_t& flags = _flags[ToIndex(x, y)];
+
+  if (value)
+  {
+    flags |= flag;
+  }
+  else
+  {
+    flags &= ~flag;
+  }
+}
+
+// =============================================================================
+
+void TileLayer::OnLayoutChanged()
+{
+  //
+  // Null in tests.
+  //
+  if (_levelOwner != nullptr)
+  {
+    _levelOwner->LayoutVersion++;
+  }
+}
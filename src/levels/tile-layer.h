@@ -0,0 +1,138 @@
+#ifndef TILELAYER_H
+#define TILELAYER_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+
+#include "game-object.h"
+#include "game-object-info.h"
+#include "position.h"
+
+class MapLevelBase;
+
+//
+// Ground tiles of the level (floor, water, lava etc.)
+// stored as flat arrays indexed by [x * MapSize.Y + y].
+//
+// Tile used to be a whole GameObject with attributes, maps, callbacks
+// and so on, while all it really needs is an image, colors,
+// couple of flags and a name. Names are stored once per level
+// in a table and tiles only keep index into it.
+//
+// For the rare cases where GameObject is still needed it's created
+// on demand. Objects that have to live on (stairs with their component)
+// are made by GetTileObject() and kept until level is gone.
+// Code that only needs tile as a GameObject for a moment (target of
+// a missed shot or an attack at empty cell) gets its own copy from
+// MakeTileObject() instead, so that such cells don't pile up.
+// Either object is a mirror of the tile: change tile state through
+// this class, not through the object.
+//
+class TileLayer
+{
+  public:
+    void Init(MapLevelBase* levelOwner, const Position& mapSize);
+    void Clear();
+
+    void MakeTile(int x, int y,
+                  const GameObjectInfo& t,
+                  GameObjectType typeOverride = GameObjectType::GROUND);
+
+    void Draw(int x, int y);
+
+    bool IsBlocking(int x, int y);
+    bool IsBlockingSight(int x, int y);
+    bool IsVisible(int x, int y);
+    bool IsRevealed(int x, int y);
+    bool IsOccupied(int x, int y);
+    bool IsSpecial(int x, int y);
+
+    void SetVisible(int x, int y, bool value);
+    void SetRevealed(int x, int y, bool value);
+    void SetOccupied(int x, int y, bool value);
+    void SetSpecial(int x, int y, bool value);
+
+    int GetImage(int x, int y);
+
+    const uint32_t& GetFgColor(int x, int y);
+    const uint32_t& GetBgColor(int x, int y);
+
+    GameObjectType GetType(int x, int y);
+    void SetType(int x, int y, GameObjectType type);
+
+    TransformedRoom GetZoneMarker(int x, int y);
+    void SetZoneMarker(int x, int y, TransformedRoom zoneMarker);
+
+    const std::string& GetName(int x, int y);
+    const std::string& GetFowName(int x, int y);
+
+    const GameObject::SaveDataMinimal& GetSaveDataMinimal(int x, int y);
+
+    //
+    // Creates GameObject for the tile if there isn't one yet
+    // and updates it with current tile state.
+    //
+    GameObject* GetTileObject(int x, int y);
+
+    //
+    // Same as above, but the object isn't kept by the layer
+    // and is gone once caller is done with it.
+    //
+    std::unique_ptr<GameObject> MakeTileObject(int x, int y);
+
+    //
+    // Returns already created tile object or nullptr.
+    //
+    GameObject* FindTileObject(int x, int y);
+    GameObject* FindTileObject(const uint64_t& objId);
+
+    const std::unordered_map<int, std::unique_ptr<GameObject>>& GetTileObjects();
+
+  private:
+    static const uint8_t kFlagBlocking    = 1 << 0;
+    static const uint8_t kFlagBlocksSight = 1 << 1;
+    static const uint8_t kFlagVisible     = 1 << 2;
+    static const uint8_t kFlagRevealed    = 1 << 3;
+    static const uint8_t kFlagOccupied    = 1 << 4;
+    static const uint8_t kFlagSpecial     = 1 << 5;
+
+    std::vector<int>             _images;
+    std::vector<uint32_t>        _fgColors;
+    std::vector<uint32_t>        _bgColors;
+    std::vector<GameObjectType>  _types;
+    std::vector<TransformedRoom> _zoneMarkers;
+    std::vector<uint8_t>         _flags;
+    std::vector<uint16_t>        _nameIndices;
+    std::vector<uint16_t>        _fowNameIndices;
+
+    std::vector<std::string> _names;
+    std::unordered_map<std::string, uint16_t> _nameIndexByString;
+
+    std::unordered_map<int, std::unique_ptr<GameObject>> _tileObjects;
+
+    GameObject::SaveDataMinimal _sdm;
+
+    Position _mapSize;
+
+    MapLevelBase* _levelOwner = nullptr;
+
+    int ToIndex(int x, int y);
+
+    uint16_t GetNameIndex(const std::string& name);
+
+    bool HasFlag(int x, int y, uint8_t flag);
+    void SetFlag(int x, int y, uint8_t flag, bool value);
+
+    //
+    // Blocking status or type of a tile has changed
+    // (see MapLevelBase::LayoutVersion).
+    //
+    void OnLayoutChanged();
+
+    void SyncTileObject(int index, GameObject* obj);
+};
+
+#endif // TILELAYER_H
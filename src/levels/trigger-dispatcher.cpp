@@ -0,0 +1,260 @@
+#include "trigger-dispatcher.h"
+
+#include "game-object.h"
+
+#include <algorithm>
+
+void TriggerDispatcher::Init(const Position& mapSize)
+{
+  _mapSize = mapSize;
+
+  Clear();
+}
+
+// =============================================================================
+
+void TriggerDispatcher::Clear()
+{
+  for (auto& list : _byType)
+  {
+    list.clear();
+  }
+
+  _byCell.clear();
+  _byTurn.clear();
+
+  _posted.clear();
+}
+
+// =============================================================================
+
+TriggerComponent* TriggerDispatcher::GetTrigger(GameObject* trigger)
+{
+  return (trigger != nullptr)
+         ? trigger->GetComponent<TriggerComponent>()
+         : nullptr;
+}
+
+// =============================================================================
+
+int TriggerDispatcher::CellKey(const Position& cell)
+{
+  return cell.Y * _mapSize.X + cell.X;
+}
+
+// =============================================================================
+
+void TriggerDispatcher::Subscribe(GameObject* trigger, TriggerEventType type)
+{
+  TriggerComponent* tc = GetTrigger(trigger);
+  if (tc == nullptr)
+  {
+    return;
+  }
+
+  switch (type)
+  {
+    //
+    // These need to know what to subscribe to.
+    //
+    case TriggerEventType::CELL_ENTERED:
+    case TriggerEventType::TURN_REACHED:
+    case TriggerEventType::LAST_ELEMENT:
+      break;
+
+    default:
+      _byType[(size_t)type].push_back(tc);
+      break;
+  }
+}
+
+// =============================================================================
+
+void TriggerDispatcher::SubscribeCell(GameObject* trigger,
+                                      const Position& cell)
+{
+  TriggerComponent* tc = GetTrigger(trigger);
+  if (tc != nullptr)
+  {
+    _byCell[CellKey(cell)].push_back(tc);
+  }
+}
+
+// =============================================================================
+
+void TriggerDispatcher::SubscribeTurn(GameObject* trigger, uint64_t turn)
+{
+  TriggerComponent* tc = GetTrigger(trigger);
+  if (tc != nullptr)
+  {
+    _byTurn[turn].push_back(tc);
+  }
+}
+
+// =============================================================================
+
+void TriggerDispatcher::EraseDestroyed(TriggersList& list)
+{
+  auto newEnd = std::remove_if(list.begin(),
+                               list.end(),
+  [](TriggerComponent* tc)
+  {
+    return tc->OwnerGameObject->IsDestroyed;
+  });
+
+  list.erase(newEnd, list.end());
+}
+
+// =============================================================================
+
+bool TriggerDispatcher::RemoveDestroyed()
+{
+  if (IsDispatching())
+  {
+    return false;
+  }
+
+  for (auto& list : _byType)
+  {
+    EraseDestroyed(list);
+  }
+
+  for (auto it = _byCell.begin(); it != _byCell.end(); )
+  {
+    EraseDestroyed(it->second);
+    it = it->second.empty() ? _byCell.erase(it) : std::next(it);
+  }
+
+  for (auto it = _byTurn.begin(); it != _byTurn.end(); )
+  {
+    EraseDestroyed(it->second);
+    it = it->second.empty() ? _byTurn.erase(it) : std::next(it);
+  }
+
+  return true;
+}
+
+// =============================================================================
+
+bool TriggerDispatcher::IsDispatching()
+{
+  return (_firingDepth != 0);
+}
+
+// =============================================================================
+
+void TriggerDispatcher::FireAll(TriggersList& list, const TriggerEvent& e)
+{
+  //
+  // Handler may create new triggers, they'll have to wait
+  // for the next event. Index, because list may be reallocated.
+  // Nothing is erased from the list while handlers run
+  // (see RemoveDestroyed()), so it can only grow.
+  //
+  size_t count = list.size();
+
+  _firingDepth++;
+
+  for (size_t i = 0; i < count; i++)
+  {
+    TriggerComponent* tc = list[i];
+    if (!tc->OwnerGameObject->IsDestroyed)
+    {
+      tc->Fire(e);
+    }
+  }
+
+  _firingDepth--;
+}
+
+// =============================================================================
+
+void TriggerDispatcher::Dispatch(const TriggerEvent& e)
+{
+  switch (e.Type)
+  {
+    case TriggerEventType::CELL_ENTERED:
+    {
+      auto it = _byCell.find(CellKey(e.Pos));
+      if (it != _byCell.end())
+      {
+        FireAll(it->second, e);
+      }
+    }
+    break;
+
+    case TriggerEventType::TURN_REACHED:
+    {
+      while (!_byTurn.empty() && _byTurn.begin()->first <= e.Turn)
+      {
+        TriggersList list = std::move(_byTurn.begin()->second);
+        _byTurn.erase(_byTurn.begin());
+
+        FireAll(list, e);
+      }
+    }
+    break;
+
+    case TriggerEventType::LAST_ELEMENT:
+      break;
+
+    default:
+      FireAll(_byType[(size_t)e.Type], e);
+      break;
+  }
+}
+
+// =============================================================================
+
+void TriggerDispatcher::Post(const TriggerEvent& e)
+{
+  if (HasSubscribers(e.Type))
+  {
+    _posted.push_back(e);
+  }
+}
+
+// =============================================================================
+
+void TriggerDispatcher::DispatchPosted()
+{
+  //
+  // Already dispatching further up the stack.
+  //
+  if (_posted.empty() || !_dispatching.empty())
+  {
+    return;
+  }
+
+  //
+  // Handlers may post new events.
+  //
+  _dispatching.swap(_posted);
+
+  for (auto& e : _dispatching)
+  {
+    Dispatch(e);
+  }
+
+  _dispatching.clear();
+}
+
+// =============================================================================
+
+bool TriggerDispatcher::HasSubscribers(TriggerEventType type)
+{
+  switch (type)
+  {
+    case TriggerEventType::CELL_ENTERED:
+      return !_byCell.empty();
+
+    case TriggerEventType::TURN_REACHED:
+      return !_byTurn.empty();
+
+    case TriggerEventType::LAST_ELEMENT:
+      return false;
+
+    default:
+      return !_byType[(size_t)type].empty();
+  }
+}
@@ -0,0 +1,105 @@
+#ifndef TRIGGERDISPATCHER_H
+#define TRIGGERDISPATCHER_H
+
+#include <array>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <cstdint>
+
+#include "trigger-component.h"
+
+class GameObject;
+
+//
+// Keeps triggers of the level grouped by event they're subscribed to,
+// so that only those are checked when event happens
+// instead of every trigger after every actor's turn.
+// Triggers are indexed by cell for CELL_ENTERED
+// and by turn number for TURN_REACHED.
+//
+// Like OccupancyIndex, dispatcher doesn't own anything,
+// triggers are owned by MapLevelBase::Triggers.
+//
+class TriggerDispatcher
+{
+  public:
+    void Init(const Position& mapSize);
+
+    //
+    // Doesn't touch subscribed triggers,
+    // so can be called after they were destroyed.
+    //
+    void Clear();
+
+    void Subscribe(GameObject* trigger, TriggerEventType type);
+    void SubscribeCell(GameObject* trigger, const Position& cell);
+
+    //
+    // Trigger is checked once when turn is reached.
+    //
+    void SubscribeTurn(GameObject* trigger, uint64_t turn);
+
+    //
+    // Must be called before destroyed triggers are deleted.
+    // Returns false and doesn't remove anything if called
+    // from inside of a handler, since lists are being iterated
+    // (see IsDispatching()).
+    //
+    bool RemoveDestroyed();
+
+    //
+    // True while handlers are running.
+    // Destroyed triggers must not be deleted meanwhile,
+    // FireAll() skips them and they're removed next time.
+    //
+    bool IsDispatching();
+
+    //
+    // Checks triggers subscribed to this event right away.
+    //
+    void Dispatch(const TriggerEvent& e);
+
+    //
+    // Movement happens in the middle of actor's turn,
+    // so such events are queued until DispatchPosted()
+    // (see Map::DispatchTriggerEvent()) to not let handlers
+    // change the map under the feet of whoever is moving.
+    // Events nobody is subscribed to are not queued.
+    //
+    void Post(const TriggerEvent& e);
+    void DispatchPosted();
+
+    bool HasSubscribers(TriggerEventType type);
+
+  private:
+    using TriggersList = std::vector<TriggerComponent*>;
+
+    //
+    // Events that aren't indexed.
+    //
+    std::array<TriggersList,
+               (size_t)TriggerEventType::LAST_ELEMENT> _byType;
+
+    std::unordered_map<int, TriggersList> _byCell;
+    std::map<uint64_t, TriggersList> _byTurn;
+
+    std::vector<TriggerEvent> _posted;
+    std::vector<TriggerEvent> _dispatching;
+
+    Position _mapSize;
+
+    //
+    // Handlers can dispatch events too.
+    //
+    int _firingDepth = 0;
+
+    TriggerComponent* GetTrigger(GameObject* trigger);
+
+    int CellKey(const Position& cell);
+
+    void FireAll(TriggersList& list, const TriggerEvent& e);
+    void EraseDestroyed(TriggersList& list);
+};
+
+#endif // TRIGGERDISPATCHER_H
@@ -0,0 +1,149 @@
+#include "update-list.h"
+
+#include "game-object.h"
+
+#include <algorithm>
+
+void UpdateList::Clear()
+{
+  _objects.clear();
+  _hasRemoved = false;
+}
+
+// =============================================================================
+
+void UpdateList::Add(GameObject* go)
+{
+  if (go == nullptr)
+  {
+    return;
+  }
+
+  go->_updateList = this;
+
+  if (go->_tickingComponents != 0)
+  {
+    _objects.push_back(go);
+  }
+}
+
+// =============================================================================
+
+void UpdateList::Remove(GameObject* go)
+{
+  if (go == nullptr || go->_updateList != this)
+  {
+    return;
+  }
+
+  go->_updateList = nullptr;
+
+  auto it = std::find(_objects.begin(), _objects.end(), go);
+  if (it == _objects.end())
+  {
+    return;
+  }
+
+  if (_updating)
+  {
+    *it = nullptr;
+    _hasRemoved = true;
+  }
+  else
+  {
+    _objects.erase(it);
+  }
+}
+
+// =============================================================================
+
+void UpdateList::OnTickingComponentAdded(GameObject* go)
+{
+  if (std::find(_objects.begin(), _objects.end(), go) == _objects.end())
+  {
+    _objects.push_back(go);
+  }
+}
+
+// =============================================================================
+
+void UpdateList::Update()
+{
+  _updating = true;
+
+  //
+  // Update() can place new objects, so size is checked every time.
+  //
+  for (size_t i = 0; i < _objects.size(); i++)
+  {
+    GameObject* go = _objects[i];
+    if (go != nullptr)
+    {
+      go->Update();
+    }
+  }
+
+  _updating = false;
+
+  Compact();
+}
+
+// =============================================================================
+
+void UpdateList::Compact()
+{
+  if (!_hasRemoved)
+  {
+    return;
+  }
+
+  _objects.erase(std::remove(_objects.begin(), _objects.end(), nullptr),
+                 _objects.end());
+
+  _hasRemoved = false;
+}
+
+// =============================================================================
+
+int UpdateList::GetIdleTicks()
+{
+  int res = Component::kUnlimitedIdleTicks;
+
+  for (GameObject* go : _objects)
+  {
+    if (go == nullptr)
+    {
+      continue;
+    }
+
+    res = std::min(res, go->GetIdleTicks());
+
+    if (res == 0)
+    {
+      return 0;
+    }
+  }
+
+  return res;
+}
+
+// =============================================================================
+
+void UpdateList::SkipTicks(int ticks)
+{
+  for (GameObject* go : _objects)
+  {
+    if (go != nullptr)
+    {
+      go->SkipTicks(ticks);
+    }
+  }
+}
+
+// =============================================================================
+
+size_t UpdateList::Count()
+{
+  return std::count_if(_objects.begin(), _objects.end(),
+                       [](GameObject* go) { return (go != nullptr); });
+}
@@ -0,0 +1,66 @@
+#ifndef UPDATELIST_H
+#define UPDATELIST_H
+
+#include <vector>
+#include <cstddef>
+
+
+class GameObject;
+
+//
+// Most of the objects in MapLevelBase::GameObjects are items and remains
+// lying on the floor, whose components do nothing in Update().
+// Only objects that have components that need it
+// (see Component::IsTicking()) are kept here,
+// and only they are visited by Map::UpdateGameObjects().
+//
+// Like OccupancyIndex, list doesn't own anything: whoever adds or removes
+// objects from the collection must do the same here.
+// Object that is already in the list and gets its first ticking component
+// is registered automatically (see GameObject::AddComponent()).
+//
+class UpdateList
+{
+  public:
+    //
+    // Doesn't touch registered objects,
+    // so can be called after they were destroyed.
+    //
+    void Clear();
+
+    void Add(GameObject* go);
+    void Remove(GameObject* go);
+
+    void OnTickingComponentAdded(GameObject* go);
+
+    //
+    // Calls GameObject::Update() in the order objects became ticking,
+    // so just like before every object updates all of its components
+    // before the next one does.
+    // Objects added during the pass are updated in it as well,
+    // removed ones are not updated anymore.
+    //
+    void Update();
+
+    //
+    // See Map::SkipIdleTicks().
+    //
+    int GetIdleTicks();
+    void SkipTicks(int ticks);
+
+    size_t Count();
+
+  private:
+    //
+    // Objects removed during Update() are replaced with nullptr
+    // and erased after the pass, so that indices don't shift under it.
+    //
+    std::vector<GameObject*> _objects;
+
+    bool _updating   = false;
+    bool _hasRemoved = false;
+
+    void Compact();
+};
+
+#endif // UPDATELIST_H
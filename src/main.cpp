@@ -1,6 +1,8 @@
 #include "gid-generator.h"
+#include "game-objects-registry.h"
 #include "application.h"
 #include "bts-decompiler.h"
+#include "bts-blueprints.h"
 #include "spells-processor.h"
 #include "game-objects-factory.h"
 #include "monsters-inc.h"
@@ -11,10 +13,10 @@
 #include "rng.h"
 #include "blackboard.h"
 #include "timer.h"
+#include "animation-timeline.h"
+#include "profiler.h"
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
 //
 // NOTE: When building with SDL2 in Windows,
@@ -52,20 +54,20 @@
 int main(int argc, char* argv[])
 {
   GID::Instance().Init();
+  GameObjectsRegistry::Instance().Init();
   RNG::Instance().Init();
   Blackboard::Instance().Init();
   Timer::Instance().Init();
+  Profiler::Instance().Init();
+  AnimationTimeline::Instance().Init();
 
-#ifdef DEBUG_BUILD
+  //
+  // Log file is opened once config is loaded (see Application::LoadConfig()).
+  //
   Logger::Instance().Init();
-  Logger::Instance().Prepare(true);
-
-  auto str = Util::StringFormat("World seed is 0x%lX", RNG::Instance().Seed);
-  DebugLog("%s\n\n", str.data());
-  LogPrint(str);
-#endif
 
   BTSDecompiler::Instance().Init();
+  BTSBlueprints::Instance().Init();
 
   Application::Instance().Init();
 
@@ -76,6 +78,10 @@ int main(int argc, char* argv[])
     return 1;
   }
 
+  auto str = Util::StringFormat("World seed is 0x%lX", RNG::Instance().Seed);
+  DebugLog("%s\n\n", str.data());
+  LogPrint(str);
+
   GameObjectsFactory::Instance().Init();
   ItemsFactory::Instance().Init();
   MonstersInc::Instance().Init();
@@ -0,0 +1,183 @@
+#include "animation-timeline.h"
+
+#include "application.h"
+#include "printer.h"
+#include "map.h"
+#include "map-level-base.h"
+#include "timer.h"
+
+#include <algorithm>
+
+#ifndef USE_SDL
+#include <ncurses.h>
+#else
+#include <SDL2/SDL.h>
+#endif
+
+void AnimationTimeline::InitSpecific()
+{
+}
+
+// =============================================================================
+
+void AnimationTimeline::AddTrack(const AnimationTrack& track)
+{
+  if (!track.empty())
+  {
+    _tracks.push_back(track);
+  }
+}
+
+// =============================================================================
+
+void AnimationTimeline::Clear()
+{
+  _tracks.clear();
+}
+
+// =============================================================================
+
+bool AnimationTimeline::HasTracks()
+{
+  return !_tracks.empty();
+}
+
+// =============================================================================
+
+void AnimationTimeline::Play()
+{
+  if (_tracks.empty())
+  {
+    return;
+  }
+
+  //
+  // Keys were pressed while the turn was being processed.
+  //
+  if (WaitForInput(0))
+  {
+    Clear();
+    return;
+  }
+
+  //
+  // Current state is drawn only once,
+  // every animation frame is drawn over the copy of it.
+  //
+  Application::Instance().ForceDrawCurrentState();
+  Printer::Instance().SaveFrame();
+
+  //
+  // Frames of all tracks one after another.
+  //
+  std::vector<const AnimationFrame*> frames;
+
+  for (auto& track : _tracks)
+  {
+    for (auto& frame : track)
+    {
+      frames.push_back(&frame);
+    }
+  }
+
+  auto start = Clock::now();
+
+  uint64_t frameEndMs = 0;
+
+  for (auto& frame : frames)
+  {
+    frameEndMs += frame->DurationMs;
+
+    uint64_t elapsedMs = FT::duration_cast<Ms>(Clock::now() - start).count();
+
+    //
+    // If we're late (e.g. frames are shorter than minimal frame time),
+    // frame is skipped altogether.
+    //
+    if (elapsedMs >= frameEndMs)
+    {
+      continue;
+    }
+
+    Printer::Instance().RestoreFrame();
+
+    DrawFrame(*frame);
+
+    uint64_t waitMs = std::max(frameEndMs - elapsedMs,
+                               (uint64_t)kMinFrameTimeMs);
+
+    if (WaitForInput(waitMs))
+    {
+      break;
+    }
+  }
+
+  Printer::Instance().RestoreFrame();
+  Printer::Instance().Render();
+
+  Clear();
+}
+
+// =============================================================================
+
+void AnimationTimeline::DrawFrame(const AnimationFrame& frame)
+{
+  auto& curLvl = Map::Instance().CurrentLevel;
+
+  for (auto& c : frame.Cells)
+  {
+    Printer::Instance().PrintFB(c.Pos.X + curLvl->MapOffsetX,
+                                c.Pos.Y + curLvl->MapOffsetY,
+                                c.Image,
+                                c.FgColor,
+                                c.BgColor);
+  }
+
+  Printer::Instance().Render();
+}
+
+// =============================================================================
+
+bool AnimationTimeline::WaitForInput(uint32_t timeoutMs)
+{
+#ifndef USE_SDL
+  //
+  // Key is put back for GameState::GetKeyDown() to read it.
+  //
+  timeout(timeoutMs);
+
+  int ch = getch();
+  if (ch != ERR)
+  {
+    ungetch(ch);
+    return true;
+  }
+
+  return false;
+#else
+  if (timeoutMs != 0)
+  {
+    auto start = Clock::now();
+
+    //
+    // Any event wakes us up, but only key presses interrupt animation.
+    //
+    uint64_t elapsedMs = 0;
+    while (elapsedMs < timeoutMs)
+    {
+      SDL_WaitEventTimeout(nullptr, timeoutMs - elapsedMs);
+
+      if (SDL_HasEvent(SDL_KEYDOWN) || SDL_HasEvent(SDL_QUIT))
+      {
+        return true;
+      }
+
+      elapsedMs = FT::duration_cast<Ms>(Clock::now() - start).count();
+    }
+  }
+
+  SDL_PumpEvents();
+
+  return (SDL_HasEvent(SDL_KEYDOWN) || SDL_HasEvent(SDL_QUIT));
+#endif
+}
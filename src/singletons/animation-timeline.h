@@ -0,0 +1,79 @@
+#ifndef ANIMATIONTIMELINE_H
+#define ANIMATIONTIMELINE_H
+
+#include <vector>
+#include <cstdint>
+
+#include "singleton.h"
+#include "position.h"
+
+struct AnimationCell
+{
+  //
+  // In map coordinates, map offset is applied during playback.
+  //
+  Position Pos;
+
+  int Image = ' ';
+
+  uint32_t FgColor = 0;
+  uint32_t BgColor = 0;
+};
+
+//
+// Cells drawn over the current frame for DurationMs.
+// Frame with no cells just shows the frame as it is.
+//
+struct AnimationFrame
+{
+  std::vector<AnimationCell> Cells;
+  uint32_t DurationMs = 0;
+};
+
+using AnimationTrack = std::vector<AnimationFrame>;
+
+//
+// Visual effects (attack flashes, explosions, projectiles)
+// used to be drawn right where they happened in game logic
+// with the whole game waiting for them to finish.
+// Now they are queued here and played one after another
+// over the already drawn frame before player is asked for input
+// (see Application::Run()), or right away by code that is about
+// to change what's on screen (see Application::DisplayAttack()).
+//
+class AnimationTimeline : public Singleton<AnimationTimeline>
+{
+  public:
+    void AddTrack(const AnimationTrack& track);
+
+    //
+    // Plays all queued tracks and clears the queue.
+    // Returns immediately if user presses something meanwhile,
+    // so that fast typists don't have to wait for effects.
+    //
+    void Play();
+
+    void Clear();
+
+    bool HasTracks();
+
+  protected:
+    void InitSpecific() override;
+
+  private:
+    //
+    // Screen is not redrawn more often than that.
+    //
+    const uint32_t kMinFrameTimeMs = 16;
+
+    std::vector<AnimationTrack> _tracks;
+
+    void DrawFrame(const AnimationFrame& frame);
+
+    //
+    // Returns true if there was some input during the wait.
+    //
+    bool WaitForInput(uint32_t timeoutMs);
+};
+
+#endif // ANIMATIONTIMELINE_H
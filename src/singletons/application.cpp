@@ -35,11 +35,13 @@
 #include "map.h"
 #include "map-level-base.h"
 #include "printer.h"
+#include "animation-timeline.h"
 #include "timer.h"
+#include "profiler.h"
 #include "util.h"
+#include "logger.h"
 
 #ifdef DEBUG_BUILD
-#include "logger.h"
 #include "dev-console.h"
 #endif
 
@@ -78,6 +80,7 @@ void Application::Run()
   while (_currentState != nullptr)
   {
     Timer::Instance().MeasureStart();
+    Profiler::Instance().BeginFrame();
 
     //
     // If player is not alive, it is assumed,
@@ -100,11 +103,22 @@ void Application::Run()
       // Also we need to immediately update changes that happened after
       // user pressed some keys that affected visual representation.
       //
+      // Visual effects queued during last turns are shown
+      // right before player gets control back.
+      //
+      AnimationTimeline::Instance().Play();
+
       if (_currentState != nullptr)
       {
         _currentState->Update();
       }
 
+      //
+      // HandleInput() blocks until player presses something,
+      // waiting for that is not a part of the frame.
+      //
+      Profiler::Instance().EndFrame();
+
       if (_currentState != nullptr)
       {
         _currentState->HandleInput();
@@ -119,37 +133,30 @@ void Application::Run()
       //
       if (CurrentStateIs(GameStates::MESSAGE_BOX_STATE))
       {
+        Profiler::Instance().EndFrame();
         _currentState->HandleInput();
       }
       else
       {
-        Map::Instance().Update();
-        PlayerInstance.WaitForTurn();
-
-        MapUpdateCyclesPassed++;
-      }
-    }
+        int skipped = Map::Instance().SkipIdleTicks();
 
-    Timer::Instance().MeasureEnd();
-
-    #ifdef DEBUG_BUILD
-    auto report = Timer::Instance().GetProfilingReport();
+        MapUpdateCyclesPassed += skipped;
 
-    if (!report.empty())
-    {
-      Logger::Instance().Print("=== PROFILER START ===");
-    }
+        //
+        // Player might have got his turn during skipped cycles.
+        //
+        if (skipped == 0 || !PlayerInstance.CanAct())
+        {
+          Map::Instance().Update();
+          PlayerInstance.WaitForTurn();
 
-    for (auto& line : report)
-    {
-      Logger::Instance().Print(line);
+          MapUpdateCyclesPassed++;
+        }
+      }
     }
 
-    if (!report.empty())
-    {
-      Logger::Instance().Print("=== PROFILER END ===");
-    }
-    #endif
+    Profiler::Instance().EndFrame();
+    Timer::Instance().MeasureEnd();
   }
 }
 
@@ -280,54 +287,56 @@ void Application::DisplayAttack(GameObject* defender,
   }
   else
   {
-    int posX = defender->PosX + Map::Instance().CurrentLevel->MapOffsetX;
-    int posY = defender->PosY + Map::Instance().CurrentLevel->MapOffsetY;
+    //
+    // Cursor flash first, then defender as it was at the moment of attack.
+    //
+    AnimationCell defenderCell =
+    {
+      defender->GetPosition(),
+      defender->Image,
+      defender->FgColor,
+      defender->BgColor
+    };
 
-    DrawAttackCursor(posX, posY, defender, cursorColor);
+    bool drawDefender = (defender->FgColor != Colors::None
+                      && defender->BgColor != Colors::None);
 
-    Util::Sleep(delayMs);
+    AnimationFrame cursor;
+    AnimationFrame still;
 
-    if (messageToPrint.length() != 0)
+    cursor.DurationMs = delayMs;
+    still.DurationMs  = delayMs;
+
+    if (cursorColor != Colors::None)
     {
-      Printer::Instance().AddMessage(messageToPrint);
+      cursor.Cells.push_back({ defender->GetPosition(),
+                               ' ',
+                               Colors::BlackColor,
+                               cursorColor });
+    }
+    else if (drawDefender)
+    {
+      cursor.Cells.push_back(defenderCell);
     }
 
-    DrawAttackCursor(posX, posY, defender);
+    if (drawDefender)
+    {
+      still.Cells.push_back(defenderCell);
+    }
 
-    Util::Sleep(delayMs);
-  }
-}
+    AnimationTimeline::Instance().AddTrack({ cursor, still });
 
-// =============================================================================
+    //
+    // Attack must be shown before its consequences
+    // (damage, death, knockback) get applied and drawn.
+    //
+    AnimationTimeline::Instance().Play();
 
-void Application::DrawAttackCursor(int x, int y,
-                                   GameObject* defender,
-                                   const uint32_t& cursorColor)
-{
-  if (cursorColor == Colors::None)
-  {
-    if (defender->FgColor != Colors::None
-     && defender->BgColor != Colors::None)
+    if (messageToPrint.length() != 0)
     {
-      Printer::Instance().PrintFB(x,
-                                  y,
-                                  defender->Image,
-                                  defender->FgColor,
-                                  defender->BgColor);
-
-      Printer::Instance().Render();
+      Printer::Instance().AddMessage(messageToPrint);
     }
   }
-  else
-  {
-    Printer::Instance().PrintFB(x,
-                                y,
-                                ' ',
-                                Colors::BlackColor,
-                                cursorColor);
-
-    Printer::Instance().Render();
-  }
 }
 
 // =============================================================================
@@ -540,20 +549,20 @@ void Application::SaveMapAroundPlayer(std::stringstream& ss, bool wasKilled)
       {
         char ch = ' ';
 
-        bool isVisibleOrRevealed = (curLvl->MapArray[x][y]->Visible
-                                 || curLvl->MapArray[x][y]->Revealed);
+        bool isVisibleOrRevealed = (curLvl->Tiles.IsVisible(x, y)
+                                 || curLvl->Tiles.IsRevealed(x, y));
 
         bool isPlayer = (x == px && y == py);
 
         if (isVisibleOrRevealed)
         {
-          ch = curLvl->MapArray[x][y]->Image;
+          ch = curLvl->Tiles.GetImage(x, y);
 
           //
           // If walls are ' ', display them as '#'
           //
-          if (curLvl->MapArray[x][y]->Blocking
-           && curLvl->MapArray[x][y]->BlocksSight
+          if (curLvl->Tiles.IsBlocking(x, y)
+           && curLvl->Tiles.IsBlockingSight(x, y)
            && ch == ' ')
           {
             ch = '#';
@@ -743,7 +752,7 @@ bool Application::InitGraphics()
 bool Application::InitCurses()
 {
   initscr();
-  nodelay(stdscr, true);     // non-blocking getch()
+  nodelay(stdscr, true);     // getch() timeout is set by current state
   keypad(stdscr, true);      // enable numpad
   noecho();
   curs_set(false);
@@ -1004,9 +1013,54 @@ void Application::LoadConfig()
 
       GameConfig.FastMonsterMovement =
           (_loadedConfig[kConfigKeyFastMonsterMovement].GetString() != "0");
+
+      //
+      // Older configs don't have this key.
+      //
+      if (_loadedConfig.Has(kConfigKeyProfiler))
+      {
+        GameConfig.Profiler =
+            (_loadedConfig[kConfigKeyProfiler].GetString() != "0");
+      }
+
+      Profiler::Instance().SetEnabled(GameConfig.Profiler);
+
+      if (_loadedConfig.Has(kConfigKeyLogging))
+      {
+        GameConfig.Logging =
+            (_loadedConfig[kConfigKeyLogging].GetString() != "0");
+      }
     }
     break;
   }
+
+  Logger::Instance().Prepare(GameConfig.Logging);
+}
+
+// =============================================================================
+
+void Application::DumpProfilerData()
+{
+  Profiler& p = Profiler::Instance();
+
+  if (!p.WriteChromeTrace(kProfilerTraceFilename))
+  {
+    ConsoleLog("Couldn't write %s!", kProfilerTraceFilename.data());
+  }
+
+  if (!p.WriteFoldedStacks(kProfilerFoldedFilename))
+  {
+    ConsoleLog("Couldn't write %s!", kProfilerFoldedFilename.data());
+  }
+
+  LogPrint("=== PROFILER START ===");
+
+  for (auto& line : p.GetReport())
+  {
+    LogPrint(line);
+  }
+
+  LogPrint("=== PROFILER END ===");
 }
 
 // =============================================================================
@@ -1029,8 +1083,15 @@ void Application::Cleanup()
 
   _gameStates.clear();
 
+  if (GameConfig.Profiler)
+  {
+    DumpProfilerData();
+  }
+
   LogPrint("Application::Cleanup()");
 
+  Logger::Instance().Flush();
+
   ConsoleLog("Goodbye!\n");
 }
 
@@ -64,6 +64,17 @@ class Application : public Singleton<Application>
       //
       bool FastMonsterMovement = false;
 
+      //
+      // Records timings of profiled zones (see profiler.h)
+      // and writes them to files on exit.
+      //
+      bool Profiler = false;
+
+      //
+      // Writes log file (see logger.h).
+      //
+      bool Logging = true;
+
       std::string TilesetFilename;
     };
 
@@ -117,14 +128,12 @@ class Application : public Singleton<Application>
 
     void LoadConfig();
 
+    void DumpProfilerData();
+
     bool InitGraphics();
 
     void InitGameStates(bool restart = false);
 
-    void DrawAttackCursor(int x, int y,
-                          GameObject* defender,
-                          const uint32_t& cursorColor = Colors::None);
-
     void SavePrettyAlignedStatInfo(std::stringstream& ss);
     void SaveMapAroundPlayer(std::stringstream& ss, bool wasKilled);
 
@@ -166,6 +175,11 @@ class Application : public Singleton<Application>
     const std::string kConfigKeyScale               = "scale";
     const std::string kConfigKeyFastCombat          = "fast_combat";
     const std::string kConfigKeyFastMonsterMovement = "fast_monster_movement";
+    const std::string kConfigKeyProfiler            = "profiler";
+    const std::string kConfigKeyLogging             = "logging";
+
+    const std::string kProfilerTraceFilename  = "profile-trace.json";
+    const std::string kProfilerFoldedFilename = "profile-folded.txt";
 
     // =========================================================================
 
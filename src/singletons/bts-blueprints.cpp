@@ -0,0 +1,58 @@
+#include "bts-blueprints.h"
+
+#include "bts-decompiler.h"
+
+void BTSBlueprints::InitSpecific()
+{
+}
+
+// =============================================================================
+
+const BTSBlueprint& BTSBlueprints::Get(const std::string& script)
+{
+  auto it = _byScript.find(script);
+  if (it != _byScript.end())
+  {
+    return *it->second.get();
+  }
+
+  _parser.Init();
+  _parser.ParseFromString(script);
+  _parser.FormTree();
+
+  auto bp = std::make_unique<BTSBlueprint>(_parser.MakeBlueprint());
+
+  _parser.Reset();
+
+  auto& res = _byScript[script];
+  res = std::move(bp);
+
+  return *res.get();
+}
+
+// =============================================================================
+
+const BTSBlueprint& BTSBlueprints::Get(const std::vector<uint8_t>& bytecode)
+{
+  std::string key(bytecode.begin(), bytecode.end());
+
+  auto it = _byBytecode.find(key);
+  if (it != _byBytecode.end())
+  {
+    return *it->second;
+  }
+
+  const BTSBlueprint& res =
+      Get(BTSDecompiler::Instance().Decompile(bytecode));
+
+  _byBytecode[key] = &res;
+
+  return res;
+}
+
+// =============================================================================
+
+size_t BTSBlueprints::Size()
+{
+  return _byScript.size();
+}
@@ -0,0 +1,44 @@
+#ifndef BTSBLUEPRINTS_H
+#define BTSBLUEPRINTS_H
+
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+#include <string>
+
+#include "singleton.h"
+#include "bts-parser.h"
+
+//
+// Parsing behaviour tree script (and decompiling it beforehand)
+// is the same for every monster of the same type,
+// so it's done once per script and the result is kept here.
+// AIModelBase then only creates its own nodes from the blueprint.
+//
+// Blueprints are never removed, since nodes created from them
+// may keep pointers to ScriptNode data.
+//
+class BTSBlueprints : public Singleton<BTSBlueprints>
+{
+  public:
+    const BTSBlueprint& Get(const std::string& script);
+    const BTSBlueprint& Get(const std::vector<uint8_t>& bytecode);
+
+    size_t Size();
+
+  protected:
+    void InitSpecific() override;
+
+  private:
+    std::unordered_map<std::string, std::unique_ptr<BTSBlueprint>> _byScript;
+
+    //
+    // Bytecode stored as std::string for hashing.
+    //
+    std::unordered_map<std::string, const BTSBlueprint*> _byBytecode;
+
+    BTSParser _parser;
+};
+
+#endif // BTSBLUEPRINTS_H
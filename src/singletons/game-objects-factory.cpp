@@ -101,17 +101,27 @@ void GameObjectsFactory::CreateStairs(MapLevelBase* levelWhereCreate,
                                       int image,
                                       MapType leadsTo)
 {
-  auto tile = levelWhereCreate->MapArray[x][y].get();
+  auto& tiles = levelWhereCreate->Tiles;
+
+  GameObjectInfo t;
+  t.Set(tiles.IsBlocking(x, y),
+        tiles.IsBlockingSight(x, y),
+        image,
+        Colors::WhiteColor,
+        Colors::DoorHighlightColor,
+        (image == '>') ? "Stairs Down" : "Stairs Up",
+        tiles.GetFowName(x, y));
+
+  tiles.MakeTile(x, y, t, GameObjectType::STAIRS);
+
+  //
+  // Stairs need a component, so tile object is created for them.
+  //
+  auto tile = tiles.GetTileObject(x, y);
 
   auto c = tile->AddComponent<StairsComponent>();
   StairsComponent* stairs = static_cast<StairsComponent*>(c);
   stairs->LeadsTo = leadsTo;
-
-  tile->ObjectName = (image == '>') ? "Stairs Down" : "Stairs Up";
-  tile->FgColor = Colors::WhiteColor;
-  tile->BgColor = Colors::DoorHighlightColor;
-  tile->Image = image;
-  tile->Type = GameObjectType::STAIRS;
 }
 
 // =============================================================================
@@ -332,12 +342,12 @@ GameObject* GameObjectsFactory::CloneObject(GameObject* copyFrom)
   copy->Type             = copyFrom->Type;
   copy->IsLiving         = copyFrom->IsLiving;
 
-  copy->_activeEffects           = copyFrom->_activeEffects;
-  copy->_previousCell            = copyFrom->_previousCell;
-  copy->_currentCell             = copyFrom->_currentCell;
+  copy->_activeEffects           = copyFrom->GetActiveEffects();
   copy->_healthRegenTurnsCounter = copyFrom->_healthRegenTurnsCounter;
   copy->_manaRegenTurnsCounter   = copyFrom->_manaRegenTurnsCounter;
 
+  copy->RebuildEffectsIndex();
+
   return copy;
 }
 
@@ -425,12 +435,87 @@ GameObjectsFactory::CreateBreakableObjectWithRandomLoot(
 
 // =============================================================================
 
+GameObject* GameObjectsFactory::CreateTriggerObject(
+    TriggerType triggerType,
+    const TriggerCondition& condition,
+    const TriggerHandler& handler)
+{
+  GameObject* triggerObject = new GameObject(Map::Instance().CurrentLevel);
+  triggerObject->AttachTrigger(triggerType, condition, handler);
+  return triggerObject;
+}
+
+// =============================================================================
+
+void GameObjectsFactory::CreateTrigger(TriggerType triggerType,
+                                       TriggerEventType eventType,
+                                       const TriggerCondition& condition,
+                                       const TriggerHandler& handler)
+{
+  GameObject* triggerObject = CreateTriggerObject(triggerType,
+                                                  condition,
+                                                  handler);
+
+  Map::Instance().CurrentLevel->PlaceTrigger(triggerObject, eventType);
+}
+
+// =============================================================================
+
+void GameObjectsFactory::CreateCellTrigger(TriggerType triggerType,
+                                           const Position& cell,
+                                           const TriggerCondition& condition,
+                                           const TriggerHandler& handler)
+{
+  GameObject* triggerObject = CreateTriggerObject(triggerType,
+                                                  condition,
+                                                  handler);
+
+  Map::Instance().CurrentLevel->PlaceTrigger(triggerObject, cell);
+}
+
+// =============================================================================
+
+void GameObjectsFactory::CreateTurnTrigger(TriggerType triggerType,
+                                           uint64_t turn,
+                                           const TriggerCondition& condition,
+                                           const TriggerHandler& handler)
+{
+  GameObject* triggerObject = CreateTriggerObject(triggerType,
+                                                  condition,
+                                                  handler);
+
+  Map::Instance().CurrentLevel->PlaceTurnTrigger(triggerObject, turn);
+}
+
+// =============================================================================
+
 void GameObjectsFactory::CreateTrigger(TriggerType triggerType,
                                        TriggerUpdateType updateType,
                                        const std::function<bool ()>& condition,
                                        const std::function<void ()>& handler)
 {
-  GameObject* triggerObject = new GameObject(Map::Instance().CurrentLevel);
-  triggerObject->AttachTrigger(triggerType, condition, handler);
+  TriggerCondition eventCondition;
+  TriggerHandler   eventHandler;
+
+  if (Util::IsFunctionValid(condition))
+  {
+    eventCondition = [condition](const TriggerEvent&)
+    {
+      return condition();
+    };
+  }
+
+  if (Util::IsFunctionValid(handler))
+  {
+    eventHandler = [handler](const TriggerEvent&)
+    {
+      handler();
+    };
+  }
+
+  GameObject* triggerObject = CreateTriggerObject(triggerType,
+                                                  eventCondition,
+                                                  eventHandler);
+
   Map::Instance().CurrentLevel->PlaceTrigger(triggerObject, updateType);
 }
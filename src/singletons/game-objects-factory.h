@@ -3,6 +3,7 @@
 
 #include "singleton.h"
 #include "constants.h"
+#include "trigger-component.h"
 
 class GameObjectInfo;
 class ItemComponent;
@@ -41,7 +42,32 @@ class GameObjectsFactory : public Singleton<GameObjectsFactory>
                                                     const uint32_t& bgColor);
 
     //
-    // Create invisible trigger object.
+    // Create invisible trigger object
+    // checked on event it's subscribed to (see TriggerDispatcher).
+    //
+    void CreateTrigger(TriggerType triggerType,
+                       TriggerEventType eventType,
+                       const TriggerCondition& condition,
+                       const TriggerHandler& handler);
+
+    //
+    // Checked when any actor steps on cell.
+    //
+    void CreateCellTrigger(TriggerType triggerType,
+                           const Position& cell,
+                           const TriggerCondition& condition,
+                           const TriggerHandler& handler);
+
+    //
+    // Checked once when Application::PlayerTurnsPassed reaches turn.
+    //
+    void CreateTurnTrigger(TriggerType triggerType,
+                           uint64_t turn,
+                           const TriggerCondition& condition,
+                           const TriggerHandler& handler);
+
+    //
+    // Old style trigger that doesn't care about event.
     //
     void CreateTrigger(TriggerType triggerType,
                        TriggerUpdateType updateType,
@@ -49,7 +75,7 @@ class GameObjectsFactory : public Singleton<GameObjectsFactory>
                        const std::function<void ()>& handler);
 
     //
-    // Creates stairs on MapArray of current level.
+    // Creates stairs on ground tiles of specified level.
     //
     void CreateStairs(MapLevelBase* levelWhereCreate,
                       int x,
@@ -98,6 +124,10 @@ class GameObjectsFactory : public Singleton<GameObjectsFactory>
     };
 
     // -------------------------------------------------------------------------
+
+    GameObject* CreateTriggerObject(TriggerType triggerType,
+                                    const TriggerCondition& condition,
+                                    const TriggerHandler& handler);
 };
 
 #endif // GAMEOBJECTSFACTORY_H
@@ -0,0 +1,137 @@
+#include "game-objects-registry.h"
+
+#include "game-object.h"
+
+bool GameObjectHandle::IsValid() const
+{
+  return (Index != kInvalidIndex);
+}
+
+// =============================================================================
+
+bool GameObjectHandle::operator== (const GameObjectHandle& rhs) const
+{
+  return (Index == rhs.Index && Generation == rhs.Generation);
+}
+
+// =============================================================================
+
+bool GameObjectHandle::operator!= (const GameObjectHandle& rhs) const
+{
+  return !(*this == rhs);
+}
+
+// =============================================================================
+
+void GameObjectsRegistry::InitSpecific()
+{
+  _slots.reserve(4096);
+  _freeSlots.reserve(1024);
+  _slotById.reserve(4096);
+}
+
+// =============================================================================
+
+GameObjectHandle GameObjectsRegistry::Register(GameObject* go)
+{
+  GameObjectHandle res;
+
+  if (go == nullptr)
+  {
+    return res;
+  }
+
+  if (_freeSlots.empty())
+  {
+    res.Index = (uint32_t)_slots.size();
+    _slots.emplace_back();
+  }
+  else
+  {
+    res.Index = _freeSlots.back();
+    _freeSlots.pop_back();
+  }
+
+  Slot& s = _slots[res.Index];
+
+  s.Object   = go;
+  s.ObjectId = go->ObjectId();
+
+  res.Generation = s.Generation;
+
+  _slotById[s.ObjectId] = res.Index;
+
+  return res;
+}
+
+// =============================================================================
+
+void GameObjectsRegistry::Release(const GameObjectHandle& handle)
+{
+  if (Get(handle) == nullptr)
+  {
+    return;
+  }
+
+  Slot& s = _slots[handle.Index];
+
+  auto it = _slotById.find(s.ObjectId);
+  if (it != _slotById.end() && it->second == handle.Index)
+  {
+    _slotById.erase(it);
+  }
+
+  s.Object   = nullptr;
+  s.ObjectId = 0;
+
+  //
+  // Invalidates all handles given out for this slot so far.
+  //
+  s.Generation++;
+
+  _freeSlots.push_back(handle.Index);
+}
+
+// =============================================================================
+
+GameObject* GameObjectsRegistry::Get(const GameObjectHandle& handle)
+{
+  if (handle.Index >= _slots.size())
+  {
+    return nullptr;
+  }
+
+  const Slot& s = _slots[handle.Index];
+
+  return (s.Generation == handle.Generation) ? s.Object : nullptr;
+}
+
+// =============================================================================
+
+GameObject* GameObjectsRegistry::FindById(uint64_t objId)
+{
+  return Get(GetHandle(objId));
+}
+
+// =============================================================================
+
+GameObjectHandle GameObjectsRegistry::GetHandle(uint64_t objId)
+{
+  GameObjectHandle res;
+
+  auto it = _slotById.find(objId);
+  if (it != _slotById.end())
+  {
+    res.Index      = it->second;
+    res.Generation = _slots[it->second].Generation;
+  }
+
+  return res;
+}
+
+// =============================================================================
+
+size_t GameObjectsRegistry::Count()
+{
+  return _slots.size() - _freeSlots.size();
+}
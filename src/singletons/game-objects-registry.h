@@ -0,0 +1,72 @@
+#ifndef GAMEOBJECTSREGISTRY_H
+#define GAMEOBJECTSREGISTRY_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+#include "singleton.h"
+
+class GameObject;
+
+//
+// Index of the slot in GameObjectsRegistry plus generation of the slot
+// at the time handle was given out, so that handle to destroyed object
+// doesn't start pointing to whoever got the slot after it.
+//
+struct GameObjectHandle
+{
+  static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+  uint32_t Index      = kInvalidIndex;
+  uint32_t Generation = 0;
+
+  bool IsValid() const;
+
+  bool operator== (const GameObjectHandle& rhs) const;
+  bool operator!= (const GameObjectHandle& rhs) const;
+};
+
+//
+// Every GameObject is registered here on creation
+// and released on destruction, so objects can be looked up
+// by handle or by ObjectId() without going through the levels.
+//
+// Must be initialized before anything that owns game objects
+// (see main.cpp), otherwise it may be gone by the time they're destroyed.
+//
+class GameObjectsRegistry : public Singleton<GameObjectsRegistry>
+{
+  public:
+    GameObjectHandle Register(GameObject* go);
+    void Release(const GameObjectHandle& handle);
+
+    //
+    // nullptr if object was destroyed.
+    //
+    GameObject* Get(const GameObjectHandle& handle);
+    GameObject* FindById(uint64_t objId);
+
+    GameObjectHandle GetHandle(uint64_t objId);
+
+    size_t Count();
+
+  protected:
+    void InitSpecific() override;
+
+  private:
+    struct Slot
+    {
+      GameObject* Object   = nullptr;
+      uint64_t    ObjectId = 0;
+      uint32_t Generation  = 0;
+    };
+
+    std::vector<Slot> _slots;
+    std::vector<uint32_t> _freeSlots;
+
+    std::unordered_map<uint64_t, uint32_t> _slotById;
+};
+
+#endif // GAMEOBJECTSREGISTRY_H
@@ -5,9 +5,7 @@
 #include "game-objects-factory.h"
 #include "printer.h"
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
 #include "item-component.h"
 #include "item-use-handlers.h"
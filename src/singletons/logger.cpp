@@ -1,6 +1,7 @@
 #include "logger.h"
 
-#include <ctime>
+#include <chrono>
+#include <cstdio>
 
 #include "util.h"
 
@@ -10,44 +11,219 @@ void Logger::InitSpecific()
 
 // =============================================================================
 
-void Logger::Prepare(bool enabled)
+void Logger::Prepare(bool enabled,
+                     uint32_t flushIntervalMs,
+                     size_t maxFileSizeBytes)
 {
-  _enabled = enabled;
+  if (_writer.joinable())
+  {
+    return;
+  }
+
+  _enabled         = enabled;
+  _flushIntervalMs = flushIntervalMs;
+  _maxFileSize     = maxFileSizeBytes;
 
   if (_enabled)
   {
-    _logFile.open("debug-log.txt");
+    _logFile.open(kLogFilename);
+    _fileSize = 0;
+
+    _writer = std::thread(&Logger::WriterLoop, this);
+
     Print("Log started");
   }
 }
 
 // =============================================================================
 
-void Logger::Print(const std::string &stringToPrint, bool error)
+void Logger::Push(const std::string& stringToPrint, bool error)
 {
-  if (_enabled)
+  if (!_enabled)
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _queue.push_back({ time(nullptr), error, stringToPrint });
+    _recordsQueued++;
+  }
+
+  //
+  // Error must be on disk before we return,
+  // so it's not lost if we crash right after.
+  //
+  if (error)
+  {
+    Flush();
+  }
+}
+
+// =============================================================================
+
+void Logger::Flush()
+{
+  if (!_enabled)
+  {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(_mutex);
+
+  //
+  // Nobody is going to write it.
+  //
+  if (_stopRequested)
+  {
+    return;
+  }
+
+  uint64_t target = _recordsQueued;
+
+  _flushRequested = true;
+  _hasWork.notify_one();
+
+  _batchWritten.wait(lock, [this, target]()
   {
-    auto str = Util::GetCurrentDateTimeString();
-    _logFile << " --- " << str << " --- ";
+    return (_recordsWritten >= target);
+  });
+}
+
+// =============================================================================
+
+void Logger::WriterLoop()
+{
+  std::vector<Record> batch;
+
+  bool stop = false;
+
+  while (!stop)
+  {
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+
+      _hasWork.wait_for(lock,
+                        std::chrono::milliseconds(_flushIntervalMs),
+                        [this]()
+      {
+        return (_flushRequested || _stopRequested);
+      });
+
+      _flushRequested = false;
+
+      stop = _stopRequested;
+
+      batch.swap(_queue);
+    }
+
+    if (!batch.empty())
+    {
+      WriteBatch(batch);
+    }
 
-    if (error)
     {
-      _logFile << "!!! ERROR !!! ";
+      std::lock_guard<std::mutex> lock(_mutex);
+      _recordsWritten += batch.size();
     }
 
-    _logFile << stringToPrint << "\n";
+    _batchWritten.notify_all();
 
-    _logFile.flush();
+    batch.clear();
   }
 }
 
 // =============================================================================
 
+void Logger::WriteBatch(const std::vector<Record>& batch)
+{
+  for (auto& r : batch)
+  {
+    //
+    // Plenty of records share the same second.
+    //
+    if (r.Time != _lastTime || _lastTimeString.empty())
+    {
+      char buf[32];
+
+      tm* ltm = localtime(&r.Time);
+      strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", ltm);
+
+      _lastTime       = r.Time;
+      _lastTimeString = buf;
+    }
+
+    std::string line = " --- ";
+    line += _lastTimeString;
+    line += " --- ";
+
+    if (r.Error)
+    {
+      line += "!!! ERROR !!! ";
+    }
+
+    line += r.Text;
+    line += "\n";
+
+    _logFile << line;
+
+    _fileSize += line.length();
+
+    if (_maxFileSize != 0 && _fileSize >= _maxFileSize)
+    {
+      Rotate();
+    }
+  }
+
+  _logFile.flush();
+}
+
+// =============================================================================
+
+void Logger::Rotate()
+{
+  _logFile.close();
+
+  for (size_t i = kMaxRotatedFiles; i > 1; i--)
+  {
+    std::string from = Util::StringFormat(kRotatedFilenameFormat, i - 1);
+    std::string to   = Util::StringFormat(kRotatedFilenameFormat, i);
+
+    std::remove(to.data());
+    std::rename(from.data(), to.data());
+  }
+
+  std::string first = Util::StringFormat(kRotatedFilenameFormat, (size_t)1);
+
+  std::remove(first.data());
+  std::rename(kLogFilename.data(), first.data());
+
+  _logFile.open(kLogFilename);
+
+  _fileSize = 0;
+}
+
+// =============================================================================
+
 Logger::~Logger()
 {
-  if (_logFile.is_open())
+  if (_writer.joinable())
   {
     Print("Log ended");
+
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stopRequested = true;
+    }
+
+    _hasWork.notify_one();
+
+    _writer.join();
+  }
+
+  if (_logFile.is_open())
+  {
     _logFile.close();
   }
 }
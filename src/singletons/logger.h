@@ -3,32 +3,133 @@
 
 #include <fstream>
 #include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <ctime>
 
 #include "singleton.h"
 #include "util.h"
 
+//
+// Records below this level are thrown away right in Print()
+// which compiler can optimize out completely.
+// Set from cmake (-DLOGGER_MIN_LEVEL=...).
+//
+// 0 - everything
+// 1 - errors only (see LogPrint(str, true))
+// 2 - nothing
+//
+// Whatever is left can still be turned off at runtime
+// with "logging" config option (see Application::LoadConfig()).
+//
+#ifndef LOGGER_MIN_LEVEL
+#define LOGGER_MIN_LEVEL 0
+#endif
+
+//
+// Print() only puts record into the queue, it is written to file
+// in batches by background thread every flush interval.
+// Errors are the exception: Print() waits until they are written.
+// When log file grows past max size it's renamed to debug-log.1.txt
+// (older files are shifted further up to kMaxRotatedFiles)
+// and new one is started.
+//
 class Logger : public Singleton<Logger>
 {
   public:
     ~Logger() override;
 
-    void Prepare(bool enabled);
-    void Print(const std::string& stringToPrint, bool error = false);
+    void Prepare(bool enabled,
+                 uint32_t flushIntervalMs = 500,
+                 size_t maxFileSizeBytes = 4 * 1024 * 1024);
+
+    void Print(const std::string& stringToPrint, bool error = false)
+    {
+      if (LOGGER_MIN_LEVEL > 1 || (LOGGER_MIN_LEVEL > 0 && !error))
+      {
+        return;
+      }
+
+      Push(stringToPrint, error);
+    }
 
     template <typename ... Args>
     void Printf(const std::string& format, Args ... args)
     {
+      if (LOGGER_MIN_LEVEL > 0)
+      {
+        return;
+      }
+
       std::string str = Util::StringFormat(format, args ...);
       Print(str);
     }
 
+    //
+    // Blocks until everything queued so far is written to disk.
+    //
+    void Flush();
+
   protected:
     void InitSpecific() override;
 
   private:
+    struct Record
+    {
+      time_t Time = 0;
+      bool Error  = false;
+      std::string Text;
+    };
+
+    const std::string kLogFilename           = "debug-log.txt";
+    const std::string kRotatedFilenameFormat = "debug-log.%zu.txt";
+
+    static constexpr size_t kMaxRotatedFiles = 3;
+
     std::ofstream _logFile;
 
-    bool _enabled = true;
+    bool _enabled = false;
+
+    uint32_t _flushIntervalMs = 0;
+
+    size_t _maxFileSize = 0;
+    size_t _fileSize    = 0;
+
+    //
+    // Guards everything below.
+    //
+    std::mutex _mutex;
+
+    std::condition_variable _hasWork;
+    std::condition_variable _batchWritten;
+
+    //
+    // Writer thread swaps it with its own batch
+    // so that producers are never blocked by disk I/O.
+    //
+    std::vector<Record> _queue;
+
+    bool _flushRequested = false;
+    bool _stopRequested  = false;
+
+    uint64_t _recordsQueued  = 0;
+    uint64_t _recordsWritten = 0;
+
+    std::thread _writer;
+
+    //
+    // Writer thread only.
+    //
+    time_t _lastTime = 0;
+    std::string _lastTimeString;
+
+    void Push(const std::string& stringToPrint, bool error);
+
+    void WriterLoop();
+    void WriteBatch(const std::vector<Record>& batch);
+    void Rotate();
 };
 
 #endif
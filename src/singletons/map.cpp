@@ -2,6 +2,7 @@
 
 #include "application.h"
 #include "printer.h"
+#include "animation-timeline.h"
 #include "rng.h"
 #include "door-component.h"
 #include "game-objects-factory.h"
@@ -13,11 +14,10 @@
 #include "map-level-abyss.h"
 #include "map-level-nether.h"
 #include "map-level-endgame.h"
-#include "timer.h"
+#include "profiler.h"
+#include "game-objects-registry.h"
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
 #ifdef BUILD_TESTS
 #include "map-level-test.h"
@@ -60,6 +60,11 @@ void Map::Cleanup()
 
   _levels.clear();
 
+  //
+  // Waits for background jobs if there are any.
+  //
+  _pendingLevels.clear();
+
   LogPrint("Map::Cleanup()");
 }
 
@@ -67,17 +72,22 @@ void Map::Cleanup()
 
 void Map::Draw()
 {
-  Timer::Instance().StartProfiling("  DrawMapTilesAroundPlayer()");
-  DrawMapTilesAroundPlayer();
-  Timer::Instance().FinishProfiling("  DrawMapTilesAroundPlayer()");
+  PROFILE_ZONE(ProfilerZone::MAP_DRAW);
+
+  {
+    PROFILE_ZONE(ProfilerZone::DRAW_MAP_TILES);
+    DrawMapTilesAroundPlayer();
+  }
 
-  Timer::Instance().StartProfiling("  DrawGameObjects()");
-  DrawGameObjects();
-  Timer::Instance().FinishProfiling("  DrawGameObjects()");
+  {
+    PROFILE_ZONE(ProfilerZone::DRAW_GAME_OBJECTS);
+    DrawGameObjects();
+  }
 
-  Timer::Instance().StartProfiling("  DrawActors()");
-  DrawActors();
-  Timer::Instance().FinishProfiling("  DrawActors()");
+  {
+    PROFILE_ZONE(ProfilerZone::DRAW_ACTORS);
+    DrawActors();
+  }
 }
 
 // =============================================================================
@@ -118,19 +128,24 @@ void Map::Update()
     return;
   }
 
+  PROFILE_ZONE(ProfilerZone::MAP_UPDATE);
+
   CurrentLevel->TryToSpawnMonsters();
 
-  Timer::Instance().StartProfiling("  UpdateGameObjects()");
-  UpdateGameObjects();
-  Timer::Instance().FinishProfiling("  UpdateGameObjects()");
+  {
+    PROFILE_ZONE(ProfilerZone::UPDATE_GAME_OBJECTS);
+    UpdateGameObjects();
+  }
 
-  Timer::Instance().StartProfiling("  UpdateActors()");
-  UpdateActors();
-  Timer::Instance().FinishProfiling("  UpdateActors()");
+  {
+    PROFILE_ZONE(ProfilerZone::UPDATE_ACTORS);
+    UpdateActors();
+  }
 
-  Timer::Instance().StartProfiling("  UpdateTriggers(GLOBAL)");
-  UpdateTriggers(TriggerUpdateType::GLOBAL);
-  Timer::Instance().FinishProfiling("  UpdateTriggers(GLOBAL)");
+  {
+    PROFILE_ZONE(ProfilerZone::UPDATE_TRIGGERS);
+    DispatchTriggerEvent({ TriggerEventType::MAP_UPDATE });
+  }
 
   //
   // If enemy is killed via thorns damage,
@@ -139,19 +154,68 @@ void Map::Update()
   // or we will end up with object that is not alive,
   // but can still be attacked on player turn, killed and gained EXP for it.
   //
-  Timer::Instance().StartProfiling("  RemoveDestroyed()");
+  PROFILE_ZONE(ProfilerZone::REMOVE_DESTROYED);
   RemoveDestroyed();
-  Timer::Instance().FinishProfiling("  RemoveDestroyed()");
 }
 
 // =============================================================================
 
-void Map::UpdateGameObjects()
+int Map::SkipIdleTicks()
 {
-  for (auto& go : CurrentLevel->GameObjects)
+  if (CurrentLevel == nullptr
+   || CurrentLevel->Peaceful
+   || CurrentLevel->TriggersDispatcher.HasSubscribers(
+        TriggerEventType::MAP_UPDATE)
+   || !_playerRef->HasNonZeroHP()
+   || _playerRef->HasEffect(ItemBonusType::PARALYZE)
+   || _playerRef->HasEffect(ItemBonusType::BURNING))
   {
-    go->Update();
+    return 0;
+  }
+
+  //
+  // Player waits for turn after everyone else,
+  // so the tick where he becomes ready can be skipped as well.
+  //
+  int ticks = std::min({ _playerRef->TicksUntilReady(),
+                         _playerRef->GetEffectsIdleTicks(),
+                         CurrentLevel->GetIdleTicks() });
+
+  for (auto& go : CurrentLevel->ActorGameObjects)
+  {
+    if (ticks <= 0)
+    {
+      return 0;
+    }
+
+    ticks = std::min(ticks, go->GetIdleTicks());
   }
+
+  ticks = std::min(ticks, CurrentLevel->GameObjectsUpdateList.GetIdleTicks());
+
+  if (ticks <= 0)
+  {
+    return 0;
+  }
+
+  CurrentLevel->SkipTicks(ticks);
+  CurrentLevel->GameObjectsUpdateList.SkipTicks(ticks);
+
+  for (auto& go : CurrentLevel->ActorGameObjects)
+  {
+    go->SkipTicks(ticks);
+  }
+
+  _playerRef->SkipWaitingTicks(ticks);
+
+  return ticks;
+}
+
+// =============================================================================
+
+void Map::UpdateGameObjects()
+{
+  CurrentLevel->GameObjectsUpdateList.Update();
 }
 
 // =============================================================================
@@ -218,7 +282,7 @@ void Map::UpdateActors()
           // there are actors present in player's radius,
           // which aren't visible.
           //
-          if (IsObjectVisible(plPos, objPos))
+          if (IsVisibleFromPlayer(objPos.X, objPos.Y))
           {
             Application::Instance().ForceDrawMainState();
           }
@@ -234,27 +298,24 @@ void Map::UpdateActors()
 
 // =============================================================================
 
-void Map::UpdateTriggers(TriggerUpdateType updateType)
+void Map::DispatchTriggerEvent(const TriggerEvent& e)
 {
-  switch (updateType)
+  if (CurrentLevel == nullptr)
   {
-    case TriggerUpdateType::GLOBAL:
-    {
-      for (auto& i : CurrentLevel->GlobalTriggers)
-      {
-        i->Update();
-      }
-    }
-    break;
+    return;
+  }
 
-    case TriggerUpdateType::FINISH_TURN:
-    {
-      for (auto& i : CurrentLevel->FinishTurnTriggers)
-      {
-        i->Update();
-      }
-    }
-    break;
+  CurrentLevel->TriggersDispatcher.DispatchPosted();
+  CurrentLevel->TriggersDispatcher.Dispatch(e);
+}
+
+// =============================================================================
+
+void Map::PostTriggerEvent(const TriggerEvent& e)
+{
+  if (CurrentLevel != nullptr)
+  {
+    CurrentLevel->TriggersDispatcher.Post(e);
   }
 }
 
@@ -274,46 +335,25 @@ void Map::PlaceGameObject(GameObject* goToInsert)
 
 // =============================================================================
 
-std::pair<int, GameObject*> Map::GetGameObjectToPickup(int x, int y)
+GameObject* Map::GetGameObjectToPickup(int x, int y)
 {
-  std::pair<int, GameObject*> res;
-
-  res.first = -1;
-  res.second = nullptr;
-
-  int index = 0;
-  for (auto& go : CurrentLevel->GameObjects)
-  {
-    auto c = go->GetComponent<ItemComponent>();
-    if (c != nullptr && go.get()->PosX == x && go.get()->PosY == y)
-    {
-      res.first = index;
-      res.second = go.get();
-    }
-
-    index++;
-  }
+  auto items = GetGameObjectsToPickup(x, y);
 
-  return res;
+  return items.empty() ? nullptr : items.back();
 }
 
 // =============================================================================
 
-std::vector<std::pair<int, GameObject*>> Map::GetGameObjectsToPickup(int x,
-                                                                     int y)
+std::vector<GameObject*> Map::GetGameObjectsToPickup(int x, int y)
 {
-  std::vector<std::pair<int, GameObject*>> res;
+  std::vector<GameObject*> res;
 
-  int index = 0;
-  for (auto& go : CurrentLevel->GameObjects)
+  for (GameObject* go : CurrentLevel->GameObjectsIndex.Get(x, y))
   {
-    auto c = go->GetComponent<ItemComponent>();
-    if (c != nullptr && go.get()->PosX == x && go.get()->PosY == y)
+    if (go->GetComponent<ItemComponent>() != nullptr)
     {
-      res.push_back({ index, go.get() });
+      res.push_back(go);
     }
-
-    index++;
   }
 
   return res;
@@ -323,39 +363,22 @@ std::vector<std::pair<int, GameObject*>> Map::GetGameObjectsToPickup(int x,
 
 GameObject* Map::GetActorAtPosition(int x, int y)
 {
-  for (auto& go : CurrentLevel->ActorGameObjects)
-  {
-    if (go.get()->PosX == x && go.get()->PosY == y)
-    {
-      return go.get();
-    }
-  }
-
-  return nullptr;
+  auto& actors = CurrentLevel->ActorsIndex.Get(x, y);
+  return actors.empty() ? nullptr : actors.front();
 }
 
 // =============================================================================
 
 GameObject* Map::GetMapObjectAtPosition(int x, int y)
 {
-  return CurrentLevel->MapArray[x][y].get();
+  return CurrentLevel->Tiles.GetTileObject(x, y);
 }
 
 // =============================================================================
 
 std::vector<GameObject*> Map::GetGameObjectsAtPosition(int x, int y)
 {
-  std::vector<GameObject*> res;
-
-  for (auto& go : CurrentLevel->GameObjects)
-  {
-    if (go.get()->PosX == x && go.get()->PosY == y)
-    {
-      res.push_back(go.get());
-    }
-  }
-
-  return res;
+  return CurrentLevel->GameObjectsIndex.Get(x, y);
 }
 
 // =============================================================================
@@ -377,46 +400,60 @@ GameObject* Map::GetStaticGameObjectAtPosition(int x, int y)
 GameObject* Map::FindGameObjectById(const uint64_t& objId,
                                     GameObjectCollectionType collectionType)
 {
-  GameObject* res = nullptr;
+  GameObject* res = GameObjectsRegistry::Instance().FindById(objId);
+  if (res == nullptr)
+  {
+    return nullptr;
+  }
 
-  switch (collectionType)
+  //
+  // Registry knows about every object in the game (including other levels
+  // and player's inventory), so check that it belongs to what was asked.
+  //
+  if (collectionType != GameObjectCollectionType::ALL)
   {
-    case GameObjectCollectionType::MAP_ARRAY:
-      res = FindInVV(CurrentLevel->MapArray, objId);
-      break;
+    return IsInCollection(res, collectionType) ? res : nullptr;
+  }
 
-    case GameObjectCollectionType::STATIC_OBJECTS:
-      res = FindInVV(CurrentLevel->StaticMapObjects, objId);
-      break;
+  bool found = (IsInCollection(res, GameObjectCollectionType::ACTORS)
+             || IsInCollection(res, GameObjectCollectionType::GAME_OBJECTS)
+             || IsInCollection(res, GameObjectCollectionType::STATIC_OBJECTS)
+             || IsInCollection(res, GameObjectCollectionType::MAP_ARRAY));
 
-    case GameObjectCollectionType::GAME_OBJECTS:
-      res = FindInV(CurrentLevel->GameObjects, objId);
-      break;
+  return found ? res : nullptr;
+}
 
-    case GameObjectCollectionType::ACTORS:
-      res = FindInV(CurrentLevel->ActorGameObjects, objId);
-      break;
+// =============================================================================
 
-    case GameObjectCollectionType::ALL:
+bool Map::IsInCollection(GameObject* go, GameObjectCollectionType c)
+{
+  switch (c)
+  {
+    case GameObjectCollectionType::MAP_ARRAY:
+      return (CurrentLevel->Tiles.FindTileObject(go->PosX, go->PosY) == go);
+
+    case GameObjectCollectionType::STATIC_OBJECTS:
     {
-      res = FindInV(CurrentLevel->ActorGameObjects, objId);
-      if (res == nullptr)
+      if (go->PosX < 0 || go->PosX >= CurrentLevel->MapSize.X
+       || go->PosY < 0 || go->PosY >= CurrentLevel->MapSize.Y)
       {
-        res = FindInV(CurrentLevel->GameObjects, objId);
-        if (res == nullptr)
-        {
-          res = FindInVV(CurrentLevel->StaticMapObjects, objId);
-          if (res == nullptr)
-          {
-            res = FindInVV(CurrentLevel->MapArray, objId);
-          }
-        }
+        return false;
       }
+
+      return (CurrentLevel->StaticMapObjects[go->PosX][go->PosY].get() == go);
     }
-    break;
+
+    case GameObjectCollectionType::GAME_OBJECTS:
+      return CurrentLevel->GameObjectsIndex.Contains(go);
+
+    case GameObjectCollectionType::ACTORS:
+      return CurrentLevel->ActorsIndex.Contains(go);
+
+    default:
+      break;
   }
 
-  return res;
+  return false;
 }
 
 // =============================================================================
@@ -442,11 +479,14 @@ void Map::RemoveDestroyed(GameObjectCollectionType c)
       break;
 
     case GameObjectCollectionType::GAME_OBJECTS:
-      EraseFromCollection(CurrentLevel->GameObjects);
+      EraseFromCollection(CurrentLevel->GameObjects,
+                          CurrentLevel->GameObjectsIndex,
+                          &CurrentLevel->GameObjectsUpdateList);
       break;
 
     case GameObjectCollectionType::ACTORS:
-      EraseFromCollection(CurrentLevel->ActorGameObjects);
+      EraseFromCollection(CurrentLevel->ActorGameObjects,
+                          CurrentLevel->ActorsIndex);
       break;
 
     case GameObjectCollectionType::TRIGGERS:
@@ -455,8 +495,11 @@ void Map::RemoveDestroyed(GameObjectCollectionType c)
 
     case GameObjectCollectionType::ALL:
       RemoveStaticObjects();
-      EraseFromCollection(CurrentLevel->GameObjects);
-      EraseFromCollection(CurrentLevel->ActorGameObjects);
+      EraseFromCollection(CurrentLevel->GameObjects,
+                          CurrentLevel->GameObjectsIndex,
+                          &CurrentLevel->GameObjectsUpdateList);
+      EraseFromCollection(CurrentLevel->ActorGameObjects,
+                          CurrentLevel->ActorsIndex);
       RemoveTriggers();
       break;
   }
@@ -466,26 +509,30 @@ void Map::RemoveDestroyed(GameObjectCollectionType c)
 
 void Map::RemoveTriggers()
 {
-  auto RemoveFromCollecton =
-  [this](std::vector<std::unique_ptr<GameObject>>& collection)
+  //
+  // Called from trigger's handler, destroyed triggers
+  // will be deleted on the next call.
+  //
+  if (!CurrentLevel->TriggersDispatcher.RemoveDestroyed())
   {
-    auto newBegin = std::remove_if(collection.begin(),
-                                   collection.end(),
-    [this](const std::unique_ptr<GameObject>& go)
-    {
-      if (go != nullptr && go->IsDestroyed)
-      {
-        return true;
-      }
+    return;
+  }
 
-      return false;
-    });
+  auto& collection = CurrentLevel->Triggers;
 
-    collection.erase(newBegin, collection.end());
-  };
+  auto newBegin = std::remove_if(collection.begin(),
+                                 collection.end(),
+  [](const std::unique_ptr<GameObject>& go)
+  {
+    if (go != nullptr && go->IsDestroyed)
+    {
+      return true;
+    }
+
+    return false;
+  });
 
-  RemoveFromCollecton(CurrentLevel->FinishTurnTriggers);
-  RemoveFromCollecton(CurrentLevel->GlobalTriggers);
+  collection.erase(newBegin, collection.end());
 }
 
 // =============================================================================
@@ -514,6 +561,7 @@ void Map::RemoveStaticObjects()
      && CurrentLevel->StaticMapObjects[cell.X][cell.Y]->IsDestroyed)
     {
       CurrentLevel->StaticMapObjects[cell.X][cell.Y].reset(nullptr);
+      CurrentLevel->LayoutVersion++;
     }
   }
 }
@@ -527,7 +575,7 @@ void Map::ChangeLevel(MapType levelToChange, bool goingDown)
   //
   // Unblock cell on stairs before going.
   //
-  CurrentLevel->MapArray[player.PosX][player.PosY]->Occupied = false;
+  CurrentLevel->Tiles.SetOccupied(player.PosX, player.PosY, false);
 
   ChangeOrInstantiateLevel(levelToChange);
 
@@ -566,22 +614,29 @@ void Map::TeleportToExistingLevel(MapType levelToChange,
   // we must manually unblock player's cell first
   // or MoveTo() for actor won't work.
   //
-  auto& ma = CurrentLevel->MapArray;
-  ma[whoToTeleport->PosX][whoToTeleport->PosY]->Occupied = false;
+  CurrentLevel->Tiles.SetOccupied(whoToTeleport->PosX,
+                                  whoToTeleport->PosY,
+                                  false);
+
+  //
+  // Effects queued on previous level are meaningless now.
+  //
+  AnimationTimeline::Instance().Clear();
 
   CurrentLevel = _levels[levelToChange].get();
 
-  auto& mapRef = CurrentLevel->MapArray[teleportTo.X][teleportTo.Y];
-  auto& soRef  = CurrentLevel->StaticMapObjects[teleportTo.X][teleportTo.Y];
+  auto& tiles = CurrentLevel->Tiles;
+  auto& soRef = CurrentLevel->StaticMapObjects[teleportTo.X][teleportTo.Y];
+
+  bool tileBlocking = tiles.IsBlocking(teleportTo.X, teleportTo.Y);
 
-  bool tpToWall = ((mapRef != nullptr && mapRef->Blocking)
-                || (soRef != nullptr && soRef->Blocking));
+  bool tpToWall = (tileBlocking || (soRef != nullptr && soRef->Blocking));
 
   auto actor = GetActorAtPosition(teleportTo.X, teleportTo.Y);
   bool tpOccupied = (actor != nullptr);
 
-  std::string tpTo = mapRef->Blocking ?
-                     mapRef->ObjectName :
+  std::string tpTo = tileBlocking ?
+                     tiles.GetName(teleportTo.X, teleportTo.Y) :
                      (soRef != nullptr ? soRef->ObjectName : "unknown");
 
   bool forceMove = false;
@@ -644,81 +699,35 @@ void Map::TeleportToExistingLevel(MapType levelToChange,
 
 void Map::ChangeOrInstantiateLevel(MapType levelName)
 {
-  int lvlAsInt = (int)levelName;
+  AnimationTimeline::Instance().Clear();
 
   if (_levels.count(levelName) == 0)
   {
-    ShowLoadingText();
+    auto buildStart = Clock::now();
 
-    switch (levelName)
+    auto it = _pendingLevels.find(levelName);
+    if (it != _pendingLevels.end())
     {
-      case MapType::TOWN:
-        InstantiateLevel<MapLevelTown>(100, 50, levelName, lvlAsInt);
-        break;
-
-      case MapType::MINES_1:
-      case MapType::MINES_2:
-        InstantiateLevel<MapLevelMines>(50, 25, levelName, lvlAsInt);
-        break;
+      PendingLevel& pl = it->second;
 
-      case MapType::MINES_3:
-      case MapType::MINES_4:
-        InstantiateLevel<MapLevelMines>(30, 30, levelName, lvlAsInt);
-        break;
-
-      case MapType::MINES_5:
-        //
-        // Map size values in the constructor here don't matter
-        // since they will be overridden there for special level case.
-        //
-        InstantiateLevel<MapLevelMines>(30, 30, levelName, lvlAsInt);
-        break;
+      if (pl.Job.wait_for(Ms{0}) != std::future_status::ready)
+      {
+        ShowLoadingText();
+      }
 
-      case MapType::CAVES_1:
-      case MapType::CAVES_2:
-      case MapType::CAVES_3:
-      case MapType::CAVES_4:
-      case MapType::CAVES_5:
-        InstantiateLevel<MapLevelCaves>(60, 30, levelName, lvlAsInt);
-        break;
+      pl.Job.get();
 
-      case MapType::LOST_CITY:
-        InstantiateLevel<MapLevelLostCity>(150, 50, levelName, lvlAsInt);
-        break;
+      pl.Level->SetPregeneratedLayout(std::move(pl.Layout));
 
-      case MapType::DEEP_DARK_1:
-      case MapType::DEEP_DARK_2:
-      case MapType::DEEP_DARK_3:
-      case MapType::DEEP_DARK_4:
-      case MapType::DEEP_DARK_5:
-        InstantiateLevel<MapLevelDeepDark>(80, 40, levelName, lvlAsInt);
-        break;
+      _levels[levelName] = std::move(pl.Level);
 
-      case MapType::ABYSS_1:
-      case MapType::ABYSS_2:
-      case MapType::ABYSS_3:
-      case MapType::ABYSS_4:
-      case MapType::ABYSS_5:
-        InstantiateLevel<MapLevelAbyss>(200, 200, levelName, lvlAsInt);
-        break;
-
-      case MapType::NETHER_1:
-      case MapType::NETHER_2:
-      case MapType::NETHER_3:
-      case MapType::NETHER_4:
-      case MapType::NETHER_5:
-        InstantiateLevel<MapLevelNether>(120, 120, levelName, lvlAsInt);
-        break;
-
-      case MapType::THE_END:
-        InstantiateLevel<MapLevelEndgame>(64, 64, levelName, lvlAsInt);
-        break;
+      _pendingLevels.erase(it);
+    }
+    else
+    {
+      ShowLoadingText();
 
-      #ifdef BUILD_TESTS
-      case MapType::TEST_LEVEL:
-        InstantiateLevel<MapLevelTest>(30, 20, levelName, lvlAsInt);
-        break;
-      #endif
+      _levels[levelName] = CreateLevelObject(levelName);
     }
 
     //
@@ -727,6 +736,15 @@ void Map::ChangeOrInstantiateLevel(MapType levelName)
     CurrentLevel = _levels[levelName].get();
 
     _levels[levelName]->PrepareMap();
+
+    Ns dt = FT::duration_cast<Ns>(Clock::now() - buildStart);
+
+    _levelBuildTimeMs[levelName] = (double)dt.count() / 1000000.0;
+
+    auto str = Util::StringFormat("%s built in %.2f ms",
+                                  CurrentLevel->LevelName.data(),
+                                  _levelBuildTimeMs[levelName]);
+    LogPrint(str);
   }
   else
   {
@@ -755,6 +773,125 @@ void Map::ChangeOrInstantiateLevel(MapType levelName)
   // won't confuse the player.
   //
   Printer::Instance().ShowLastMessage = false;
+
+  PregenerateLevel((MapType)((int)CurrentLevel->MapType_ + 1));
+}
+
+// =============================================================================
+
+std::unique_ptr<MapLevelBase> Map::CreateLevelObject(MapType levelName)
+{
+  int lvlAsInt = (int)levelName;
+
+  std::unique_ptr<MapLevelBase> level;
+
+  switch (levelName)
+  {
+    case MapType::TOWN:
+      level = MakeLevel<MapLevelTown>(100, 50, levelName, lvlAsInt);
+      break;
+
+    case MapType::MINES_1:
+    case MapType::MINES_2:
+      level = MakeLevel<MapLevelMines>(50, 25, levelName, lvlAsInt);
+      break;
+
+    case MapType::MINES_3:
+    case MapType::MINES_4:
+      level = MakeLevel<MapLevelMines>(30, 30, levelName, lvlAsInt);
+      break;
+
+    case MapType::MINES_5:
+      //
+      // Map size values in the constructor here don't matter
+      // since they will be overridden there for special level case.
+      //
+      level = MakeLevel<MapLevelMines>(30, 30, levelName, lvlAsInt);
+      break;
+
+    case MapType::CAVES_1:
+    case MapType::CAVES_2:
+    case MapType::CAVES_3:
+    case MapType::CAVES_4:
+    case MapType::CAVES_5:
+      level = MakeLevel<MapLevelCaves>(60, 30, levelName, lvlAsInt);
+      break;
+
+    case MapType::LOST_CITY:
+      level = MakeLevel<MapLevelLostCity>(150, 50, levelName, lvlAsInt);
+      break;
+
+    case MapType::DEEP_DARK_1:
+    case MapType::DEEP_DARK_2:
+    case MapType::DEEP_DARK_3:
+    case MapType::DEEP_DARK_4:
+    case MapType::DEEP_DARK_5:
+      level = MakeLevel<MapLevelDeepDark>(80, 40, levelName, lvlAsInt);
+      break;
+
+    case MapType::ABYSS_1:
+    case MapType::ABYSS_2:
+    case MapType::ABYSS_3:
+    case MapType::ABYSS_4:
+    case MapType::ABYSS_5:
+      level = MakeLevel<MapLevelAbyss>(200, 200, levelName, lvlAsInt);
+      break;
+
+    case MapType::NETHER_1:
+    case MapType::NETHER_2:
+    case MapType::NETHER_3:
+    case MapType::NETHER_4:
+    case MapType::NETHER_5:
+      level = MakeLevel<MapLevelNether>(120, 120, levelName, lvlAsInt);
+      break;
+
+    case MapType::THE_END:
+      level = MakeLevel<MapLevelEndgame>(64, 64, levelName, lvlAsInt);
+      break;
+
+    #ifdef BUILD_TESTS
+    case MapType::TEST_LEVEL:
+      level = MakeLevel<MapLevelTest>(30, 20, levelName, lvlAsInt);
+      break;
+    #endif
+  }
+
+  return level;
+}
+
+// =============================================================================
+
+void Map::PregenerateLevel(MapType levelName)
+{
+  if ((int)levelName > (int)MapType::THE_END
+   || _levels.count(levelName) == 1
+   || _pendingLevels.count(levelName) == 1)
+  {
+    return;
+  }
+
+  auto level = CreateLevelObject(levelName);
+  if (level == nullptr)
+  {
+    return;
+  }
+
+  PendingLevel& pl = _pendingLevels[levelName];
+
+  pl.Level  = std::move(level);
+  pl.Layout = std::make_unique<LevelBuilder>(pl.Level->GetLayoutSeed());
+
+  MapLevelBase* lvl = pl.Level.get();
+  LevelBuilder* lb  = pl.Layout.get();
+
+  //
+  // Generators use their own RNG seeded per level (see DGBase),
+  // so layout doesn't depend on when or on which thread it's made.
+  //
+  pl.Job = std::async(std::launch::async, [lvl, lb]()
+  {
+    lvl->GenerateLayout(*lb);
+  });
 }
 
 // =============================================================================
@@ -879,6 +1016,14 @@ std::vector<MapType> Map::GetAllVisitedLevels()
 
 // =============================================================================
 
+double Map::GetLevelBuildTimeMs(MapType type)
+{
+  auto it = _levelBuildTimeMs.find(type);
+  return (it != _levelBuildTimeMs.end()) ? it->second : 0.0;
+}
+
+// =============================================================================
+
 void Map::ShowLoadingText(const std::string& textOverride)
 {
   std::string text = textOverride.empty() ? "Now loading..." : textOverride;
@@ -923,7 +1068,7 @@ void Map::PrintMapArrayRevealedStatus()
     for (int y = 0; y < CurrentLevel->MapSize.Y; y++)
     {
       auto str = Util::StringFormat("%i",
-                                    CurrentLevel->MapArray[x][y]->Revealed);
+                                    CurrentLevel->Tiles.IsRevealed(x, y));
       row += str;
     }
     dbg.push_back(row);
@@ -957,13 +1102,13 @@ void Map::PrintMapLayout()
   {
     for (int y = 0; y < CurrentLevel->MapSize.X; y++)
     {
-      char ch = CurrentLevel->MapArray[y][x]->Image;
+      char ch = CurrentLevel->Tiles.GetImage(y, x);
 
       //
       // Replace 'wall' tiles with '#'
       //
-      if (CurrentLevel->MapArray[y][x]->Blocking
-       && CurrentLevel->MapArray[y][x]->BlocksSight
+      if (CurrentLevel->Tiles.IsBlocking(y, x)
+       && CurrentLevel->Tiles.IsBlockingSight(y, x)
        && ch == ' ')
       {
         ch = '#';
@@ -1070,7 +1215,7 @@ void Map::ProcessAoEDamage(GameObject* target, ItemComponent* weapon, int centra
 
 bool Map::IsTileDangerous(const Position& pos)
 {
-  GameObjectType tileType = CurrentLevel->MapArray[pos.X][pos.Y]->Type;
+  GameObjectType tileType = CurrentLevel->Tiles.GetType(pos.X, pos.Y);
 
   return (tileType == GameObjectType::CHASM
        || tileType == GameObjectType::DEEP_WATER
@@ -1104,7 +1249,7 @@ std::vector<Position> Map::GetWalkableCellsAround(const Position& pos)
 
         if (Util::IsInsideMap({ x, y }, CurrentLevel->MapSize)
         && (!CurrentLevel->IsCellBlocking({ x, y })
-         && !CurrentLevel->MapArray[x][y]->Occupied))
+         && !CurrentLevel->Tiles.IsOccupied(x, y)))
         {
           res.push_back({ x, y });
         }
@@ -1177,7 +1322,7 @@ bool Map::IsObjectVisible(const Position &from,
     // Object can be blocking but not blocking the sight (e.g. lava, chasm)
     // so check against BlocksSight only is needed.
     //
-    bool groundBlock = CurrentLevel->MapArray[c.X][c.Y]->BlocksSight;
+    bool groundBlock = CurrentLevel->Tiles.IsBlockingSight(c.X, c.Y);
     bool staticBlock = false;
 
     if (CurrentLevel->StaticMapObjects[c.X][c.Y] != nullptr)
@@ -1196,6 +1341,24 @@ bool Map::IsObjectVisible(const Position &from,
 
 // =============================================================================
 
+bool Map::IsVisibleFromPlayer(int x, int y)
+{
+  //
+  // FOV is recalculated only during player's turn,
+  // so if something has changed since then it can't be trusted.
+  //
+  bool fovValid = !_playerRef->FOV.IsDirty(_playerRef->GetVisibilityRadius());
+
+  if (fovValid && _playerRef->FOV.IsInRange(x, y))
+  {
+    return _playerRef->FOV.IsVisible(x, y);
+  }
+
+  return IsObjectVisible(_playerRef->GetPosition(), { x, y });
+}
+
+// =============================================================================
+
 void Map::DrawMapTilesAroundPlayer()
 {
   int tw = Printer::TerminalWidth;
@@ -1211,9 +1374,9 @@ void Map::DrawMapTilesAroundPlayer()
     int x = cell.X;
     int y = cell.Y;
 
-    if (CurrentLevel->MapArray[x][y]->Visible)
+    if (CurrentLevel->Tiles.IsVisible(x, y))
     {
-      CurrentLevel->MapArray[x][y]->Draw();
+      CurrentLevel->Tiles.Draw(x, y);
 
       //
       // Draw static object on top if present.
@@ -1267,7 +1430,7 @@ void Map::DrawGameObjects()
     int x = go.get()->PosX;
     int y = go.get()->PosY;
 
-    if (CurrentLevel->MapArray[x][y]->Visible)
+    if (CurrentLevel->Tiles.IsVisible(x, y))
     {
       // NOTE: gems should not respect floor color (unused now)
 
@@ -1275,7 +1438,7 @@ void Map::DrawGameObjects()
       // replace it with current floor color
       //bool cond = (go->BgColor == GlobalConstants::BlackColor);
       //go.get()->Draw(go.get()->FgColor, cond
-      //               ? CurrentLevel->MapArray[x][y]->BgColor
+      //               ? CurrentLevel->Tiles.GetBgColor(x, y)
       //               : go->BgColor);
 
       go->Draw(go->FgColor, go->BgColor);
@@ -1297,7 +1460,7 @@ void Map::DrawActors()
 
     auto colors = GetActorColors(actor.get());
 
-    if (CurrentLevel->MapArray[x][y]->Visible)
+    if (CurrentLevel->Tiles.IsVisible(x, y))
     {
       if (actor->HasEffect(ItemBonusType::INVISIBILITY))
       {
@@ -1374,7 +1537,7 @@ std::pair<uint32_t, uint32_t> Map::GetActorColors(GameObject* actor)
     }
     else
     {
-      auto& tileBgColor = CurrentLevel->MapArray[x][y]->BgColor;
+      auto& tileBgColor = CurrentLevel->Tiles.GetBgColor(x, y);
       bgColor = (tileBgColor == actor->FgColor
                  ? Colors::BlackColor
                  : tileBgColor);
@@ -1386,7 +1549,9 @@ std::pair<uint32_t, uint32_t> Map::GetActorColors(GameObject* actor)
 
 // =============================================================================
 
-void Map::EraseFromCollection(std::vector<std::unique_ptr<GameObject>>& list)
+void Map::EraseFromCollection(std::vector<std::unique_ptr<GameObject>>& list,
+                              OccupancyIndex& index,
+                              UpdateList* updateList)
 {
   //
   // It's dangerous to iterate over collection from start to end using plain for
@@ -1415,10 +1580,18 @@ void Map::EraseFromCollection(std::vector<std::unique_ptr<GameObject>>& list)
   auto newBegin =
       std::remove_if(list.begin(),
                      list.end(),
-                     [this](const std::unique_ptr<GameObject>& go)
+                     [this, &index, updateList]
+                     (const std::unique_ptr<GameObject>& go)
                      {
                        if (go != nullptr && go->IsDestroyed)
                        {
+                         index.Remove(go.get());
+
+                         if (updateList != nullptr)
+                         {
+                           updateList->Remove(go.get());
+                         }
+
                          int x = go->PosX;
                          int y = go->PosY;
 
@@ -1430,7 +1603,7 @@ void Map::EraseFromCollection(std::vector<std::unique_ptr<GameObject>>& list)
                          // blocking in the first place, but if it was something
                          // blocking, the cell should become unblocked now.
                          //
-                         CurrentLevel->MapArray[x][y]->Occupied = false;
+                         CurrentLevel->Tiles.SetOccupied(x, y, false);
 
                          return true;
                        }
@@ -5,6 +5,7 @@
 #include <random>
 #include <chrono>
 #include <memory>
+#include <future>
 
 #include "singleton.h"
 #include "constants.h"
@@ -44,7 +45,22 @@ class Map : public Singleton<Map>
     );
 
     void Update();
-    void UpdateTriggers(TriggerUpdateType updateType);
+
+    //
+    // Tick based time means that most of Update() calls between
+    // player's turns only fill everyone's action meters.
+    // Jumps over such map update cycles in one go
+    // up to the one where someone can act
+    // and returns how many cycles were skipped.
+    //
+    int SkipIdleTicks();
+
+    //
+    // Checks triggers of current level subscribed to this event
+    // after the posted ones (see TriggerDispatcher::Post()).
+    //
+    void DispatchTriggerEvent(const TriggerEvent& e);
+    void PostTriggerEvent(const TriggerEvent& e);
 
     void ChangeLevel(MapType levelToChange, bool goingDown);
     void TeleportToExistingLevel(MapType levelToChange,
@@ -65,6 +81,12 @@ class Map : public Singleton<Map>
                          const Position& to,
                          bool excludeEnd = false);
 
+    //
+    // Uses player's field of view if cell is within it,
+    // falls back to IsObjectVisible() otherwise.
+    //
+    bool IsVisibleFromPlayer(int x, int y);
+
     bool IsTileDangerous(const Position& pos);
 
     GameObject* GetActorAtPosition(int x, int y);
@@ -73,14 +95,21 @@ class Map : public Singleton<Map>
     GameObject* FindGameObjectById(const uint64_t& objId,
                                    GameObjectCollectionType collectionType);
 
+    //
+    // Tile object is kept by the level (see TileLayer::GetTileObject()),
+    // so this is for callers that hold on to it, like dev console handles.
+    // Use TileLayer::MakeTileObject() if you need tile only for a moment.
+    //
     GameObject* GetMapObjectAtPosition(int x, int y);
 
     std::vector<GameObject*> GetGameObjectsAtPosition(int x, int y);
 
-    std::pair<int, GameObject*> GetGameObjectToPickup(int x, int y);
-
-    std::vector<std::pair<int, GameObject*>>
-    GetGameObjectsToPickup(int x, int y);
+    //
+    // Items at (x, y) in the same order they lie in the pile,
+    // topmost is the last one.
+    //
+    GameObject* GetGameObjectToPickup(int x, int y);
+    std::vector<GameObject*> GetGameObjectsToPickup(int x, int y);
 
     MapLevelBase* GetLevelRefByType(MapType type);
 
@@ -94,40 +123,13 @@ class Map : public Singleton<Map>
     int CountAroundStatic(int x, int y, GameObjectType type);
     int CountWallsOrthogonal(int x, int y);
 
-    MapLevelBase* CurrentLevel = nullptr;
-
-    template <typename Collection>
-    GameObject* FindInVV(const Collection& c,
-                         const uint64_t& objId)
-    {
-      for (auto& line : c)
-      {
-        for (auto& o : line)
-        {
-          if (o.get() != nullptr && o.get()->ObjectId() == objId)
-          {
-            return o.get();
-          }
-        }
-      }
-
-      return nullptr;
-    }
+    //
+    // How long it took to create level of given type
+    // (generation and PrepareMap()), 0.0 if it wasn't created yet.
+    //
+    double GetLevelBuildTimeMs(MapType type);
 
-    template <typename Collection>
-    GameObject* FindInV(const Collection& c,
-                        const uint64_t& objId)
-    {
-      for (auto& o : c)
-      {
-        if (o.get() != nullptr && o.get()->ObjectId() == objId)
-        {
-          return o.get();
-        }
-      }
-
-      return nullptr;
-    }
+    MapLevelBase* CurrentLevel = nullptr;
 
   protected:
     void InitSpecific() override;
@@ -137,8 +139,34 @@ class Map : public Singleton<Map>
 
     std::unordered_map<MapType, std::unique_ptr<MapLevelBase>> _levels;
     std::unordered_map<MapType, bool> _mapVisitFirstTime;
+    std::unordered_map<MapType, double> _levelBuildTimeMs;
+
+    //
+    // Level that is not visited yet with its layout
+    // being generated on the background thread.
+    //
+    // Job goes last so that it's destroyed (and thus waited for)
+    // before the data it works on.
+    //
+    struct PendingLevel
+    {
+      std::unique_ptr<MapLevelBase> Level;
+      std::unique_ptr<LevelBuilder> Layout;
+      std::future<void> Job;
+    };
+
+    std::unordered_map<MapType, PendingLevel> _pendingLevels;
 
     void ChangeOrInstantiateLevel(MapType levelName);
+
+    std::unique_ptr<MapLevelBase> CreateLevelObject(MapType levelName);
+
+    //
+    // Starts generation of level layout in background,
+    // so that it's ready by the time player gets there.
+    // Objects are still created on the main thread in PrepareMap().
+    //
+    void PregenerateLevel(MapType levelName);
     void ShowLoadingText(const std::string& textOverride = std::string());
     void DrawFowTile(int x, int y);
     void DrawMapTilesAroundPlayer();
@@ -150,7 +178,15 @@ class Map : public Singleton<Map>
 
     void RemoveTriggers();
     void RemoveStaticObjects();
-    void EraseFromCollection(std::vector<std::unique_ptr<GameObject>>& list);
+    void EraseFromCollection(std::vector<std::unique_ptr<GameObject>>& list,
+                             OccupancyIndex& index,
+                             UpdateList* updateList = nullptr);
+
+    //
+    // O(1) check that object is stored in given collection
+    // of current level. TRIGGERS and ALL are not supported.
+    //
+    bool IsInCollection(GameObject* go, GameObjectCollectionType c);
 
     std::pair<uint32_t, uint32_t> GetActorColors(GameObject* actor);
 
@@ -159,9 +195,12 @@ class Map : public Singleton<Map>
     Position _windowSize;
 
     template <typename T>
-    void InstantiateLevel(int sizeX, int sizeY, MapType type, int dungeonLevel)
+    std::unique_ptr<MapLevelBase> MakeLevel(int sizeX,
+                                            int sizeY,
+                                            MapType type,
+                                            int dungeonLevel)
     {
-      _levels[type] = std::make_unique<T>(sizeX, sizeY, type, dungeonLevel);
+      return std::make_unique<T>(sizeX, sizeY, type, dungeonLevel);
     }
 
     friend class Application;
@@ -163,7 +163,7 @@ GameObject* MonstersInc::CreateRat(int x, int y, bool randomize)
   go->HealthRegenTurns     = 30;
 
   //
-  // Sets Occupied flag for _currentCell
+  // Sets Occupied flag for the tile it stands on
   //
   go->Move(0, 0);
 
@@ -2,12 +2,12 @@
 
 #include "application.h"
 #include "map.h"
+#include "animation-timeline.h"
 #include "util.h"
 #include "base64-strings.h"
+#include "profiler.h"
 
-#ifdef DEBUG_BUILD
 #include "logger.h"
-#endif
 
 size_t Printer::TerminalWidth = 0;
 size_t Printer::TerminalHeight = 0;
@@ -124,6 +124,18 @@ bool Printer::InitForSDL()
     return false;
   }
 
+  _savedFrame = SDL_CreateTexture(Application::Instance().Renderer,
+                                  SDL_PIXELFORMAT_RGBA32,
+                                  SDL_TEXTUREACCESS_TARGET,
+                                  gameConfig.WindowWidth,
+                                  gameConfig.WindowHeight);
+
+  if (_savedFrame == nullptr)
+  {
+    ConsoleLog("SDL_CreateTexture() fail: %s\n", SDL_GetError());
+    return false;
+  }
+
   char asciiIndex = 0;
   int tileIndex = 0;
   for (int y = 0; y < h; y += _tileHeight)
@@ -262,19 +274,8 @@ void Printer::DrawWindow(const Position& leftCorner,
 
     for (auto& c : lHeader)
     {
-      ConvertHtmlToRGB(headerBgColor);
-      SDL_SetTextureColorMod(_tileset,
-                             _convertedHtml.R,
-                             _convertedHtml.G,
-                             _convertedHtml.B);
-      DrawTile(headerPosX, headerPosY, 219);
-
-      ConvertHtmlToRGB(headerFgColor);
-      SDL_SetTextureColorMod(_tileset,
-                             _convertedHtml.R,
-                             _convertedHtml.G,
-                             _convertedHtml.B);
-      DrawTile(headerPosX, headerPosY, c);
+      DrawTile(headerPosX, headerPosY, 219, headerBgColor);
+      DrawTile(headerPosX, headerPosY, c,   headerFgColor);
 
       headerPosX += _tileWidthScaled;
     }
@@ -287,11 +288,6 @@ void Printer::DrawRect(int x1, int y1,
                        int x2, int y2,
                        uint32_t color)
 {
-  if (SDL_GetRenderTarget(Application::Instance().Renderer) == nullptr)
-  {
-    SDL_SetRenderTarget(Application::Instance().Renderer, _frameBuffer);
-  }
-
   TileInfo& ti = _tiles[219];
 
   _drawSrc.x = ti.X;
@@ -304,21 +300,13 @@ void Printer::DrawRect(int x1, int y1,
   _drawDst.w = std::abs(x2 - x1);
   _drawDst.h = std::abs(y2 - y1);
 
-  ConvertHtmlToRGB(color);
-  SDL_SetTextureColorMod(_tileset,
-                         _convertedHtml.R,
-                         _convertedHtml.G,
-                         _convertedHtml.B);
-
-  SDL_RenderCopy(Application::Instance().Renderer,
-                 _tileset,
-                 &_drawSrc,
-                 &_drawDst);
+  _tileQuads.push_back({ _drawSrc, _drawDst, color });
 }
 
 // =============================================================================
 
-void Printer::DrawTile(int x, int y, int tileIndex)
+void Printer::DrawTile(int x, int y, int tileIndex,
+                       const uint32_t& htmlColor)
 {
   TileInfo& tile = _tiles[tileIndex];
 
@@ -332,20 +320,13 @@ void Printer::DrawTile(int x, int y, int tileIndex)
   _drawDst.w = _tileWidthScaled;
   _drawDst.h = _tileHeightScaled;
 
-  if (SDL_GetRenderTarget(Application::Instance().Renderer) == nullptr)
-  {
-    SDL_SetRenderTarget(Application::Instance().Renderer, _frameBuffer);
-  }
-
-  SDL_RenderCopy(Application::Instance().Renderer,
-                 _tileset,
-                 &_drawSrc,
-                 &_drawDst);
+  _tileQuads.push_back({ _drawSrc, _drawDst, htmlColor });
 }
 
 // =============================================================================
 
-void Printer::DrawTile(int x, int y, int tileIndex, size_t scale)
+void Printer::DrawTile(int x, int y, int tileIndex, size_t scale,
+                       const uint32_t& htmlColor)
 {
   size_t tileScaleW = (scale <= 1)
                       ? _tileWidthScaled
@@ -370,15 +351,108 @@ void Printer::DrawTile(int x, int y, int tileIndex, size_t scale)
   _drawDst.w = tileScaleW;
   _drawDst.h = tileScaleH;
 
-  if (SDL_GetRenderTarget(Application::Instance().Renderer) == nullptr)
+  _tileQuads.push_back({ _drawSrc, _drawDst, htmlColor });
+}
+
+// =============================================================================
+
+void Printer::FlushTiles()
+{
+  if (_tileQuads.empty())
   {
-    SDL_SetRenderTarget(Application::Instance().Renderer, _frameBuffer);
+    return;
   }
 
-  SDL_RenderCopy(Application::Instance().Renderer,
-                 _tileset,
-                 &_drawSrc,
-                 &_drawDst);
+  SDL_Renderer* renderer = Application::Instance().Renderer;
+
+  SDL_SetRenderTarget(renderer, _frameBuffer);
+
+  #if SDL_VERSION_ATLEAST(2, 0, 18)
+  //
+  // Color goes into vertices, so the whole frame is one draw call
+  // regardless of how many colors there are, and quads are drawn
+  // exactly in the order they were queued.
+  //
+  float tw = (float)_tilesetWidth;
+  float th = (float)_tilesetHeight;
+
+  _vertices.clear();
+  _vertices.reserve(_tileQuads.size() * 4);
+
+  for (auto& q : _tileQuads)
+  {
+    ConvertHtmlToRGB(q.Color);
+
+    SDL_Color c = { (Uint8)_convertedHtml.R,
+                    (Uint8)_convertedHtml.G,
+                    (Uint8)_convertedHtml.B,
+                    255 };
+
+    float x1 = (float)q.Dst.x;
+    float y1 = (float)q.Dst.y;
+    float x2 = (float)(q.Dst.x + q.Dst.w);
+    float y2 = (float)(q.Dst.y + q.Dst.h);
+
+    float u1 = (float)q.Src.x / tw;
+    float v1 = (float)q.Src.y / th;
+    float u2 = (float)(q.Src.x + q.Src.w) / tw;
+    float v2 = (float)(q.Src.y + q.Src.h) / th;
+
+    _vertices.push_back({ { x1, y1 }, c, { u1, v1 } });
+    _vertices.push_back({ { x2, y1 }, c, { u2, v1 } });
+    _vertices.push_back({ { x2, y2 }, c, { u2, v2 } });
+    _vertices.push_back({ { x1, y2 }, c, { u1, v2 } });
+  }
+
+  //
+  // Index pattern is the same for every quad,
+  // so only grow it when needed.
+  //
+  size_t indicesNeeded = _tileQuads.size() * 6;
+  for (size_t i = _indices.size(); i < indicesNeeded; i += 6)
+  {
+    int base = (i / 6) * 4;
+
+    _indices.push_back(base);
+    _indices.push_back(base + 1);
+    _indices.push_back(base + 2);
+    _indices.push_back(base);
+    _indices.push_back(base + 2);
+    _indices.push_back(base + 3);
+  }
+
+  SDL_RenderGeometry(renderer,
+                     _tileset,
+                     _vertices.data(),
+                     _vertices.size(),
+                     _indices.data(),
+                     indicesNeeded);
+  #else
+  //
+  // No SDL_RenderGeometry(), at least don't touch
+  // texture color mod if color hasn't changed.
+  //
+  bool first = true;
+  uint32_t lastColor = 0;
+
+  for (auto& q : _tileQuads)
+  {
+    if (first || q.Color != lastColor)
+    {
+      ConvertHtmlToRGB(q.Color);
+      SDL_SetTextureColorMod(_tileset,
+                             _convertedHtml.R,
+                             _convertedHtml.G,
+                             _convertedHtml.B);
+      lastColor = q.Color;
+      first = false;
+    }
+
+    SDL_RenderCopy(renderer, _tileset, &q.Src, &q.Dst);
+  }
+  #endif
+
+  _tileQuads.clear();
 }
 
 // =============================================================================
@@ -393,20 +467,10 @@ void Printer::PrintFB(const int& x, const int& y,
 
   if (htmlColorBg != Colors::None)
   {
-    ConvertHtmlToRGB(htmlColorBg);
-    SDL_SetTextureColorMod(_tileset,
-                           _convertedHtml.R,
-                           _convertedHtml.G,
-                           _convertedHtml.B);
-    DrawTile(posX, posY, 219);
+    DrawTile(posX, posY, 219, htmlColorBg);
   }
 
-  ConvertHtmlToRGB(htmlColorFg);
-  SDL_SetTextureColorMod(_tileset,
-                         _convertedHtml.R,
-                         _convertedHtml.G,
-                         _convertedHtml.B);
-  DrawTile(posX, posY, image);
+  DrawTile(posX, posY, image, htmlColorFg);
 }
 
 // =============================================================================
@@ -441,20 +505,10 @@ void Printer::PrintFB(const int& x, const int& y,
   {
     if (htmlColorBg != Colors::None)
     {
-      ConvertHtmlToRGB(htmlColorBg);
-      SDL_SetTextureColorMod(_tileset,
-                             _convertedHtml.R,
-                             _convertedHtml.G,
-                             _convertedHtml.B);
-      DrawTile(px, py, 219);
+      DrawTile(px, py, 219, htmlColorBg);
     }
 
-    ConvertHtmlToRGB(htmlColorFg);
-    SDL_SetTextureColorMod(_tileset,
-                           _convertedHtml.R,
-                           _convertedHtml.G,
-                           _convertedHtml.B);
-    DrawTile(px, py, c);
+    DrawTile(px, py, c, htmlColorFg);
 
     px += _tileWidthScaled;
   }
@@ -502,20 +556,10 @@ void Printer::PrintFB(const int& x,
   {
     if (htmlColorBg != Colors::None)
     {
-      ConvertHtmlToRGB(htmlColorBg);
-      SDL_SetTextureColorMod(_tileset,
-                             _convertedHtml.R,
-                             _convertedHtml.G,
-                             _convertedHtml.B);
-      DrawTile(px, py, 219, scale);
+      DrawTile(px, py, 219, scale, htmlColorBg);
     }
 
-    ConvertHtmlToRGB(htmlColorFg);
-    SDL_SetTextureColorMod(_tileset,
-                           _convertedHtml.R,
-                           _convertedHtml.G,
-                           _convertedHtml.B);
-    DrawTile(px, py, c, scale);
+    DrawTile(px, py, c, scale, htmlColorFg);
 
     px += tileScaleW;
   }
@@ -525,17 +569,20 @@ void Printer::PrintFB(const int& x,
 
 void Printer::ConvertHtmlToRGB(const uint32_t& htmlColor)
 {
-  if (_validColorsCache.count(htmlColor) == 1)
-  {
-    _convertedHtml = _validColorsCache[htmlColor];
-    return;
-  }
-
   _convertedHtml.R = ((htmlColor & _maskR) >> 16);
   _convertedHtml.G = ((htmlColor & _maskG) >> 8);
   _convertedHtml.B = (htmlColor & _maskB);
 
-  _validColorsCache[htmlColor] = _convertedHtml;
+  //
+  // Cache is only needed to know which colors were used
+  // (see ColorsUsed() and dev console), so there's no need
+  // to touch it for every consecutive cell of the same color.
+  //
+  if (htmlColor != _lastConvertedColor || _validColorsCache.empty())
+  {
+    _validColorsCache.emplace(htmlColor, _convertedHtml);
+    _lastConvertedColor = htmlColor;
+  }
 }
 
 // =============================================================================
@@ -608,23 +655,23 @@ bool Printer::InitForCurses()
 
 // =============================================================================
 
-const std::unordered_map<size_t, ColorPair>& Printer::GetValidColorsCache()
+const std::unordered_map<uint64_t, ColorPair>& Printer::GetValidColorsCache()
 {
   return _colorMap;
 }
 
 // =============================================================================
 
-bool Printer::ContainsColorMap(size_t hashToCheck)
+bool Printer::ContainsColorMap(uint64_t keyToCheck)
 {
-  return (_colorMap.count(hashToCheck) == 1);
+  return (_colorMap.count(keyToCheck) == 1);
 }
 
 // =============================================================================
 
-bool Printer::ColorIndexExists(size_t hashToCheck)
+bool Printer::ColorIndexExists(uint32_t htmlColor)
 {
-  return (_colorIndexMap.count(hashToCheck) == 1);
+  return (_colorIndexMap.count(htmlColor) == 1);
 }
 
 // =============================================================================
@@ -653,57 +700,48 @@ NColor Printer::GetNColor(const uint32_t& htmlColor)
 
 // =============================================================================
 
-size_t Printer::GetOrSetColor(const uint32_t& htmlColorFg,
-                              const uint32_t& htmlColorBg)
+short Printer::GetOrSetColor(const uint32_t& htmlColorFg,
+                             const uint32_t& htmlColorBg)
 {
-  std::string fgColorStr = Util::StringFormat("#%06X", htmlColorFg);
-  std::string bgColorStr = Util::StringFormat("#%06X", htmlColorBg);
-
-  std::string composition = fgColorStr + bgColorStr;
+  uint64_t key = ((uint64_t)htmlColorFg << 32) | htmlColorBg;
 
-  std::hash<std::string> hasher;
-
-  size_t hash = hasher(composition);
+  if (_lastColorPair != -1 && key == _lastColorKey)
+  {
+    return _lastColorPair;
+  }
 
-  if (!ContainsColorMap(hash))
+  auto it = _colorMap.find(key);
+  if (it == _colorMap.end())
   {
     auto fg = GetNColor(htmlColorFg);
     auto bg = GetNColor(htmlColorBg);
 
-    short hashFg = hasher(fgColorStr);
-    short hashBg = hasher(bgColorStr);
-
-    if (!ColorIndexExists(hashFg))
-    {
-      fg.ColorIndex = _colorGlobalIndex;
-      _colorIndexMap[hashFg] = _colorGlobalIndex++;
-      init_color(fg.ColorIndex, fg.R, fg.G, fg.B);
-    }
-    else
+    if (!ColorIndexExists(htmlColorFg))
     {
-      fg.ColorIndex = _colorIndexMap[hashFg];
+      _colorIndexMap[htmlColorFg] = _colorGlobalIndex++;
+      init_color(_colorIndexMap[htmlColorFg], fg.R, fg.G, fg.B);
     }
 
-    if (!ColorIndexExists(hashBg))
-    {
-      bg.ColorIndex = _colorGlobalIndex;
-      _colorIndexMap[hashBg] = _colorGlobalIndex++;
-      init_color(bg.ColorIndex, bg.R, bg.G, bg.B);
-    }
-    else
+    if (!ColorIndexExists(htmlColorBg))
     {
-      bg.ColorIndex = _colorIndexMap[hashBg];
+      _colorIndexMap[htmlColorBg] = _colorGlobalIndex++;
+      init_color(_colorIndexMap[htmlColorBg], bg.R, bg.G, bg.B);
     }
 
+    fg.ColorIndex = _colorIndexMap[htmlColorFg];
+    bg.ColorIndex = _colorIndexMap[htmlColorBg];
+
     ColorPair cp = { fg, bg, _colorPairsGlobalIndex++ };
-    _colorMap[hash] = cp;
 
-    init_pair(_colorMap[hash].PairIndex,
-              _colorIndexMap[hashFg],
-              _colorIndexMap[hashBg]);
+    it = _colorMap.emplace(key, cp).first;
+
+    init_pair(cp.PairIndex, fg.ColorIndex, bg.ColorIndex);
   }
 
-  return hash;
+  _lastColorKey  = key;
+  _lastColorPair = it->second.PairIndex;
+
+  return _lastColorPair;
 }
 
 // =============================================================================
@@ -760,12 +798,14 @@ void Printer::Print(const int& x,
                     const uint32_t& htmlColorFg,
                     const uint32_t& htmlColorBg)
 {
-  size_t hash = GetOrSetColor(htmlColorFg, htmlColorBg);
+  short pair = GetOrSetColor(htmlColorFg, htmlColorBg);
   auto textPos = AlignText(x, y, align, text);
 
-  attron(COLOR_PAIR(_colorMap[hash].PairIndex));
+  attron(COLOR_PAIR(pair));
   mvprintw(textPos.first, textPos.second, text.data());
-  attroff(COLOR_PAIR(_colorMap[hash].PairIndex));
+  attroff(COLOR_PAIR(pair));
+
+  InvalidateScreenBuffer();
 }
 
 // =============================================================================
@@ -776,11 +816,13 @@ void Printer::Print(const int& x,
                     const uint32_t& htmlColorFg,
                     const uint32_t& htmlColorBg)
 {
-  size_t hash = GetOrSetColor(htmlColorFg, htmlColorBg);
+  short pair = GetOrSetColor(htmlColorFg, htmlColorBg);
 
-  attron(COLOR_PAIR(_colorMap[hash].PairIndex));
+  attron(COLOR_PAIR(pair));
   mvaddch(y, x, ch);
-  attroff(COLOR_PAIR(_colorMap[hash].PairIndex));
+  attroff(COLOR_PAIR(pair));
+
+  InvalidateScreenBuffer();
 }
 
 // =============================================================================
@@ -829,16 +871,18 @@ void Printer::PrintFB(const int& x, const int& y,
     tmpBg = Colors::BlackColor;
   }
 
-  size_t hash = GetOrSetColor(tmpFg, tmpBg);
+  short pair = GetOrSetColor(tmpFg, tmpBg);
 
   #else
 
-  size_t hash = GetOrSetColor(htmlColorFg, htmlColorBg);
+  short pair = GetOrSetColor(htmlColorFg, htmlColorBg);
 
   #endif
 
-  _frameBuffer[x][y].Character = ch;
-  _frameBuffer[x][y].ColorPairHash = hash;
+  FBPixel& p = _frameBuffer[y * TerminalWidth + x];
+
+  p.Character = ch;
+  p.ColorPair = pair;
 }
 
 // =============================================================================
@@ -983,21 +1027,22 @@ void Printer::DrawWindow(const Position& leftCorner,
 
 void Printer::PrepareFrameBuffer()
 {
-  for (size_t x = 0; x < TerminalWidth; x++)
-  {
-    std::vector<FBPixel> row;
+  FBPixel empty;
 
-    for (size_t y = 0; y < TerminalHeight; y++)
-    {
-      FBPixel s;
+  empty.ColorPair = -1;
+  empty.Character = ' ';
 
-      s.ColorPairHash = -1;
-      s.Character = ' ';
+  _frameBuffer.assign(TerminalWidth * TerminalHeight, empty);
+  _screenBuffer.assign(TerminalWidth * TerminalHeight, empty);
+}
 
-      row.push_back(s);
-    }
+// =============================================================================
 
-    _frameBuffer.push_back(row);
+void Printer::InvalidateScreenBuffer()
+{
+  for (auto& p : _screenBuffer)
+  {
+    p.ColorPair = -1;
   }
 }
 #endif
@@ -1007,14 +1052,18 @@ void Printer::PrepareFrameBuffer()
 void Printer::Clear()
 {
 #ifndef USE_SDL
-  for (size_t x = 0; x < TerminalWidth; x++)
-  {
-    for (size_t y = 0; y < TerminalHeight; y++)
-    {
-      PrintFB(x, y, ' ', Colors::BlackColor, Colors::BlackColor);
-    }
-  }
+  FBPixel empty;
+
+  empty.ColorPair = GetOrSetColor(Colors::BlackColor, Colors::BlackColor);
+  empty.Character = ' ';
+
+  std::fill(_frameBuffer.begin(), _frameBuffer.end(), empty);
 #else
+  //
+  // Whatever was queued before is going to be cleared anyway.
+  //
+  _tileQuads.clear();
+
   SDL_SetRenderTarget(Application::Instance().Renderer, _frameBuffer);
   SDL_RenderClear(Application::Instance().Renderer);
 #endif
@@ -1024,19 +1073,54 @@ void Printer::Clear()
 
 void Printer::Render()
 {
+  PROFILE_ZONE(ProfilerZone::PRINTER_RENDER);
+
 #ifndef USE_SDL
-  for (size_t x = 0; x < TerminalWidth; x++)
+  //
+  // Output only cells that changed since last frame,
+  // grouping consecutive cells of the same color pair in a row
+  // so that there's one attron() / move() per such run.
+  //
+  for (size_t y = 0; y < TerminalHeight; y++)
   {
-    for (size_t y = 0; y < TerminalHeight; y++)
+    size_t rowStart = y * TerminalWidth;
+
+    size_t x = 0;
+    while (x < TerminalWidth)
     {
-      attron(COLOR_PAIR(_colorMap[_frameBuffer[x][y].ColorPairHash].PairIndex));
-      mvaddch(y, x, _frameBuffer[x][y].Character);
-      attroff(COLOR_PAIR(_colorMap[_frameBuffer[x][y].ColorPairHash].PairIndex));
+      size_t index = rowStart + x;
+
+      if (_frameBuffer[index] == _screenBuffer[index])
+      {
+        x++;
+        continue;
+      }
+
+      short pair = _frameBuffer[index].ColorPair;
+
+      attron(COLOR_PAIR(pair));
+      move(y, x);
+
+      while (x < TerminalWidth
+          && _frameBuffer[index] != _screenBuffer[index]
+          && _frameBuffer[index].ColorPair == pair)
+      {
+        addch(_frameBuffer[index].Character);
+
+        _screenBuffer[index] = _frameBuffer[index];
+
+        x++;
+        index++;
+      }
+
+      attroff(COLOR_PAIR(pair));
     }
   }
 
   refresh();
 #else
+  FlushTiles();
+
   SDL_SetRenderTarget(Application::Instance().Renderer, nullptr);
   SDL_RenderClear(Application::Instance().Renderer);
   SDL_RenderCopy(Application::Instance().Renderer,
@@ -1049,36 +1133,69 @@ void Printer::Render()
 
 // =============================================================================
 
+void Printer::SaveFrame()
+{
+#ifndef USE_SDL
+  _savedFrameBuffer = _frameBuffer;
+#else
+  FlushTiles();
+
+  SDL_Renderer* renderer = Application::Instance().Renderer;
+
+  SDL_SetRenderTarget(renderer, _savedFrame);
+  SDL_RenderCopy(renderer, _frameBuffer, nullptr, nullptr);
+  SDL_SetRenderTarget(renderer, _frameBuffer);
+#endif
+}
+
+// =============================================================================
+
+void Printer::RestoreFrame()
+{
+#ifndef USE_SDL
+  if (_savedFrameBuffer.size() == _frameBuffer.size())
+  {
+    _frameBuffer = _savedFrameBuffer;
+  }
+#else
+  _tileQuads.clear();
+
+  SDL_Renderer* renderer = Application::Instance().Renderer;
+
+  SDL_SetRenderTarget(renderer, _frameBuffer);
+  SDL_RenderCopy(renderer, _savedFrame, nullptr, nullptr);
+#endif
+}
+
+// =============================================================================
+
 std::vector<Position> Printer::DrawExplosion(const Position& pos, int aRange)
 {
   std::vector<Position> cellsAffected =
       Util::GetAreaDamagePointsFrom(pos, aRange);
 
+  AnimationTrack track;
+
   for (int range = 1; range <= aRange; range++)
   {
+    AnimationFrame frame;
+
+    frame.DurationMs = 20;
+
     auto res = Util::GetAreaDamagePointsFrom(pos, range);
     for (auto& p : res)
     {
-      int drawX = p.X + Map::Instance().CurrentLevel->MapOffsetX;
-      int drawY = p.Y + Map::Instance().CurrentLevel->MapOffsetY;
-
-      if (Map::Instance().CurrentLevel->MapArray[p.X][p.Y]->Visible)
+      if (Map::Instance().CurrentLevel->Tiles.IsVisible(p.X, p.Y))
       {
-        Printer::Instance().PrintFB(drawX,
-                                    drawY,
-                                    'x',
-                                    Colors::RedColor,
-                                    Colors::BlackColor);
+        frame.Cells.push_back({ p, 'x', Colors::RedColor, Colors::BlackColor });
       }
     }
 
-    Printer::Instance().Render();
-
-    Util::Sleep(20);
-
-    Application::Instance().ForceDrawMainState();
+    track.push_back(frame);
   }
 
+  AnimationTimeline::Instance().AddTrack(track);
+
   return cellsAffected;
 }
 
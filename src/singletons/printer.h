@@ -29,11 +29,32 @@ struct TileInfo
   int X = 0;
   int Y = 0;
 };
+
+struct TileQuad
+{
+  SDL_Rect Src;
+  SDL_Rect Dst;
+  uint32_t Color;
+};
 #else
 struct FBPixel
 {
-  size_t ColorPairHash;
+  //
+  // ncurses color pair index, -1 means "unknown"
+  // (forces cell to be redrawn).
+  //
+  short ColorPair;
   int Character;
+
+  bool operator== (const FBPixel& rhs) const
+  {
+    return (ColorPair == rhs.ColorPair && Character == rhs.Character);
+  }
+
+  bool operator!= (const FBPixel& rhs) const
+  {
+    return !(*this == rhs);
+  }
 };
 #endif
 
@@ -66,6 +87,14 @@ class Printer : public Singleton<Printer>
     /// Call this after all PrintFB calls
     void Render();
 
+    //
+    // Remember framebuffer contents to draw something temporary
+    // over it and get back to it later without redrawing everything
+    // (see AnimationTimeline).
+    //
+    void SaveFrame();
+    void RestoreFrame();
+
 #ifndef USE_SDL
     /// Print text at (x, y) directly to the screen,
     /// with (0, 0) at upper left corner and y increases down
@@ -101,7 +130,7 @@ class Printer : public Singleton<Printer>
                     const uint32_t& borderBgColor = Colors::BlackColor,
                     const uint32_t& bgColor = Colors::BlackColor);
 
-    const std::unordered_map<size_t, ColorPair>& GetValidColorsCache();
+    const std::unordered_map<uint64_t, ColorPair>& GetValidColorsCache();
 #else
     void PrintFB(const int& x, const int& y,
                  int image,
@@ -181,12 +210,16 @@ class Printer : public Singleton<Printer>
 
   private:
     #ifndef USE_SDL
-    bool ContainsColorMap(size_t hashToCheck);
-    bool ColorIndexExists(size_t hashToCheck);
+    bool ContainsColorMap(uint64_t keyToCheck);
+    bool ColorIndexExists(uint32_t htmlColor);
 
     NColor GetNColor(const uint32_t& htmlColor);
-    size_t GetOrSetColor(const uint32_t& htmlColorFg,
-                         const uint32_t& htmlColorBg);
+
+    //
+    // Returns ncurses color pair index.
+    //
+    short GetOrSetColor(const uint32_t& htmlColorFg,
+                        const uint32_t& htmlColorBg);
     std::pair<int, int> AlignText(int x,
                                   int y,
                                   int align,
@@ -194,13 +227,36 @@ class Printer : public Singleton<Printer>
 
     void PrepareFrameBuffer();
 
-    std::unordered_map<size_t, ColorPair> _colorMap;
-    std::unordered_map<size_t, short> _colorIndexMap;
+    //
+    // For when something was printed bypassing frame buffer.
+    //
+    void InvalidateScreenBuffer();
+
+    //
+    // Key is fg color in high 32 bits and bg color in low 32 bits.
+    //
+    std::unordered_map<uint64_t, ColorPair> _colorMap;
+    std::unordered_map<uint32_t, short> _colorIndexMap;
 
     short _colorPairsGlobalIndex = 1;
     short _colorGlobalIndex = 8;
 
-    std::vector<std::vector<FBPixel>> _frameBuffer;
+    //
+    // Consecutive PrintFB() calls mostly use the same colors.
+    //
+    uint64_t _lastColorKey  = 0;
+    short    _lastColorPair = -1;
+
+    //
+    // Both are [y * TerminalWidth + x].
+    // _frameBuffer is what is being drawn this frame,
+    // _screenBuffer is what was sent to the terminal last time,
+    // so that Render() outputs only cells that differ.
+    //
+    std::vector<FBPixel> _frameBuffer;
+    std::vector<FBPixel> _screenBuffer;
+
+    std::vector<FBPixel> _savedFrameBuffer;
     #endif
 
     bool _ok = false;
@@ -220,6 +276,7 @@ class Printer : public Singleton<Printer>
     #else
     SDL_Texture* _tileset = nullptr;
     SDL_Texture* _frameBuffer = nullptr;
+    SDL_Texture* _savedFrame  = nullptr;
 
     int _tilesetWidth  = 0;
     int _tilesetHeight = 0;
@@ -245,16 +302,33 @@ class Printer : public Singleton<Printer>
 
     SDL_Rect _renderDst;
 
+    //
+    // Everything drawn during the frame is queued here
+    // in the order of PrintFB() calls and sent to the renderer
+    // in one go by FlushTiles() (see Render()).
+    //
+    std::vector<TileQuad> _tileQuads;
+
+    #if SDL_VERSION_ATLEAST(2, 0, 18)
+    std::vector<SDL_Vertex> _vertices;
+    std::vector<int> _indices;
+    #endif
+
     bool InitForSDL();
 
-    void DrawTile(int x, int y, int tileIndex);
-    void DrawTile(int x, int y, int tileIndex, size_t scale);
+    void DrawTile(int x, int y, int tileIndex, const uint32_t& htmlColor);
+    void DrawTile(int x, int y, int tileIndex, size_t scale,
+                  const uint32_t& htmlColor);
+
+    void FlushTiles();
 
     //
     // Here lies data after last ConvertHtmlToRGB() call.
     //
     TileColor _convertedHtml;
 
+    uint32_t _lastConvertedColor = 0;
+
     void ConvertHtmlToRGB(const uint32_t& htmlColor);
     #endif
 
@@ -0,0 +1,426 @@
+#include "profiler.h"
+
+#include "util.h"
+
+#include <map>
+#include <limits>
+#include <fstream>
+
+const std::array<const char*, Profiler::kZonesCount> Profiler::kZoneNames =
+{
+  "Map::Update",
+  "UpdateGameObjects",
+  "UpdateActors",
+  "UpdateTriggers",
+  "RemoveDestroyed",
+  "MainState::Update",
+  "Player::CheckVisibility",
+  "Map::Draw",
+  "DrawMapTilesAroundPlayer",
+  "DrawGameObjects",
+  "DrawActors",
+  "PrintDebugInfo",
+  "Printer::Render"
+};
+
+// =============================================================================
+
+void Profiler::InitSpecific()
+{
+  _epoch = Clock::now();
+
+  for (auto& frame : _frames)
+  {
+    frame.Events.reserve(64);
+  }
+}
+
+// =============================================================================
+
+const char* Profiler::GetZoneName(ProfilerZone zone)
+{
+  return kZoneNames[(size_t)zone];
+}
+
+// =============================================================================
+
+void Profiler::SetEnabled(bool enabled)
+{
+  //
+  // Don't leave frame half recorded.
+  //
+  if (_inFrame)
+  {
+    return;
+  }
+
+  _enabled = enabled;
+}
+
+// =============================================================================
+
+bool Profiler::IsEnabled()
+{
+  return _enabled;
+}
+
+// =============================================================================
+
+int64_t Profiler::Now()
+{
+  return FT::duration_cast<Ns>(Clock::now() - _epoch).count();
+}
+
+// =============================================================================
+
+const Profiler::FrameData& Profiler::GetCompletedFrame(size_t index)
+{
+  size_t oldest = (_head + kMaxFrames - _framesTotal) % kMaxFrames;
+  return _frames[(oldest + index) % kMaxFrames];
+}
+
+// =============================================================================
+
+void Profiler::BeginFrame()
+{
+  if (!_enabled)
+  {
+    return;
+  }
+
+  //
+  // When history is full, the oldest frame is overwritten,
+  // so it's not a completed one anymore.
+  //
+  if (_framesTotal == kMaxFrames)
+  {
+    _framesTotal--;
+  }
+
+  FrameData& frame = _frames[_head];
+
+  frame.Index      = _framesCounter;
+  frame.StartNs    = Now();
+  frame.DurationNs = 0;
+
+  frame.ZoneTotalNs.fill(0);
+  frame.ZoneCalls.fill(0);
+
+  frame.Events.clear();
+
+  _depth        = 0;
+  _skippedDepth = 0;
+
+  _inFrame = true;
+}
+
+// =============================================================================
+
+void Profiler::EndFrame()
+{
+  if (!_inFrame)
+  {
+    return;
+  }
+
+  _inFrame = false;
+
+  FrameData& frame = _frames[_head];
+
+  //
+  // Most of the time game just waits for input,
+  // no point in filling history with empty frames.
+  //
+  if (frame.Events.empty())
+  {
+    return;
+  }
+
+  frame.DurationNs = Now() - frame.StartNs;
+
+  _framesCounter++;
+
+  _head = (_head + 1) % kMaxFrames;
+
+  if (_framesTotal < kMaxFrames)
+  {
+    _framesTotal++;
+  }
+}
+
+// =============================================================================
+
+void Profiler::EnterZone(ProfilerZone zone)
+{
+  if (!_inFrame)
+  {
+    return;
+  }
+
+  if (_depth == kMaxDepth)
+  {
+    _skippedDepth++;
+    return;
+  }
+
+  FrameData& frame = _frames[_head];
+
+  OpenZone& oz = _stack[_depth];
+
+  oz.Zone       = zone;
+  oz.EventIndex = kNoParent;
+  oz.StartNs    = Now();
+
+  if (frame.Events.size() < kMaxEventsPerFrame)
+  {
+    ZoneEvent e;
+    e.Zone    = zone;
+    e.Parent  = (_depth == 0) ? kNoParent : _stack[_depth - 1].EventIndex;
+    e.StartNs = oz.StartNs;
+
+    oz.EventIndex = (int16_t)frame.Events.size();
+
+    frame.Events.push_back(e);
+  }
+
+  _depth++;
+}
+
+// =============================================================================
+
+void Profiler::LeaveZone()
+{
+  if (!_inFrame)
+  {
+    return;
+  }
+
+  if (_skippedDepth != 0)
+  {
+    _skippedDepth--;
+    return;
+  }
+
+  if (_depth == 0)
+  {
+    return;
+  }
+
+  _depth--;
+
+  const OpenZone& oz = _stack[_depth];
+
+  int64_t dur = Now() - oz.StartNs;
+
+  FrameData& frame = _frames[_head];
+
+  size_t zi = (size_t)oz.Zone;
+
+  frame.ZoneTotalNs[zi] += dur;
+  frame.ZoneCalls[zi]++;
+
+  if (oz.EventIndex != kNoParent)
+  {
+    frame.Events[oz.EventIndex].DurationNs = dur;
+  }
+}
+
+// =============================================================================
+
+Profiler::ZoneStats Profiler::GetZoneStats(ProfilerZone zone)
+{
+  ZoneStats res;
+
+  size_t zi = (size_t)zone;
+
+  int64_t minNs = std::numeric_limits<int64_t>::max();
+  int64_t maxNs = 0;
+  int64_t sumNs = 0;
+
+  for (size_t i = 0; i < _framesTotal; i++)
+  {
+    const FrameData& frame = GetCompletedFrame(i);
+
+    if (frame.ZoneCalls[zi] == 0)
+    {
+      continue;
+    }
+
+    int64_t t = frame.ZoneTotalNs[zi];
+
+    minNs = std::min(minNs, t);
+    maxNs = std::max(maxNs, t);
+    sumNs += t;
+
+    res.Calls += frame.ZoneCalls[zi];
+    res.Frames++;
+  }
+
+  if (res.Frames != 0)
+  {
+    res.MinMs = (double)minNs / 1000000.0;
+    res.MaxMs = (double)maxNs / 1000000.0;
+    res.AvgMs = ((double)sumNs / (double)res.Frames) / 1000000.0;
+  }
+
+  return res;
+}
+
+// =============================================================================
+
+StringV Profiler::GetReport()
+{
+  StringV res;
+
+  res.push_back(Util::StringFormat("Last %zu frames "
+                                   "(min / avg / max ms, calls):",
+                                   _framesTotal));
+
+  for (size_t i = 0; i < kZonesCount; i++)
+  {
+    ZoneStats zs = GetZoneStats((ProfilerZone)i);
+    if (zs.Frames == 0)
+    {
+      continue;
+    }
+
+    res.push_back(Util::StringFormat("  %-26s %8.3f %8.3f %8.3f  %llu",
+                                     kZoneNames[i],
+                                     zs.MinMs,
+                                     zs.AvgMs,
+                                     zs.MaxMs,
+                                     (unsigned long long)zs.Calls));
+  }
+
+  return res;
+}
+
+// =============================================================================
+
+std::string Profiler::GetStackPath(const FrameData& frame, int16_t eventIndex)
+{
+  std::string res;
+
+  while (eventIndex != kNoParent)
+  {
+    const ZoneEvent& e = frame.Events[eventIndex];
+
+    res.insert(0, GetZoneName(e.Zone));
+    res.insert(0, ";");
+
+    eventIndex = e.Parent;
+  }
+
+  res.insert(0, "Frame");
+
+  return res;
+}
+
+// =============================================================================
+
+bool Profiler::WriteChromeTrace(const std::string& fname)
+{
+  std::ofstream f(fname);
+  if (!f.is_open())
+  {
+    return false;
+  }
+
+  f << "[\n";
+
+  bool first = true;
+
+  auto writeEvent = [&f, &first](const std::string& name,
+                                 int64_t startNs,
+                                 int64_t durationNs)
+  {
+    if (!first)
+    {
+      f << ",\n";
+    }
+
+    first = false;
+
+    f << Util::StringFormat("{ \"name\": \"%s\", \"ph\": \"X\", "
+                            "\"ts\": %.3f, \"dur\": %.3f, "
+                            "\"pid\": 0, \"tid\": 0 }",
+                            name.data(),
+                            (double)startNs / 1000.0,
+                            (double)durationNs / 1000.0);
+  };
+
+  for (size_t i = 0; i < _framesTotal; i++)
+  {
+    const FrameData& frame = GetCompletedFrame(i);
+
+    writeEvent(Util::StringFormat("Frame %llu",
+                                  (unsigned long long)frame.Index),
+               frame.StartNs,
+               frame.DurationNs);
+
+    for (auto& e : frame.Events)
+    {
+      writeEvent(GetZoneName(e.Zone), e.StartNs, e.DurationNs);
+    }
+  }
+
+  f << "\n]\n";
+
+  return true;
+}
+
+// =============================================================================
+
+bool Profiler::WriteFoldedStacks(const std::string& fname)
+{
+  std::ofstream f(fname);
+  if (!f.is_open())
+  {
+    return false;
+  }
+
+  //
+  // Self time in nanoseconds by stack path.
+  //
+  std::map<std::string, int64_t> selfTimeByPath;
+
+  std::vector<int64_t> childrenNs;
+
+  for (size_t i = 0; i < _framesTotal; i++)
+  {
+    const FrameData& frame = GetCompletedFrame(i);
+
+    childrenNs.assign(frame.Events.size(), 0);
+
+    int64_t frameChildrenNs = 0;
+
+    for (auto& e : frame.Events)
+    {
+      if (e.Parent == kNoParent)
+      {
+        frameChildrenNs += e.DurationNs;
+      }
+      else
+      {
+        childrenNs[e.Parent] += e.DurationNs;
+      }
+    }
+
+    selfTimeByPath["Frame"] += (frame.DurationNs - frameChildrenNs);
+
+    for (size_t j = 0; j < frame.Events.size(); j++)
+    {
+      const ZoneEvent& e = frame.Events[j];
+      selfTimeByPath[GetStackPath(frame, (int16_t)j)] +=
+          (e.DurationNs - childrenNs[j]);
+    }
+  }
+
+  for (auto& kvp : selfTimeByPath)
+  {
+    int64_t us = std::max(kvp.second, (int64_t)0) / 1000;
+    f << kvp.first << " " << us << "\n";
+  }
+
+  return true;
+}
@@ -0,0 +1,203 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <array>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "singleton.h"
+#include "constants.h"
+#include "timer.h"
+
+//
+// Every profiled scope has its ID known at compile time,
+// so no strings are hashed or copied during the frame.
+// Don't forget to add zone name to Profiler::kZoneNames.
+//
+enum class ProfilerZone : uint8_t
+{
+  MAP_UPDATE = 0,
+  UPDATE_GAME_OBJECTS,
+  UPDATE_ACTORS,
+  UPDATE_TRIGGERS,
+  REMOVE_DESTROYED,
+  MAIN_STATE_UPDATE,
+  CHECK_VISIBILITY,
+  MAP_DRAW,
+  DRAW_MAP_TILES,
+  DRAW_GAME_OBJECTS,
+  DRAW_ACTORS,
+  PRINT_DEBUG_INFO,
+  PRINTER_RENDER,
+  LAST
+};
+
+//
+// Collects nested timings of profiled scopes (see PROFILE_ZONE below)
+// for every frame of Application::Run() and keeps the last kMaxFrames
+// of them in a ring buffer.
+//
+// Disabled by default, can be turned on with "profiler : 1" in config.
+// When disabled, profiled scope costs one bool check.
+//
+class Profiler : public Singleton<Profiler>
+{
+  public:
+    static constexpr size_t kZonesCount = (size_t)ProfilerZone::LAST;
+
+    struct ZoneStats
+    {
+      //
+      // Per frame totals in milliseconds
+      // over frames where zone was entered at least once.
+      //
+      double MinMs = 0.0;
+      double AvgMs = 0.0;
+      double MaxMs = 0.0;
+
+      uint64_t Calls  = 0;
+      size_t   Frames = 0;
+    };
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled();
+
+    void BeginFrame();
+    void EndFrame();
+
+    void EnterZone(ProfilerZone zone);
+    void LeaveZone();
+
+    ZoneStats GetZoneStats(ProfilerZone zone);
+
+    StringV GetReport();
+
+    //
+    // JSON array of complete events,
+    // can be opened in chrome://tracing or Perfetto.
+    //
+    bool WriteChromeTrace(const std::string& fname);
+
+    //
+    // One "Frame;Parent;Child <self time in us>" line per unique stack,
+    // can be fed to flamegraph.pl, speedscope etc.
+    //
+    bool WriteFoldedStacks(const std::string& fname);
+
+    static const char* GetZoneName(ProfilerZone zone);
+
+  protected:
+    void InitSpecific() override;
+
+  private:
+    static constexpr size_t kMaxFrames = 128;
+    static constexpr size_t kMaxDepth  = 32;
+
+    //
+    // Zones beyond that still go into per frame totals
+    // but are not recorded as separate events.
+    //
+    static constexpr size_t kMaxEventsPerFrame = 4096;
+
+    static constexpr int16_t kNoParent = -1;
+
+    static const std::array<const char*, kZonesCount> kZoneNames;
+
+    struct ZoneEvent
+    {
+      ProfilerZone Zone;
+      int16_t  Parent = kNoParent;
+      int64_t  StartNs    = 0;
+      int64_t  DurationNs = 0;
+    };
+
+    struct FrameData
+    {
+      uint64_t Index      = 0;
+      int64_t  StartNs    = 0;
+      int64_t  DurationNs = 0;
+
+      std::array<int64_t,  kZonesCount> ZoneTotalNs;
+      std::array<uint32_t, kZonesCount> ZoneCalls;
+
+      std::vector<ZoneEvent> Events;
+    };
+
+    struct OpenZone
+    {
+      ProfilerZone Zone;
+      int16_t EventIndex = kNoParent;
+      int64_t StartNs    = 0;
+    };
+
+    bool _enabled = false;
+    bool _inFrame = false;
+
+    Clock::time_point _epoch;
+
+    uint64_t _framesCounter = 0;
+
+    //
+    // Frame currently being recorded is always _frames[_head],
+    // _framesTotal completed ones are right before it.
+    //
+    std::array<FrameData, kMaxFrames> _frames;
+    size_t _head        = 0;
+    size_t _framesTotal = 0;
+
+    std::array<OpenZone, kMaxDepth> _stack;
+    size_t _depth = 0;
+
+    //
+    // Zones entered deeper than kMaxDepth are skipped,
+    // but their LeaveZone() must be skipped as well.
+    //
+    size_t _skippedDepth = 0;
+
+    int64_t Now();
+
+    //
+    // Oldest completed frame has index 0.
+    //
+    const FrameData& GetCompletedFrame(size_t index);
+
+    std::string GetStackPath(const FrameData& frame, int16_t eventIndex);
+};
+
+// =============================================================================
+
+class ProfileScope
+{
+  public:
+    explicit ProfileScope(ProfilerZone zone)
+      : _active(Profiler::Instance().IsEnabled())
+    {
+      if (_active)
+      {
+        Profiler::Instance().EnterZone(zone);
+      }
+    }
+
+    ~ProfileScope()
+    {
+      if (_active)
+      {
+        Profiler::Instance().LeaveZone();
+      }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+  private:
+    bool _active = false;
+};
+
+#define PROFILE_ZONE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b)      PROFILE_ZONE_CONCAT_IMPL(a, b)
+
+#define PROFILE_ZONE(zone) \
+  ProfileScope PROFILE_ZONE_CONCAT(profileScope_, __LINE__)(zone)
+
+#endif // PROFILER_H
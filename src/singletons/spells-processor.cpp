@@ -464,7 +464,7 @@ void SpellsProcessor::ProcessScrollOfMM(ItemComponent* scroll, GameObject* user)
     {
       for (int y = 0; y < mapRef->MapSize.Y; y++)
       {
-        mapRef->MapArray[x][y]->Revealed = false;
+        mapRef->Tiles.SetRevealed(x, y, false);
       }
     }
 
@@ -478,7 +478,7 @@ void SpellsProcessor::ProcessScrollOfMM(ItemComponent* scroll, GameObject* user)
     {
       for (int y = 0; y < mapRef->MapSize.Y; y++)
       {
-        mapRef->MapArray[x][y]->Revealed = true;
+        mapRef->Tiles.SetRevealed(x, y, true);
       }
     }
 
@@ -612,7 +612,7 @@ void SpellsProcessor::ProcessScrollOfTownPortal(ItemComponent* scroll,
 
   if (ind != -1)
   {
-    lvl->GameObjects.erase(lvl->GameObjects.begin() + ind);
+    lvl->EraseGameObject(ind);
   }
 
   if (scroll->Data.Prefix == ItemPrefix::BLESSED)
@@ -135,10 +135,11 @@ void AttackState::HandleInput()
       }
       else
       {
-        auto& ma = Map::Instance().CurrentLevel->MapArray;
-        auto* cell = ma[_cursorPosition.X][_cursorPosition.Y].get();
+        auto& tiles = Map::Instance().CurrentLevel->Tiles;
+        auto cell = tiles.MakeTileObject(_cursorPosition.X,
+                                         _cursorPosition.Y);
         Application::Instance().DisplayAttack(
-              cell,
+              cell.get(),
               GlobalConstants::DisplayAttackDelayMs,
               "*whoosh*",
               Colors::WhiteColor
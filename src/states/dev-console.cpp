@@ -837,9 +837,10 @@ void DevConsole::GetObjectById(const std::vector<std::string>& params)
 
   uint64_t id = std::stoull(str);
 
-  if (GameObjectsById.count(id) == 1)
+  GameObject* go = GameObjectsRegistry::Instance().FindById(id);
+  if (go != nullptr)
   {
-    _objectHandles[ObjectHandleType::ANY] = GameObjectsById[id];
+    _objectHandles[ObjectHandleType::ANY] = go;
     ReportHandle(ObjectHandleType::ANY);
   }
   else
@@ -910,7 +911,7 @@ void DevConsole::TransformTile(const std::vector<std::string>& params)
     return;
   }
 
-  _currentLevel->MapArray[x][y]->Type = newTileType;
+  _currentLevel->Tiles.SetType(x, y, newTileType);
 
   switch (newTileType)
   {
@@ -1554,6 +1555,8 @@ void DevConsole::MoveObject(const std::vector<std::string>& params,
       _currentLevel->StaticMapObjects[x][y]->PosX = x;
       _currentLevel->StaticMapObjects[x][y]->PosY = y;
 
+      _currentLevel->LayoutVersion++;
+
       _objectHandles[handleType] = _currentLevel->StaticMapObjects[x][y].get();
     }
     break;
@@ -1817,10 +1820,10 @@ void DevConsole::TogglePlayerIgnore()
 void DevConsole::PrintTriggers()
 {
   auto out = Util::StringFormat("Triggers on this level: %u",
-                                _currentLevel->FinishTurnTriggers.size());
+                                _currentLevel->Triggers.size());
   StdOut(out);
 
-  for (auto& t : _currentLevel->FinishTurnTriggers)
+  for (auto& t : _currentLevel->Triggers)
   {
     auto str = Util::StringFormat("0x%X at %i %i", t.get(), t->PosX, t->PosY);
     StdOut(str);
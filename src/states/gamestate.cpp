@@ -29,10 +29,17 @@ int GameState::GetKeyDown()
   SDL_Event evt;
 
   //
-  // SDL_WaitEvent() cannot be used because we have animations (we do, lol).
+  // Sleep until there's something in the event queue
+  // (or until it's time to draw next animation frame),
+  // then process everything that has arrived.
   //
+  int timeoutMs = GetInputTimeoutMs();
+  if (timeoutMs != 0)
+  {
+    SDL_WaitEventTimeout(nullptr, timeoutMs);
+  }
+
   while (SDL_PollEvent(&evt))
-  //if (SDL_WaitEvent(&evt))
   {
     switch(evt.type)
     {
@@ -114,6 +121,12 @@ int GameState::GetKeyDown()
 #else
 int GameState::GetKeyDown()
 {
+  //
+  // Negative value makes getch() blocking,
+  // terminal resize will wake it up with KEY_RESIZE.
+  //
+  timeout(GetInputTimeoutMs());
+
   return getch();
 }
 #endif
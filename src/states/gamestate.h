@@ -51,6 +51,15 @@ class GameState
     //
     virtual void Update(bool forceUpdate = false) = 0;
 
+    //
+    // How long GetKeyDown() may wait for input before returning -1.
+    // Negative value means wait until something happens,
+    // so idle game doesn't spin the CPU for nothing.
+    // States that animate something on their own
+    // should return animation step delay while animation is running.
+    //
+    virtual int GetInputTimeoutMs() { return -1; }
+
     //
     // Driven by corresponding backend (ncurses or SDL2).
     //
@@ -11,6 +11,8 @@ void IntroState::Prepare()
   _textPositionCursor = 0;
   _textPositionX = _twHalf;
 
+  _textPrinted = false;
+
   int textIndex = Application::Instance().PlayerInstance.SelectedClass;
   _textPositionY = _thHalf - _introStrings[textIndex].size() / 2;
 
@@ -36,6 +38,13 @@ void IntroState::HandleInput()
 
 // =============================================================================
 
+int IntroState::GetInputTimeoutMs()
+{
+  return _textPrinted ? -1 : 10;
+}
+
+// =============================================================================
+
 void IntroState::Update(bool forceUpdate)
 {
   int pci = Application::Instance().PlayerInstance.SelectedClass;
@@ -111,6 +120,8 @@ void IntroState::Update(bool forceUpdate)
                                   Printer::kAlignCenter,
                                   Colors::WhiteColor,
                                   Colors::BlackColor);
+
+      _textPrinted = true;
     }
 
     Printer::Instance().Render();
@@ -19,6 +19,8 @@ class IntroState : public GameState
     void Update(bool forceUpdate = false) override;
     void HandleInput() override;
 
+    int GetInputTimeoutMs() override;
+
   private:
     std::vector<std::vector<std::string>> _introStrings =
     {
@@ -66,6 +68,8 @@ class IntroState : public GameState
     size_t _stringIndex        = 0;
     size_t _textPositionCursor = 0;
 
+    bool _textPrinted = false;
+
     int _textPositionX = 0;
     int _textPositionY = 0;
 
@@ -182,7 +182,10 @@ void LookInputState::Update(bool forceUpdate)
 
     if (Util::CheckLimits(_cursorPosition, { mapSizeX, mapSizeY }))
     {
-      auto tile = curLvl->MapArray[_cursorPosition.X][_cursorPosition.Y].get();
+      int cx = _cursorPosition.X;
+      int cy = _cursorPosition.Y;
+
+      bool tileVisible = curLvl->Tiles.IsVisible(cx, cy);
 
       bool foundGameObject = false;
 
@@ -197,7 +200,7 @@ void LookInputState::Update(bool forceUpdate)
         // If tile is visible, check if game objects are present on it:
         // actors or items.
         //
-        if (tile->Visible)
+        if (tileVisible)
         {
           auto actor = CheckActor();
           if (actor != nullptr)
@@ -274,7 +277,7 @@ void LookInputState::Update(bool forceUpdate)
 
           //
           // No objects found on this tile,
-          // get static object or map array object name as name to display.
+          // get static object or ground tile name as name to display.
           //
           if (!foundGameObject)
           {
@@ -283,7 +286,7 @@ void LookInputState::Update(bool forceUpdate)
 
             lookStatus = (staticObj != nullptr)
                          ? staticObj->ObjectName
-                         : tile->ObjectName;
+                         : curLvl->Tiles.GetName(cx, cy);
           }
         }
         else
@@ -293,7 +296,7 @@ void LookInputState::Update(bool forceUpdate)
           // so get its last known name if it was revealed earlier.
           //
           lookStatus =
-              tile->Revealed
+              curLvl->Tiles.IsRevealed(cx, cy)
               ? curLvl->FowLayer[_cursorPosition.X][_cursorPosition.Y].FowName
               : Strings::TripleQuestionMarks;
         }
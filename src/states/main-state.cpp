@@ -7,7 +7,7 @@
 #include "target-state.h"
 #include "spells-processor.h"
 #include "pickup-item-state.h"
-#include "timer.h"
+#include "profiler.h"
 
 void MainState::Init()
 {
@@ -225,6 +225,8 @@ void MainState::Update(bool forceUpdate)
 {
   if (_keyPressed != -1 || forceUpdate)
   {
+    PROFILE_ZONE(ProfilerZone::MAIN_STATE_UPDATE);
+
     Printer::Instance().Clear();
 
     _playerRef->CheckVisibility();
@@ -255,9 +257,10 @@ void MainState::Update(bool forceUpdate)
                                 Colors::BlackColor);
 
     #ifdef DEBUG_BUILD
-    Timer::Instance().StartProfiling("  PrintDebugInfo()");
-    PrintDebugInfo();
-    Timer::Instance().FinishProfiling("  PrintDebugInfo()");
+    {
+      PROFILE_ZONE(ProfilerZone::PRINT_DEBUG_INFO);
+      PrintDebugInfo();
+    }
     #endif
 
     Printer::Instance().Render();
@@ -300,15 +303,24 @@ void MainState::ProcessMovement(const Position& dirOffsets)
     auto& px = _playerRef->PosX;
     auto& py = _playerRef->PosY;
 
-    GameObject* tile = Map::Instance().CurrentLevel->MapArray[px][py].get();
+    auto& tiles = Map::Instance().CurrentLevel->Tiles;
 
-    bool stairsHere = (tile->Image == '>' || tile->Image == '<');
+    int image = tiles.GetImage(px, py);
+
+    bool stairsHere = (image == '>' || image == '<');
     if (stairsHere)
     {
-      StairsComponent* sc = tile->GetComponent<StairsComponent>();
-      if (sc->IsEnabled)
+      //
+      // Stairs image alone doesn't guarantee there's a tile object
+      // with StairsComponent behind it.
+      //
+      GameObject* tile = tiles.FindTileObject(px, py);
+      StairsComponent* sc = (tile != nullptr)
+                            ? tile->GetComponent<StairsComponent>()
+                            : nullptr;
+      if (sc != nullptr && sc->IsEnabled)
       {
-        Printer::Instance().AddMessage((tile->Image == '>')
+        Printer::Instance().AddMessage((image == '>')
                                        ? Strings::MsgStairsDown
                                        : Strings::MsgStairsUp);
       }
@@ -390,7 +402,7 @@ void MainState::TryToPickupItems()
 
 // =============================================================================
 
-void MainState::PickupSingleItem(std::pair<int, GameObject *>& item)
+void MainState::PickupSingleItem(GameObject* item)
 {
   if (ProcessMoneyPickup(item))
   {
@@ -485,13 +497,15 @@ void MainState::UpdateBar(int x, int y, RangedAttribute& attr)
 
 std::pair<GameObject*, bool> MainState::CheckStairs(int stairsSymbol)
 {
-  auto& ma = Map::Instance().CurrentLevel->MapArray;
-  GameObject* stairsTile = ma[_playerRef->PosX][_playerRef->PosY].get();
+  auto& tiles = Map::Instance().CurrentLevel->Tiles;
+
+  int px = _playerRef->PosX;
+  int py = _playerRef->PosY;
 
   //
   // We're relying here on stairsSymbol to be exactly '>' or '<'
   //
-  if (stairsTile->Image != stairsSymbol)
+  if (tiles.GetImage(px, py) != stairsSymbol)
   {
     Printer::Instance().AddMessage((stairsSymbol == '>')
                                   ? Strings::MsgNoStairsDown
@@ -500,8 +514,12 @@ std::pair<GameObject*, bool> MainState::CheckStairs(int stairsSymbol)
   }
   else
   {
-    StairsComponent* sc = stairsTile->GetComponent<StairsComponent>();
-    if (!sc->IsEnabled)
+    GameObject* stairsTile = tiles.FindTileObject(px, py);
+
+    StairsComponent* sc = (stairsTile != nullptr)
+                          ? stairsTile->GetComponent<StairsComponent>()
+                          : nullptr;
+    if (sc == nullptr || !sc->IsEnabled)
     {
       Printer::Instance().AddMessage((stairsSymbol == '>')
                                     ? Strings::MsgNoStairsDown
@@ -597,8 +615,10 @@ void MainState::PrintDebugInfo()
                               Colors::WhiteColor,
                               Colors::BlackColor);
 
-  _debugInfo = Util::StringFormat("Colors: %i",
-                                  Printer::Instance().ColorsUsed());
+  _debugInfo = Util::StringFormat(
+                  "Colors: %i Build: %.2f ms",
+                  Printer::Instance().ColorsUsed(),
+                  Map::Instance().GetLevelBuildTimeMs(curLvl->MapType_));
 
   Printer::Instance().PrintFB(1,
                               5,
@@ -816,9 +836,9 @@ void MainState::ProcessWand(ItemComponent* wand)
 
 // =============================================================================
 
-bool MainState::ProcessMoneyPickup(std::pair<int, GameObject*>& pair)
+bool MainState::ProcessMoneyPickup(GameObject* item)
 {
-  ItemComponent* ic = pair.second->GetComponent<ItemComponent>();
+  ItemComponent* ic = item->GetComponent<ItemComponent>();
   if (ic->Data.ItemType_ == ItemType::COINS)
   {
     auto message = Util::StringFormat(Strings::FmtPickedUpIS,
@@ -827,8 +847,13 @@ bool MainState::ProcessMoneyPickup(std::pair<int, GameObject*>& pair)
     Printer::Instance().AddMessage(message);
 
     _playerRef->Money += ic->Data.Amount;
-    auto it = Map::Instance().CurrentLevel->GameObjects.begin();
-    Map::Instance().CurrentLevel->GameObjects.erase(it + pair.first);
+    Map::Instance().CurrentLevel->EraseGameObject(item);
+
+    Map::Instance().PostTriggerEvent({ TriggerEventType::ITEM_PICKED_UP,
+                                       _playerRef,
+                                       nullptr,
+                                       _playerRef->GetPosition() });
+
     return true;
   }
 
@@ -837,14 +862,19 @@ bool MainState::ProcessMoneyPickup(std::pair<int, GameObject*>& pair)
 
 // =============================================================================
 
-void MainState::ProcessItemPickup(std::pair<int, GameObject*>& pair)
+void MainState::ProcessItemPickup(GameObject* item)
 {
-  ItemComponent* ic = pair.second->GetComponent<ItemComponent>();
+  ItemComponent* ic = item->GetComponent<ItemComponent>();
 
-  auto go = Map::Instance().CurrentLevel->GameObjects[pair.first].release();
+  auto go = Map::Instance().CurrentLevel->ReleaseGameObject(item);
 
   _playerRef->Inventory->Add(go);
 
+  Map::Instance().PostTriggerEvent({ TriggerEventType::ITEM_PICKED_UP,
+                                     _playerRef,
+                                     go,
+                                     _playerRef->GetPosition() });
+
   std::string objName = ic->Data.IsIdentified
                       ? go->ObjectName
                       : ic->Data.UnidentifiedName;
@@ -862,9 +892,6 @@ void MainState::ProcessItemPickup(std::pair<int, GameObject*>& pair)
   }
 
   Printer::Instance().AddMessage(message);
-
-  auto it = Map::Instance().CurrentLevel->GameObjects.begin();
-  Map::Instance().CurrentLevel->GameObjects.erase(it + pair.first);
 }
 
 // =============================================================================
@@ -1141,12 +1168,9 @@ void MainState::GetActorsAround()
     {
       for (int y = ly; y <= hy; y++)
       {
-        for (auto& a : Map::Instance().CurrentLevel->ActorGameObjects)
+        for (auto& a : Map::Instance().CurrentLevel->ActorsIndex.Get(x, y))
         {
-          if (a->PosX == x && a->PosY == y)
-          {
-            _actorsForDebugDisplay.push_back(a->ObjectId());
-          }
+          _actorsForDebugDisplay.push_back(a->ObjectId());
         }
       }
     }
@@ -36,7 +36,7 @@ class MainState : public GameState
     void DisplayScenarioInformation();
     void CheckItemsOnGround();
     void TryToPickupItems();
-    void PickupSingleItem(std::pair<int, GameObject*>& item);
+    void PickupSingleItem(GameObject* item);
     void DrawHPMP();
     void GetActorsAround();
 
@@ -45,7 +45,7 @@ class MainState : public GameState
     #endif
 
     void PrintNoAttackInTown();
-    void ProcessItemPickup(std::pair<int, GameObject*>& pair);
+    void ProcessItemPickup(GameObject* item);
     void ProcessRangedWeapon();
     void ProcessWand(ItemComponent* wand);
     void ProcessWeapon(ItemComponent* wand);
@@ -53,7 +53,7 @@ class MainState : public GameState
     void UpdateBar(int x, int y, RangedAttribute& attr);
     void ClimbStairs(const std::pair<GameObject*, bool>& stairsTileInfo);
 
-    bool ProcessMoneyPickup(std::pair<int, GameObject*>& pair);
+    bool ProcessMoneyPickup(GameObject* item);
 
     //
     // <StairsTile, goDown>
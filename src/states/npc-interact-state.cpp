@@ -176,6 +176,13 @@ void NPCInteractState::Update(bool forceUpdate)
 
 // =============================================================================
 
+int NPCInteractState::GetInputTimeoutMs()
+{
+  return _textPrinting ? 10 : -1;
+}
+
+// =============================================================================
+
 void NPCInteractState::AnimateText()
 {
   //
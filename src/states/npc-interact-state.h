@@ -16,6 +16,8 @@ class NPCInteractState : public GameState
     void Cleanup() override;
     void HandleInput() override;
     void Update(bool forceUpdate = false) override;
+
+    int GetInputTimeoutMs() override;
     void SetNPCRef(AINPC* npc);
 
   private:
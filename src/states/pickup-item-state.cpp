@@ -69,7 +69,7 @@ void PickupItemState::ProcessInput()
 
 bool PickupItemState::PickupItem(const Item& item)
 {
-  ItemComponent* ic = item.second->GetComponent<ItemComponent>();
+  ItemComponent* ic = item->GetComponent<ItemComponent>();
   if (ic->Data.ItemType_ == ItemType::COINS)
   {
     auto message = Util::StringFormat(Strings::FmtPickedUpIS,
@@ -80,8 +80,12 @@ bool PickupItemState::PickupItem(const Item& item)
 
     _playerRef->Money += ic->Data.Amount;
 
-    auto it = Map::Instance().CurrentLevel->GameObjects.begin();
-    Map::Instance().CurrentLevel->GameObjects.erase(it + item.first);
+    Map::Instance().CurrentLevel->EraseGameObject(item);
+
+    Map::Instance().PostTriggerEvent({ TriggerEventType::ITEM_PICKED_UP,
+                                       _playerRef,
+                                       nullptr,
+                                       _playerRef->GetPosition() });
 
     return true;
   }
@@ -99,10 +103,15 @@ bool PickupItemState::PickupItem(const Item& item)
       return false;
     }
 
-    auto go = Map::Instance().CurrentLevel->GameObjects[item.first].release();
+    auto go = Map::Instance().CurrentLevel->ReleaseGameObject(item);
 
     _playerRef->Inventory->Add(go);
 
+    Map::Instance().PostTriggerEvent({ TriggerEventType::ITEM_PICKED_UP,
+                                       _playerRef,
+                                       go,
+                                       _playerRef->GetPosition() });
+
     std::string objName = ic->Data.IsIdentified
                         ? go->ObjectName
                         : ic->Data.UnidentifiedName;
@@ -121,9 +130,6 @@ bool PickupItemState::PickupItem(const Item& item)
 
     Printer::Instance().AddMessage(message);
 
-    auto it = Map::Instance().CurrentLevel->GameObjects.begin();
-    Map::Instance().CurrentLevel->GameObjects.erase(it + item.first);
-
     return true;
   }
 
@@ -169,10 +175,10 @@ void PickupItemState::RebuildDisplayList()
   int lineIndex = 0;
   for (auto& i : _itemsList)
   {
-    ItemComponent* ic = i.second->GetComponent<ItemComponent>();
+    ItemComponent* ic = i->GetComponent<ItemComponent>();
 
     std::string objName = ic->Data.IsIdentified
-                        ? i.second->ObjectName
+                        ? i->ObjectName
                         : ic->Data.UnidentifiedName;
 
     char c = Strings::AlphabetLowercase[lineIndex];
@@ -6,7 +6,7 @@
 class GameObject;
 class Player;
 
-using Item  = std::pair<int, GameObject*>;
+using Item  = GameObject*;
 using Items = std::vector<Item>;
 
 class PickupItemState : public SelectItemStateBase
@@ -88,7 +88,7 @@ void TargetState::FindTargets()
       double d = Util::LinearDistance(px, py, x, y);
 
       if (Util::IsInsideMap({ x, y }, Map::Instance().CurrentLevel->MapSize)
-       && Map::Instance().CurrentLevel->MapArray[x][y]->Visible
+       && Map::Instance().CurrentLevel->Tiles.IsVisible(x, y)
        && (int)d <= r && (int)d < _twHalf)
       {
         auto actor = Map::Instance().GetActorAtPosition(x, y);
@@ -273,6 +273,8 @@ void TargetState::FireWeapon(bool throwingFromInventory)
   {
     stoppedAt = LaunchProjectile(res.first, res.second);
     ProcessHit(stoppedAt);
+
+    _tileHit.reset();
   }
 
   _playerRef->FinishTurn();
@@ -327,10 +329,7 @@ GameObject* TargetState::LaunchProjectile(char image, const uint32_t& color)
   //
   if (stoppedAt == nullptr)
   {
-    auto cell =
-        Map::Instance().CurrentLevel->MapArray[endPoint.X][endPoint.Y].get();
-
-    stoppedAt = cell;
+    stoppedAt = GetTileHit(endPoint);
   }
 
   return stoppedAt;
@@ -362,10 +361,7 @@ GameObject* TargetState::CheckHit(const Position& at, const Position& prev)
     {
       if (cell->Blocking)
       {
-        auto prevCell =
-            Map::Instance().CurrentLevel->MapArray[prev.X][prev.Y].get();
-
-        return prevCell;
+        return GetTileHit(prev);
       }
       else
       {
@@ -384,10 +380,7 @@ GameObject* TargetState::CheckHit(const Position& at, const Position& prev)
         {
           if (_weaponRef->Data.SpellHeld.SpellType_ == SpellType::FIREBALL)
           {
-            auto prevCell =
-                Map::Instance().CurrentLevel->MapArray[prev.X][prev.Y].get();
-
-            return prevCell;
+            return GetTileHit(prev);
           }
           else
           {
@@ -407,6 +400,14 @@ GameObject* TargetState::CheckHit(const Position& at, const Position& prev)
 
 // =============================================================================
 
+GameObject* TargetState::GetTileHit(const Position& at)
+{
+  _tileHit = Map::Instance().CurrentLevel->Tiles.MakeTileObject(at.X, at.Y);
+  return _tileHit.get();
+}
+
+// =============================================================================
+
 bool TargetState::SafetyCheck()
 {
   bool posCheck = (_cursorPosition.X == _playerRef->PosX
@@ -514,11 +515,13 @@ void TargetState::ProcessHitInventoryThrownItem(GameObject* hitPoint)
   //
   // _weaponRef is an item to be thrown.
   //
-  auto& mapRef = Map::Instance().CurrentLevel->MapArray;
+  auto& tiles = Map::Instance().CurrentLevel->Tiles;
 
   int x = hitPoint->PosX;
   int y = hitPoint->PosY;
 
+  GameObjectType tileType = tiles.GetType(x, y);
+
   bool isRangedWeapon = (_weaponRef->Data.ItemType_ == ItemType::RANGED_WEAPON);
   bool isWand         = (_weaponRef->Data.ItemType_ == ItemType::WAND);
 
@@ -526,9 +529,9 @@ void TargetState::ProcessHitInventoryThrownItem(GameObject* hitPoint)
                    && !isRangedWeapon
                    && _weaponRef->Data.IsStackable);
 
-  bool tileOk = (mapRef[x][y]->Type != GameObjectType::DEEP_WATER
-              && mapRef[x][y]->Type != GameObjectType::LAVA
-              && mapRef[x][y]->Type != GameObjectType::CHASM);
+  bool tileOk = (tileType != GameObjectType::DEEP_WATER
+              && tileType != GameObjectType::LAVA
+              && tileType != GameObjectType::CHASM);
 
   //
   // TODO: potions break on impact, items damage monsters (not?)
@@ -553,7 +556,7 @@ void TargetState::ProcessHitInventoryThrownItem(GameObject* hitPoint)
     }
     else
     {
-      PrintThrowResult(mapRef[x][y].get());
+      PrintThrowResult(x, y);
     }
 
     if (_weaponRef->Data.Amount == 0)
@@ -581,7 +584,7 @@ void TargetState::ProcessHitInventoryThrownItem(GameObject* hitPoint)
     }
     else
     {
-      PrintThrowResult(mapRef[x][y].get());
+      PrintThrowResult(x, y);
     }
 
     auto it = _playerRef->Inventory->Contents.begin();
@@ -617,15 +620,17 @@ void TargetState::ProcessHit(GameObject* hitPoint)
 
 // =============================================================================
 
-void TargetState::PrintThrowResult(GameObject* tileRef)
+void TargetState::PrintThrowResult(int tileX, int tileY)
 {
-  GameObjectType tile = tileRef->Type;
+  auto& tiles = Map::Instance().CurrentLevel->Tiles;
+
+  GameObjectType tile = tiles.GetType(tileX, tileY);
 
   std::string objName = _weaponRef->Data.IsIdentified
                       ? _weaponRef->OwnerGameObject->ObjectName
                       : _weaponRef->Data.UnidentifiedName;
   std::string verb;
-  std::string tileName = tileRef->ObjectName;
+  const std::string& tileName = tiles.GetName(tileX, tileY);
 
   if (tile == GameObjectType::DEEP_WATER)
   {
@@ -5,11 +5,11 @@
 #include <queue>
 
 #include "gamestate.h"
+#include "game-object.h"
 #include "position.h"
 
 class Player;
 class ItemComponent;
-class GameObject;
 
 class TargetState : public GameState
 {
@@ -41,13 +41,21 @@ class TargetState : public GameState
     void CycleTargets();
     void ProcessHit(GameObject* hitPoint);
     void ProcessHitInventoryThrownItem(GameObject* hitPoint);
-    void PrintThrowResult(GameObject* tileRef);
+    void PrintThrowResult(int tileX, int tileY);
     void DirtyHack();
     void UpdatePlayerPossibleKnockbackDir();
 
     GameObject* LaunchProjectile(char image, const uint32_t& color);
     GameObject* CheckHit(const Position& at, const Position& prev);
 
+    //
+    // Tile as a target of a shot that hit nothing else
+    // (see TileLayer::MakeTileObject()), lives until shot is processed.
+    //
+    GameObject* GetTileHit(const Position& at);
+
+    std::unique_ptr<GameObject> _tileHit;
+
     std::vector<GameObject*> _targets;
 
     size_t _lastTargetIndex = -1;
@@ -1,8 +1,23 @@
 #include "player.h"
 #include "pathfinder.h"
+#include "tile-layer.h"
+#include "occupancy-index.h"
+#include "update-list.h"
+#include "trigger-dispatcher.h"
+#include "game-objects-registry.h"
+#include "timed-destroyer-component.h"
+#include "bts-blueprints.h"
+#include "blackboard.h"
 #include "level-builder.h"
+#include "map.h"
+#include "map-level-deep-dark.h"
+#include "field-of-view.h"
+#include "cellular-automata.h"
 
 #include <fstream>
+#include <future>
+#include <functional>
+#include <set>
 
 const std::string Spaces30(30, ' ');
 
@@ -68,6 +83,14 @@ void DisplayProgress()
 
 // =============================================================================
 
+void CheckResult(std::stringstream& ss, const std::string& what, bool ok)
+{
+  ss << what << "\n";
+  ss << (ok ? "OK!" : "FAIL!") << "\n\n";
+}
+
+// =============================================================================
+
 void TestLoS(std::stringstream& ss, int x, int y, int range)
 {
   ConsoleLog("%s", __func__);
@@ -1196,92 +1219,1902 @@ void TownNamesTest(std::stringstream& ss)
 
 // =============================================================================
 
-void Run()
+void PathfinderTest(std::stringstream& ss)
 {
-  std::ofstream file;
-  std::stringstream ss;
+  ConsoleLog("%s", __func__);
 
-  file.open("tests.txt");
+  ss << GetBanner(" PATHFINDER ") << "\n\n";
 
-  ss << GetBanner(" START TESTS ") << "\n\n";
+  const StringV layout =
+  {
+    "##########",
+    "#........#",
+    "#.######.#",
+    "#.#....#.#",
+    "#.#.##.#.#",
+    "#...#..#.#",
+    "#####.##.#",
+    "#........#",
+    "#.########",
+    "##########"
+  };
 
-  // ---------------------------------------------------------------------------
+  Position mapSize = { (int)layout.size(), (int)layout[0].length() };
 
-  DisplayProgress();
+  CharV2 map;
 
-  TestLoS(ss, 4, 4, 2);
+  for (int x = 0; x < mapSize.X; x++)
+  {
+    std::vector<char> row;
+    for (int y = 0; y < mapSize.Y; y++)
+    {
+      row.push_back(layout[x][y]);
+    }
 
-  ss << GetEndTestLine();
+    map.push_back(row);
+  }
 
-  // ---------------------------------------------------------------------------
+  //
+  // Same instance is used on purpose to check grid reuse between calls.
+  //
+  Pathfinder pf;
 
-  DisplayProgress();
+  auto CheckPath = [&](const Position& start,
+                       const Position& end,
+                       bool eightDirs,
+                       size_t minLength,
+                       size_t maxLength)
+  {
+    auto path = pf.BuildRoad(map, mapSize, start, end, { '#' }, eightDirs);
 
-  RoomTests(ss);
+    //
+    // With diagonal movement there can be several paths of the same cost.
+    //
+    bool ok = (path.size() >= minLength && path.size() <= maxLength);
 
-  ss << GetEndTestLine();
+    if (ok && !path.empty())
+    {
+      ok = (path.front() == start && path.back() == end);
 
-  // ---------------------------------------------------------------------------
+      for (size_t i = 1; i < path.size(); i++)
+      {
+        int dx = std::abs(path[i].X - path[i - 1].X);
+        int dy = std::abs(path[i].Y - path[i - 1].Y);
 
-  DisplayProgress();
+        if (dx > 1 || dy > 1 || (!eightDirs && dx + dy != 1))
+        {
+          ok = false;
+          break;
+        }
 
-  RNGTests(ss);
+        if (map[path[i].X][path[i].Y] == '#')
+        {
+          ok = false;
+          break;
+        }
+      }
+    }
 
-  ss << GetEndTestLine();
+    std::string what =
+        Util::StringFormat("(%i %i) -> (%i %i) %s: %zu (expected %zu - %zu)",
+                           start.X, start.Y,
+                           end.X, end.Y,
+                           eightDirs ? "8 dirs" : "4 dirs",
+                           path.size(),
+                           minLength,
+                           maxLength);
 
-  // ---------------------------------------------------------------------------
+    CheckResult(ss, what, ok);
+  };
 
-  DisplayProgress();
+  CheckPath({ 1, 1 }, { 1, 1 }, false, 1,  1);
+  CheckPath({ 1, 1 }, { 1, 8 }, false, 8,  8);
+  CheckPath({ 3, 3 }, { 8, 1 }, false, 14, 14);
+  CheckPath({ 3, 3 }, { 8, 1 }, false, 14, 14);
+  CheckPath({ 1, 1 }, { 7, 8 }, false, 14, 14);
+  CheckPath({ 3, 3 }, { 8, 1 }, true,  10, 14);
+  CheckPath({ 1, 1 }, { 0, 0 }, false, 0,  0);
+}
 
-  LevelUpTests(ss);
+// =============================================================================
 
-  ss << GetEndTestLine();
+void TileLayerTest(std::stringstream& ss)
+{
+  ConsoleLog("%s", __func__);
 
-  // ---------------------------------------------------------------------------
+  ss << GetBanner(" TILE LAYER ") << "\n\n";
 
-  DisplayProgress();
+  TileLayer tiles;
+  tiles.Init(nullptr, { 4, 3 });
 
-  WeightedRandomTest(ss);
+  CheckResult(ss, "defaults", tiles.GetImage(3, 2) == '?'
+                           && tiles.GetType(3, 2) == GameObjectType::HARMLESS
+                           && tiles.GetName(3, 2).empty()
+                           && !tiles.IsBlocking(3, 2));
 
-  ss << GetEndTestLine();
+  GameObjectInfo wall;
+  wall.Set(true, true, '#', Colors::WhiteColor, Colors::BlackColor, "Wall", "?wall?");
 
-  // ---------------------------------------------------------------------------
+  GameObjectInfo floor;
+  floor.Set(false, false, '.', Colors::WhiteColor, Colors::BlackColor, "Floor");
 
-  DisplayProgress();
+  tiles.MakeTile(0, 0, wall);
+  tiles.MakeTile(3, 1, wall, GameObjectType::PICKAXEABLE);
+  tiles.MakeTile(1, 2, floor);
 
-  LootDropTest(ss);
+  CheckResult(ss, "wall", tiles.IsBlocking(0, 0)
+                       && tiles.IsBlockingSight(0, 0)
+                       && tiles.GetImage(0, 0) == '#'
+                       && tiles.GetName(0, 0) == "Wall"
+                       && tiles.GetFowName(0, 0) == "?wall?"
+                       && tiles.GetType(0, 0) == GameObjectType::GROUND);
 
-  ss << GetEndTestLine();
+  CheckResult(ss, "type override",
+              tiles.GetType(3, 1) == GameObjectType::PICKAXEABLE);
 
-  // ---------------------------------------------------------------------------
+  CheckResult(ss, "floor", !tiles.IsBlocking(1, 2)
+                        && !tiles.IsBlockingSight(1, 2)
+                        && tiles.GetName(1, 2) == "Floor"
+                        && tiles.GetFowName(1, 2).empty());
 
-  DisplayProgress();
+  //
+  // Names are shared between tiles.
+  //
+  CheckResult(ss, "name table", &tiles.GetName(0, 0) == &tiles.GetName(3, 1));
 
-  LevelBuilderTest(ss);
+  tiles.SetRevealed(1, 2, true);
+  tiles.SetOccupied(1, 2, true);
+  tiles.SetOccupied(1, 2, false);
 
-  ss << GetEndTestLine();
+  CheckResult(ss, "flags", tiles.IsRevealed(1, 2)
+                        && !tiles.IsOccupied(1, 2)
+                        && !tiles.IsVisible(1, 2)
+                        && !tiles.IsRevealed(0, 0));
 
-  // ---------------------------------------------------------------------------
+  tiles.MakeTile(0, 0, floor);
 
-  DisplayProgress();
+  CheckResult(ss, "remake",
+              !tiles.IsBlocking(0, 0) && tiles.GetName(0, 0) == "Floor");
 
-  GenNamesTest(ss);
+  auto& sdm = tiles.GetSaveDataMinimal(1, 2);
 
-  ss << GetEndTestLine();
+  CheckResult(ss, "save data", sdm.PosX == 1
+                            && sdm.PosY == 2
+                            && sdm.Name == "Floor"
+                            && sdm.Image == '.');
 
-  // ---------------------------------------------------------------------------
+  uint64_t tempId = 0;
 
-  DisplayProgress();
+  {
+    auto temp = tiles.MakeTileObject(1, 2);
 
-  StringSplitTests(ss);
+    tempId = temp->ObjectId();
 
-  ss << GetEndTestLine();
+    CheckResult(ss, "temporary object", temp->PosX == 1
+                                     && temp->PosY == 2
+                                     && temp->ObjectName == "Floor"
+                                     && temp->Revealed
+                                     && tiles.FindTileObject(1, 2) == nullptr
+                                     && tiles.GetTileObjects().empty());
+  }
 
-  // ---------------------------------------------------------------------------
+  CheckResult(ss, "temporary object is gone",
+              GameObjectsRegistry::Instance().FindById(tempId) == nullptr);
 
-  DisplayProgress();
+  GameObject* kept = tiles.GetTileObject(1, 2);
 
-  TownNamesTest(ss);
+  CheckResult(ss, "kept object", tiles.FindTileObject(1, 2) == kept
+                              && tiles.GetTileObject(1, 2) == kept
+                              && tiles.GetTileObjects().size() == 1);
+}
+
+// =============================================================================
+
+void OccupancyIndexTest(std::stringstream& ss)
+{
+  ConsoleLog("%s", __func__);
+
+  ss << GetBanner(" OCCUPANCY INDEX ") << "\n\n";
+
+  //
+  // Size is not multiple of chunk size on purpose.
+  //
+  OccupancyIndex index;
+  index.Init({ 20, 11 });
+
+  std::vector<std::unique_ptr<GameObject>> objects;
+
+  auto Make = [&objects](int x, int y)
+  {
+    objects.push_back(std::make_unique<GameObject>(nullptr));
+    objects.back()->PosX = x;
+    objects.back()->PosY = y;
+    return objects.back().get();
+  };
+
+  GameObject* a = Make(1, 1);
+  GameObject* b = Make(1, 1);
+  GameObject* c = Make(19, 10);
+  GameObject* d = Make(9, 3);
+
+  index.Add(a);
+  index.Add(b);
+  index.Add(c);
+  index.Add(d);
+
+  CheckResult(ss, "count", index.Count() == 4);
+
+  CheckResult(ss, "order", index.Get(1, 1).size() == 2
+                        && index.Get(1, 1).front() == a
+                        && index.Get(1, 1).back() == b);
+
+  CheckResult(ss, "out of bounds",
+              index.IsEmpty(-1, 0) && index.IsEmpty(20, 11));
+
+  d->PosX = 10;
+  d->PosY = 4;
+  index.Move(d, 9, 3);
+
+  CheckResult(ss, "move", index.IsEmpty(9, 3) && index.Get(10, 4).front() == d);
+
+  //
+  // Not indexed objects are ignored.
+  //
+  GameObject* e = Make(2, 2);
+  e->PosX = 3;
+  index.Move(e, 2, 2);
+
+  CheckResult(ss, "move not indexed",
+              index.IsEmpty(3, 2) && index.Count() == 4);
+
+  CheckResult(ss, "rect all", index.GetInRect(-5, -5, 100, 100).size() == 4);
+  CheckResult(ss, "rect part", index.GetInRect(0, 0, 9, 9).size() == 2);
+  CheckResult(ss, "rect edge", index.GetInRect(19, 10, 19, 10).size() == 1);
+  CheckResult(ss, "rect none", index.GetInRect(2, 2, 8, 9).empty());
+
+  index.Remove(a);
+
+  CheckResult(ss, "remove", index.Get(1, 1).size() == 1
+                         && index.Get(1, 1).front() == b
+                         && index.Count() == 3);
+
+  //
+  // Position changed behind index's back.
+  //
+  c->PosX = 0;
+  index.Remove(c);
+
+  CheckResult(ss, "remove stale", index.IsEmpty(19, 10) && index.Count() == 2);
+}
+
+// =============================================================================
+
+void UpdateListTest(std::stringstream& ss)
+{
+  ConsoleLog("%s", __func__);
+
+  ss << GetBanner(" UPDATE LIST ") << "\n\n";
+
+  UpdateList list;
+
+  std::vector<std::unique_ptr<GameObject>> objects;
+
+  std::vector<int> updated;
+
+  //
+  // Timed destroyer with delay of 1 calls back on first Update().
+  //
+  auto Make = [&objects, &updated](int id,
+                                   const std::function<void()>& onUpdate)
+  {
+    objects.push_back(std::make_unique<GameObject>(nullptr));
+
+    GameObject* go = objects.back().get();
+    go->AddComponent<TimedDestroyerComponent>(1, [&updated, id, onUpdate]()
+    {
+      updated.push_back(id);
+
+      if (onUpdate)
+      {
+        onUpdate();
+      }
+    });
+
+    return go;
+  };
+
+  objects.push_back(std::make_unique<GameObject>(nullptr));
+
+  GameObject* item = objects.back().get();
+
+  list.Add(item);
+
+  CheckResult(ss, "not ticking", list.Count() == 0);
+
+  GameObject* removesSelf  = nullptr;
+  GameObject* removedAfter = nullptr;
+  GameObject* late         = nullptr;
+
+  GameObject* first = Make(0, nullptr);
+
+  removesSelf = Make(1, [&list, &removesSelf]()
+  {
+    list.Remove(removesSelf);
+  });
+
+  //
+  // Already updated object and the one that is next in line.
+  //
+  Make(2, [&list, &removedAfter, first]()
+  {
+    list.Remove(first);
+    list.Remove(removedAfter);
+  });
+
+  removedAfter = Make(3, nullptr);
+
+  Make(4, [&list, &late, &Make]()
+  {
+    late = Make(5, nullptr);
+    list.Add(late);
+  });
+
+  Make(6, nullptr);
+
+  for (size_t i = 1; i < objects.size(); i++)
+  {
+    list.Add(objects[i].get());
+  }
+
+  CheckResult(ss, "count", list.Count() == 6);
+
+  list.Update();
+
+  CheckResult(ss, "removal during update",
+              updated == std::vector<int>({ 0, 1, 2, 4, 6, 5 }));
+
+  CheckResult(ss, "compacted", list.Count() == 4);
+
+  //
+  // Object registered without ticking components
+  // gets into update when it gets one.
+  //
+  updated.clear();
+
+  item->AddComponent<TimedDestroyerComponent>(1, [&updated]()
+  {
+    updated.push_back(7);
+  });
+
+  CheckResult(ss, "late ticking component", list.Count() == 5);
+
+  list.Remove(late);
+
+  CheckResult(ss, "remove outside update", list.Count() == 4);
+
+  list.Clear();
+
+  CheckResult(ss, "clear", list.Count() == 0);
+}
+
+// =============================================================================
+
+void TriggerDispatcherTest(std::stringstream& ss)
+{
+  ConsoleLog("%s", __func__);
+
+  ss << GetBanner(" TRIGGER DISPATCHER ") << "\n\n";
+
+  TriggerDispatcher dispatcher;
+  dispatcher.Init({ 10, 8 });
+
+  std::vector<std::unique_ptr<GameObject>> triggers;
+
+  std::vector<std::string> fired;
+
+  auto Make = [&triggers, &fired](const std::string& name,
+                                  TriggerType type,
+                                  const TriggerHandler& onFire = nullptr)
+  {
+    triggers.push_back(std::make_unique<GameObject>(nullptr));
+
+    GameObject* go = triggers.back().get();
+    go->AttachTrigger(type,
+                      [](const TriggerEvent&) { return true; },
+                      [&fired, name, onFire](const TriggerEvent& e)
+                      {
+                        fired.push_back(name);
+
+                        if (onFire)
+                        {
+                          onFire(e);
+                        }
+                      });
+
+    return go;
+  };
+
+  auto Fired = [&fired](const std::vector<std::string>& expected)
+  {
+    bool res = (fired == expected);
+    fired.clear();
+    return res;
+  };
+
+  GameObject* update = Make("update", TriggerType::CONSTANT);
+  dispatcher.Subscribe(update, TriggerEventType::MAP_UPDATE);
+
+  dispatcher.Dispatch({ TriggerEventType::MAP_UPDATE });
+  dispatcher.Dispatch({ TriggerEventType::TURN_FINISHED });
+
+  CheckResult(ss, "by type", Fired({ "update" })
+                          && !dispatcher.HasSubscribers(
+                                TriggerEventType::TURN_FINISHED));
+
+  //
+  // Cell keys must not collide for swapped coordinates.
+  //
+  GameObject* cell = Make("cell", TriggerType::CONSTANT);
+  dispatcher.SubscribeCell(cell, { 3, 4 });
+
+  TriggerEvent entered = { TriggerEventType::CELL_ENTERED };
+
+  entered.Pos = { 4, 3 };
+  dispatcher.Dispatch(entered);
+
+  entered.Pos = { 3, 4 };
+  dispatcher.Dispatch(entered);
+
+  CheckResult(ss, "by cell", Fired({ "cell" }));
+
+  dispatcher.Post(entered);
+
+  bool postedWaits = Fired({});
+
+  dispatcher.DispatchPosted();
+
+  CheckResult(ss, "posted", postedWaits && Fired({ "cell" }));
+
+  GameObject* turn5 = Make("turn 5", TriggerType::CONSTANT);
+  GameObject* turn7 = Make("turn 7", TriggerType::CONSTANT);
+  dispatcher.SubscribeTurn(turn7, 7);
+  dispatcher.SubscribeTurn(turn5, 5);
+
+  TriggerEvent reached = { TriggerEventType::TURN_REACHED };
+
+  reached.Turn = 4;
+  dispatcher.Dispatch(reached);
+
+  bool notYet = Fired({});
+
+  //
+  // Turns may be skipped, everything due is fired once.
+  //
+  reached.Turn = 8;
+  dispatcher.Dispatch(reached);
+  dispatcher.Dispatch(reached);
+
+  CheckResult(ss, "by turn", notYet
+                          && Fired({ "turn 5", "turn 7" })
+                          && !dispatcher.HasSubscribers(
+                                TriggerEventType::TURN_REACHED));
+
+  GameObject* once = Make("once", TriggerType::ONE_SHOT);
+  dispatcher.Subscribe(once, TriggerEventType::TURN_FINISHED);
+
+  dispatcher.Dispatch({ TriggerEventType::TURN_FINISHED });
+  dispatcher.Dispatch({ TriggerEventType::TURN_FINISHED });
+
+  bool firedOnce = Fired({ "once" }) && once->IsDestroyed;
+
+  dispatcher.RemoveDestroyed();
+
+  CheckResult(ss, "one shot", firedOnce
+                           && !dispatcher.HasSubscribers(
+                                 TriggerEventType::TURN_FINISHED));
+
+  //
+  // Handler destroys the next trigger, tries to remove it
+  // and subscribes a new one to the same event.
+  //
+  GameObject* victim = nullptr;
+  GameObject* added  = nullptr;
+
+  GameObject* killer = Make("killer", TriggerType::CONSTANT,
+  [&](const TriggerEvent&)
+  {
+    victim->IsDestroyed = true;
+
+    CheckResult(ss, "no removal while dispatching",
+                !dispatcher.RemoveDestroyed() && dispatcher.IsDispatching());
+
+    if (added == nullptr)
+    {
+      added = Make("added", TriggerType::CONSTANT);
+      dispatcher.Subscribe(added, TriggerEventType::PLAYER_MOVED);
+    }
+  });
+
+  victim = Make("victim", TriggerType::CONSTANT);
+
+  GameObject* last = Make("last", TriggerType::CONSTANT);
+
+  dispatcher.Subscribe(killer, TriggerEventType::PLAYER_MOVED);
+  dispatcher.Subscribe(victim, TriggerEventType::PLAYER_MOVED);
+  dispatcher.Subscribe(last,   TriggerEventType::PLAYER_MOVED);
+
+  dispatcher.Dispatch({ TriggerEventType::PLAYER_MOVED });
+
+  bool firstPass = Fired({ "killer", "last" });
+
+  dispatcher.Dispatch({ TriggerEventType::PLAYER_MOVED });
+
+  CheckResult(ss, "changes during dispatch",
+              firstPass
+           && Fired({ "killer", "last", "added" })
+           && !dispatcher.IsDispatching()
+           && dispatcher.RemoveDestroyed());
+}
+
+// =============================================================================
+
+void GameObjectsRegistryTest(std::stringstream& ss)
+{
+  ConsoleLog("%s", __func__);
+
+  ss << GetBanner(" GAME OBJECTS REGISTRY ") << "\n\n";
+
+  auto& registry = GameObjectsRegistry::Instance();
+
+  size_t countBefore = registry.Count();
+
+  GameObject* a = new GameObject(nullptr);
+  GameObject* b = new GameObject(nullptr);
+
+  GameObjectHandle handleA = a->Handle();
+  GameObjectHandle handleB = b->Handle();
+
+  uint64_t idA = a->ObjectId();
+  uint64_t idB = b->ObjectId();
+
+  CheckResult(ss, "lookup",
+              handleA.IsValid()
+           && handleA != handleB
+           && registry.Count() == countBefore + 2
+           && registry.Get(handleA) == a
+           && registry.Get(handleB) == b
+           && registry.FindById(idA) == a
+           && registry.FindById(idB) == b
+           && registry.GetHandle(idA) == handleA);
+
+  CheckResult(ss, "unknown id",
+              registry.FindById(0) == nullptr
+           && !registry.GetHandle(0).IsValid()
+           && registry.Get(GameObjectHandle()) == nullptr);
+
+  delete a;
+
+  CheckResult(ss, "released",
+              registry.Count() == countBefore + 1
+           && registry.Get(handleA) == nullptr
+           && registry.FindById(idA) == nullptr
+           && !registry.GetHandle(idA).IsValid()
+           && registry.FindById(idB) == b);
+
+  //
+  // Freed slot is reused for the next object with bumped generation,
+  // so old handle must not resolve to the newcomer.
+  //
+  GameObject* c = new GameObject(nullptr);
+
+  GameObjectHandle handleC = c->Handle();
+
+  CheckResult(ss, "slot reuse",
+              handleC.Index == handleA.Index
+           && handleC.Generation == handleA.Generation + 1
+           && handleC != handleA
+           && registry.Get(handleC) == c
+           && registry.FindById(c->ObjectId()) == c);
+
+  CheckResult(ss, "stale handle",
+              registry.Get(handleA) == nullptr
+           && registry.FindById(idA) == nullptr);
+
+  //
+  // Releasing stale handle must not take the slot from its new owner.
+  //
+  registry.Release(handleA);
+
+  CheckResult(ss, "stale release",
+              registry.Get(handleC) == c
+           && registry.Count() == countBefore + 2);
+
+  delete b;
+  delete c;
+
+  CheckResult(ss, "all released",
+              registry.Count() == countBefore
+           && registry.Get(handleB) == nullptr
+           && registry.Get(handleC) == nullptr);
+}
+
+// =============================================================================
+
+void BTSBlueprintsTest(std::stringstream& ss)
+{
+  ConsoleLog("%s", __func__);
+
+  ss << GetBanner(" BTS BLUEPRINTS ") << "\n\n";
+
+  const std::string script =
+R"(
+[TREE]
+  [SEL]
+    [COND p1="player_in_range"]
+      [TASK p1="attack"]
+    [TASK p1="move_rnd"]
+    [TASK p1="idle"]
+)";
+
+  BTSParser parser;
+  parser.Init();
+  parser.ParseFromString(script);
+  parser.FormTree();
+
+  auto& expected = parser.GetConstructionOrder();
+
+  size_t cached = BTSBlueprints::Instance().Size();
+
+  const BTSBlueprint& bp1 = BTSBlueprints::Instance().Get(script);
+  const BTSBlueprint& bp2 = BTSBlueprints::Instance().Get(script);
+
+  CheckResult(ss, "same blueprint",
+              (&bp1 == &bp2)
+           && BTSBlueprints::Instance().Size() == cached + 1);
+
+  bool ok = (bp1.Nodes.size() == parser.ParsedData().size()
+          && bp1.Order.size() == expected.size());
+
+  for (size_t i = 0; ok && i < expected.size(); i++)
+  {
+    auto& node   = bp1.Nodes[bp1.Order[i].first];
+    auto& parent = bp1.Nodes[bp1.Order[i].second];
+
+    ok = (node.NodeName   == expected[i].first->NodeName
+       && node.Indent     == expected[i].first->Indent
+       && node.Params     == expected[i].first->Params
+       && parent.NodeName == expected[i].second->NodeName
+       && parent.Indent   == expected[i].second->Indent);
+  }
+
+  CheckResult(ss, "construction order", ok);
+
+  const BTSBlueprint& empty = BTSBlueprints::Instance().Get(std::string());
+
+  CheckResult(ss, "empty script", empty.Nodes.empty() && empty.Order.empty());
+}
+
+// =============================================================================
+
+void BlackboardTest(std::stringstream& ss)
+{
+  ConsoleLog("%s", __func__);
+
+  ss << GetBanner(" BLACKBOARD ") << "\n\n";
+
+  auto& bb = Blackboard::Instance();
+
+  const uint64_t id1 = 100500;
+  const uint64_t id2 = 100501;
+
+  CheckResult(ss, "not set",
+              bb.Get<Position>(id1, BlackboardKey::PLAYER_POS) == nullptr
+           && bb.Get(id1, "key").empty());
+
+  bb.Set(id1, BlackboardKey::PLAYER_POS, Position(3, 4));
+  bb.Set(id1, BlackboardKey::OBJECT_ID, (uint64_t)42);
+  bb.Set(id2, BlackboardKey::PLAYER_POS, Position(5, 6));
+
+  const Position* pos = bb.Get<Position>(id1, BlackboardKey::PLAYER_POS);
+  const uint64_t* objId = bb.Get<uint64_t>(id1, BlackboardKey::OBJECT_ID);
+
+  CheckResult(ss, "typed get", pos != nullptr && pos->X == 3 && pos->Y == 4
+                            && objId != nullptr && *objId == 42);
+
+  CheckResult(ss, "wrong type",
+              bb.Get<int>(id1, BlackboardKey::OBJECT_ID) == nullptr);
+
+  CheckResult(ss, "separate objects",
+              bb.Get<Position>(id2, BlackboardKey::PLAYER_POS)->X == 5);
+
+  bb.Clear(id1, BlackboardKey::PLAYER_POS);
+
+  CheckResult(ss, "clear",
+              bb.Get<Position>(id1, BlackboardKey::PLAYER_POS) == nullptr
+           && bb.Get<uint64_t>(id1, BlackboardKey::OBJECT_ID) != nullptr);
+
+  bb.Set(id1, { "key", "value" });
+
+  CheckResult(ss, "string fallback", bb.Get(id1, "key") == "value"
+                                  && bb.Get(id1, "other").empty());
+
+  bb.Remove(id1);
+  bb.Remove(id2);
+
+  CheckResult(ss, "remove",
+              bb.Get<uint64_t>(id1, BlackboardKey::OBJECT_ID) == nullptr
+           && bb.Get(id1, "key").empty()
+           && bb.Get<Position>(id2, BlackboardKey::PLAYER_POS) == nullptr);
+}
+
+// =============================================================================
+
+void AttributeModifiersTest(std::stringstream& ss)
+{
+  ConsoleLog("%s", __func__);
+
+  ss << GetBanner(" ATTRIBUTE MODIFIERS ") << "\n\n";
+
+  Attribute a;
+
+  a.Set(10);
+
+  CheckResult(ss, "no modifiers", a.Get() == 10 && a.GetModifiers() == 0);
+
+  a.AddModifier(1, 3);
+  a.AddModifier(2, -5);
+  a.AddModifier(1, 2);
+
+  CheckResult(ss, "added", a.Get() == 10 && a.GetModifiers() == 0
+                        && a.OriginalValue() == 10);
+
+  a.AddModifier(3, 4);
+  a.Add(1);
+
+  CheckResult(ss, "original changed", a.Get() == 15 && a.GetModifiers() == 4);
+
+  a.RemoveModifier(1);
+
+  CheckResult(ss, "removed all from one id",
+              a.Get() == 10 && a.GetModifiers() == -1);
+
+  a.RemoveModifier(42);
+
+  CheckResult(ss, "remove unknown id", a.Get() == 10);
+
+  a.RemoveModifier(2);
+  a.RemoveModifier(3);
+
+  CheckResult(ss, "all removed", a.Get() == 11 && a.GetModifiers() == 0);
+
+  a.AddModifier(5, 7);
+  a.Reset();
+
+  CheckResult(ss, "reset", a.Get() == 0 && a.GetModifiers() == 0);
+
+  RangedAttribute hp;
+
+  hp.Reset(20);
+  hp.Max().AddModifier(1, 10);
+  hp.Restore();
+
+  CheckResult(ss, "ranged restore", hp.Min().Get() == 30 && hp.IsFull());
+
+  hp.Max().RemoveModifier(1);
+  hp.CheckOverflow();
+
+  CheckResult(ss, "ranged overflow",
+              hp.Min().Get() == 20 && hp.Max().Get() == 20);
+}
+
+// =============================================================================
+
+void LevelPregenerationTest(std::stringstream& ss)
+{
+  ConsoleLog("%s", __func__);
+
+  ss << GetBanner(" LEVEL PREGENERATION ") << "\n\n";
+
+  const Position mapSize = { 60, 40 };
+
+  FeatureRoomsWeights weights =
+  {
+    { FeatureRoomType::EMPTY,   { 10, 0 } },
+    { FeatureRoomType::DIAMOND, {  3, 3 } },
+    { FeatureRoomType::ROUND,   {  5, 3 } },
+    { FeatureRoomType::SHRINE,  { 10, 2 } }
+  };
+
+  TransformedRoomsWeights transformWeights =
+  {
+    { TransformedRoom::EMPTY,   {  1, 0 } },
+    { TransformedRoom::SHRINE,  {  5, 1 } },
+    { TransformedRoom::STORAGE, { 10, 2 } }
+  };
+
+  auto Generate = [&](LevelBuilder& lb)
+  {
+    lb.CellularAutomataMethod(mapSize, 40, 5, 4, 12);
+    std::string ca = lb.GetMapRawString();
+
+    lb.FeatureRoomsMethod(mapSize, { 1, 11 }, weights, 30, 500);
+    lb.TransformRooms(transformWeights);
+
+    return ca + lb.GetMapRawString();
+  };
+
+  RNG::Instance().SetSeed(100500);
+
+  LevelBuilder sync;
+  std::string expected = Generate(sync);
+
+  //
+  // Same thing in background while main thread keeps using global RNG,
+  // just like the game does while player explores current level.
+  //
+  LevelBuilder async;
+  auto job = std::async(std::launch::async, [&]()
+  {
+    return Generate(async);
+  });
+
+  for (int i = 0; i < 10000; i++)
+  {
+    RNG::Instance().RandomRange(0, 100);
+  }
+
+  std::string got = job.get();
+
+  CheckResult(ss, "same layout regardless of global RNG and thread",
+              got == expected);
+
+  //
+  // Levels built by the same generator with the same parameters
+  // must still get their own layouts.
+  //
+  auto LevelLayout = [](MapLevelBase& lvl)
+  {
+    LevelBuilder lb(lvl.GetLayoutSeed());
+    lvl.GenerateLayout(lb);
+
+    return lb.GetMapRawString();
+  };
+
+  MapLevelDeepDark dd1(80, 40, MapType::DEEP_DARK_1, (int)MapType::DEEP_DARK_1);
+  MapLevelDeepDark dd2(80, 40, MapType::DEEP_DARK_2, (int)MapType::DEEP_DARK_2);
+
+  std::string layout1 = LevelLayout(dd1);
+
+  CheckResult(ss, "same level type, same layout", layout1 == LevelLayout(dd1));
+
+  CheckResult(ss, "different level types, different layouts",
+              layout1 != LevelLayout(dd2));
+}
+
+// =============================================================================
+
+//
+// Bare level with only ground tiles for tests that need Map::CurrentLevel.
+//
+class TestLevel : public MapLevelBase
+{
+  public:
+    TestLevel(const StringV& layout)
+      : MapLevelBase((int)layout.size(),
+                     (int)layout[0].length(),
+                     MapType::MINES_1,
+                     1)
+    {
+      MapLevelBase::PrepareMap();
+
+      const uint32_t fg = Colors::WhiteColor;
+      const uint32_t bg = Colors::BlackColor;
+
+      GameObjectInfo wall;
+      wall.Set(true, true, '#', fg, bg, "Wall");
+
+      GameObjectInfo floor;
+      floor.Set(false, false, '.', fg, bg, "Floor");
+
+      for (int x = 0; x < MapSize.X; x++)
+      {
+        for (int y = 0; y < MapSize.Y; y++)
+        {
+          Tiles.MakeTile(x, y, (layout[x][y] == '#') ? wall : floor);
+        }
+      }
+    }
+
+  protected:
+    void CreateCommonObjects(int x, int y, char image) override
+    {
+    }
+};
+
+// =============================================================================
+
+//
+// Bresenham driven field of view as it was before FieldOfView.
+//
+std::vector<bool> OldFieldOfView(MapLevelBase& level,
+                                 const Position& origin,
+                                 int radius,
+                                 int rangeX,
+                                 int rangeY)
+{
+  std::vector<bool> res(level.MapSize.X * level.MapSize.Y, false);
+
+  auto mapCells = Util::GetRectAroundPoint(origin.X,
+                                           origin.Y,
+                                           rangeX,
+                                           rangeY,
+                                           level.MapSize);
+  for (auto& cell : mapCells)
+  {
+    double d = Util::LinearDistance(origin.X, origin.Y, cell.X, cell.Y);
+    if (d > (double)radius)
+    {
+      continue;
+    }
+
+    auto line = Util::BresenhamLine(origin.X, origin.Y, cell.X, cell.Y);
+    for (auto& point : line)
+    {
+      if (point == origin)
+      {
+        continue;
+      }
+
+      res[point.X * level.MapSize.Y + point.Y] = true;
+
+      if (level.Tiles.IsBlockingSight(point.X, point.Y))
+      {
+        break;
+      }
+    }
+  }
+
+  return res;
+}
+
+// =============================================================================
+
+void FieldOfViewTest(std::stringstream& ss)
+{
+  ConsoleLog("%s", __func__);
+
+  ss << GetBanner(" FIELD OF VIEW ") << "\n\n";
+
+  //
+  // Shadowcasting can reveal a couple of wall corners more
+  // than Bresenham did, but floor must be seen exactly as before.
+  //
+  auto CompareWithOld = [&ss](const std::string& what,
+                              const StringV& layout,
+                              const Position& origin,
+                              int radius,
+                              int rangeX,
+                              int rangeY)
+  {
+    TestLevel level(layout);
+
+    Map::Instance().CurrentLevel = &level;
+
+    GameObject owner(&level);
+    owner.PosX = origin.X;
+    owner.PosY = origin.Y;
+
+    FieldOfView fov;
+    fov.Init(&owner);
+    fov.Compute(radius, rangeX, rangeY);
+
+    auto old = OldFieldOfView(level, origin, radius, rangeX, rangeY);
+
+    bool ok = true;
+
+    for (int x = 0; x < level.MapSize.X; x++)
+    {
+      for (int y = 0; y < level.MapSize.Y; y++)
+      {
+        if (Position(x, y) == origin)
+        {
+          continue;
+        }
+
+        bool wasVisible = old[x * level.MapSize.Y + y];
+        bool isVisible  = fov.IsVisible(x, y);
+
+        bool isWall = (layout[x][y] == '#');
+
+        if ((isWall && wasVisible && !isVisible)
+         || (!isWall && wasVisible != isVisible))
+        {
+          ok = false;
+        }
+      }
+    }
+
+    Map::Instance().CurrentLevel = nullptr;
+
+    CheckResult(ss, what, ok);
+  };
+
+  const StringV room =
+  {
+    "#######",
+    "#.....#",
+    "#.....#",
+    "#.....#",
+    "#.....#",
+    "#.....#",
+    "#.....#",
+    "#.....#",
+    "#.....#",
+    "#######"
+  };
+
+  const StringV pillar =
+  {
+    "#######",
+    "#.....#",
+    "#.....#",
+    "#.....#",
+    "#..#..#",
+    "#.....#",
+    "#.....#",
+    "#.....#",
+    "#######"
+  };
+
+  const StringV corridor =
+  {
+    "###    ",
+    "#.#    ",
+    "#.#    ",
+    "#.#####",
+    "#.....#",
+    "#.#####",
+    "#.#    ",
+    "#.#    ",
+    "###    "
+  };
+
+  StringV openArea(30, std::string(30, '.'));
+
+  CompareWithOld("open area",         openArea, { 15, 15 }, 10, 100, 100);
+  CompareWithOld("open area limited", openArea, { 15, 15 }, 10, 4, 6);
+  CompareWithOld("room",              room,     { 3, 2 },   30, 100, 100);
+  CompareWithOld("pillar",            pillar,   { 2, 3 },   30, 100, 100);
+  CompareWithOld("corridor",          corridor, { 4, 1 },   30, 100, 100);
+
+  //
+  // Unlike Bresenham, shadowcasting is symmetric:
+  // if I can see you, you can see me.
+  //
+  RNG::Instance().SetSeed(100500);
+
+  StringV clutter(40, std::string(30, '.'));
+  for (auto& line : clutter)
+  {
+    for (auto& c : line)
+    {
+      c = (RNG::Instance().RandomRange(0, 100) < 15) ? '#' : '.';
+    }
+  }
+
+  const Position center = { 20, 15 };
+
+  clutter[center.X][center.Y] = '.';
+
+  TestLevel level(clutter);
+
+  Map::Instance().CurrentLevel = &level;
+
+  GameObject owner(&level);
+  owner.PosX = center.X;
+  owner.PosY = center.Y;
+
+  FieldOfView fov;
+  fov.Init(&owner);
+  fov.Compute(10, 100, 100);
+
+  std::vector<Position> seen = fov.GetVisibleCells();
+
+  bool symmetric = true;
+
+  for (auto& p : seen)
+  {
+    if (clutter[p.X][p.Y] == '#' || p == center)
+    {
+      continue;
+    }
+
+    owner.PosX = p.X;
+    owner.PosY = p.Y;
+
+    fov.Compute(10, 100, 100);
+
+    if (!fov.IsVisible(center.X, center.Y))
+    {
+      symmetric = false;
+      break;
+    }
+  }
+
+  CheckResult(ss, "symmetry", symmetric && seen.size() > 1);
+
+  owner.PosX = center.X;
+  owner.PosY = center.Y;
+
+  fov.Compute(10, 100, 100);
+
+  CheckResult(ss, "dirty on radius change", !fov.IsDirty(10)
+                                         && fov.IsDirty(9)
+                                         && fov.IsDirty(11));
+
+  owner.PosX++;
+
+  CheckResult(ss, "dirty on move", fov.IsDirty(10));
+
+  Map::Instance().CurrentLevel = nullptr;
+}
+
+// =============================================================================
+
+//
+// Number of 4-connected areas of walkable cells inside map borders.
+//
+int CountAreas(const CharV2& map)
+{
+  int sx = map.size();
+  int sy = map[0].size();
+
+  auto IsWalkable = [&map](int x, int y)
+  {
+    return (map[x][y] == '.' || map[x][y] == '+');
+  };
+
+  std::vector<std::vector<bool>> visited(sx, std::vector<bool>(sy, false));
+
+  int areas = 0;
+
+  for (int x = 1; x < sx - 1; x++)
+  {
+    for (int y = 1; y < sy - 1; y++)
+    {
+      if (visited[x][y] || !IsWalkable(x, y))
+      {
+        continue;
+      }
+
+      areas++;
+
+      std::vector<Position> toVisit = { { x, y } };
+      visited[x][y] = true;
+
+      while (!toVisit.empty())
+      {
+        Position p = toVisit.back();
+        toVisit.pop_back();
+
+        const std::vector<Position> around =
+        {
+          { p.X - 1, p.Y }, { p.X + 1, p.Y },
+          { p.X, p.Y - 1 }, { p.X, p.Y + 1 }
+        };
+
+        for (auto& n : around)
+        {
+          if (n.X < 1 || n.X >= sx - 1 || n.Y < 1 || n.Y >= sy - 1)
+          {
+            continue;
+          }
+
+          if (!visited[n.X][n.Y] && IsWalkable(n.X, n.Y))
+          {
+            visited[n.X][n.Y] = true;
+            toVisit.push_back(n);
+          }
+        }
+      }
+    }
+  }
+
+  return areas;
+}
+
+// =============================================================================
+
+void ConnectIsolatedAreasTest(std::stringstream& ss)
+{
+  ConsoleLog("%s", __func__);
+
+  ss << GetBanner(" CONNECT ISOLATED AREAS ") << "\n\n";
+
+  LevelBuilder lb;
+
+  //
+  // Whatever tunnels are chosen, every walkable cell
+  // must be reachable from any other one afterwards.
+  //
+  auto CheckMaps = [&ss, &lb](const std::string& what,
+                              const std::function<void()>& generate)
+  {
+    bool ok = true;
+
+    for (size_t seed = 1; seed <= 10; seed++)
+    {
+      RNG::Instance().SetSeed(seed);
+
+      generate();
+
+      if (CountAreas(lb.GetMapRaw()) != 1)
+      {
+        ss << "seed " << seed << ":\n\n" << lb.GetMapRawString() << "\n";
+        ok = false;
+        break;
+      }
+    }
+
+    CheckResult(ss, what, ok);
+  };
+
+  CheckMaps("cellular automata", [&lb]()
+  {
+    lb.CellularAutomataMethod({ 80, 60 }, 40, 5, 4, 12);
+  });
+
+  CheckMaps("cellular automata sparse", [&lb]()
+  {
+    lb.CellularAutomataMethod({ 60, 80 }, 55, 5, 4, 4);
+  });
+
+  CheckMaps("rooms", [&lb]()
+  {
+    lb.RoomsMethod({ 60, 60 }, { 5, 9 }, 50);
+  });
+
+  CheckMaps("blob tiles", [&lb]()
+  {
+    lb.FromBlobTiles(60, 60, 1, 1, true);
+  });
+}
+
+// =============================================================================
+
+//
+// Runs bit packed automaton and the original per cell one
+// on the same randomly filled map.
+//
+class TestCellularAutomata : public CellularAutomata
+{
+  public:
+    bool Compare(const Position& mapSize,
+                 int initialWallChance,
+                 int birthThreshold,
+                 int deathThreshold,
+                 int maxIterations)
+    {
+      _rng.seed(RNG::Instance().Seed);
+
+      _mapSize = mapSize;
+      _map     = CreateRandomlyFilledMap(mapSize.X,
+                                         mapSize.Y,
+                                         initialWallChance);
+
+      auto initial = _map;
+
+      PackMap();
+
+      for (int i = 0; i < maxIterations; i++)
+      {
+        Step(birthThreshold, deathThreshold);
+      }
+
+      UnpackMap();
+
+      auto packed = _map;
+
+      _map = initial;
+
+      auto tmp = CreateFilledMap(mapSize.X, mapSize.Y, '.');
+
+      for (int i = 0; i < maxIterations; i++)
+      {
+        for (int x = 0; x < mapSize.X; x++)
+        {
+          for (int y = 0; y < mapSize.Y; y++)
+          {
+            int aliveCells = CountAround(x, y, '.');
+            if (_map[x][y].Image == '.')
+            {
+              tmp[x][y].Image = (aliveCells < deathThreshold) ? '#' : '.';
+            }
+            else
+            {
+              tmp[x][y].Image = (aliveCells > birthThreshold) ? '.' : '#';
+            }
+          }
+        }
+
+        for (int x = 0; x < mapSize.X; x++)
+        {
+          for (int y = 0; y < mapSize.Y; y++)
+          {
+            _map[x][y].Image = tmp[x][y].Image;
+          }
+        }
+      }
+
+      for (int x = 0; x < mapSize.X; x++)
+      {
+        for (int y = 0; y < mapSize.Y; y++)
+        {
+          if (_map[x][y].Image != packed[x][y].Image)
+          {
+            return false;
+          }
+        }
+      }
+
+      return true;
+    }
+};
+
+// =============================================================================
+
+void CellularAutomataStepTest(std::stringstream& ss)
+{
+  ConsoleLog("%s", __func__);
+
+  ss << GetBanner(" CELLULAR AUTOMATA STEP ") << "\n\n";
+
+  auto Check = [&ss](const std::string& what,
+                     const Position& mapSize,
+                     int initialWallChance,
+                     int birthThreshold,
+                     int deathThreshold,
+                     int maxIterations)
+  {
+    bool ok = true;
+
+    for (size_t seed = 1; seed <= 5; seed++)
+    {
+      RNG::Instance().SetSeed(seed);
+
+      TestCellularAutomata ca;
+      if (!ca.Compare(mapSize,
+                      initialWallChance,
+                      birthThreshold,
+                      deathThreshold,
+                      maxIterations))
+      {
+        ss << "seed " << seed << " differs\n";
+        ok = false;
+        break;
+      }
+    }
+
+    CheckResult(ss, what, ok);
+  };
+
+  //
+  // Sizes around word boundaries (64 cells per word along Y).
+  //
+  Check("100x100",        { 100, 100 }, 40, 5, 4, 12);
+  Check("80x63",          {  80,  63 }, 40, 5, 4, 12);
+  Check("80x64",          {  80,  64 }, 40, 5, 4, 12);
+  Check("80x65",          {  80,  65 }, 40, 5, 4, 12);
+  Check("30x200",         {  30, 200 }, 45, 4, 3,  6);
+  Check("tiny",           {   5,   3 }, 40, 5, 4,  3);
+  Check("all thresholds", {  70, 129 }, 50, 0, 8,  2);
+}
+
+// =============================================================================
+
+//
+// Effects processing as it was before ProcessEffects() started
+// skipping calls where nothing happens.
+// Only effects with HP action (or none) are modelled.
+//
+struct OldEffects
+{
+  std::vector<ItemBonusStruct> Effects;
+
+  int HP = 0;
+
+  void Add(const ItemBonusStruct& e)
+  {
+    for (auto& old : Effects)
+    {
+      if (old.Id == e.Id && old.Type == e.Type)
+      {
+        old = e;
+        return;
+      }
+    }
+
+    Effects.push_back(e);
+  }
+
+  //
+  // Whole group of effects from the same source goes away.
+  //
+  void Dispel(ItemBonusType type)
+  {
+    std::set<uint64_t> ids;
+
+    for (auto& e : Effects)
+    {
+      if (e.Type == type)
+      {
+        ids.insert(e.Id);
+      }
+    }
+
+    auto it = std::remove_if(Effects.begin(), Effects.end(),
+                             [&ids](const ItemBonusStruct& e)
+                             {
+                               return (ids.count(e.Id) != 0);
+                             });
+
+    Effects.erase(it, Effects.end());
+  }
+
+  //
+  // Returns true if something fired or expired.
+  //
+  bool Process()
+  {
+    bool happened = false;
+
+    auto ProcessEffect = [this, &happened](ItemBonusStruct& ibs)
+    {
+      bool fires = true;
+
+      if (ibs.Period > 0)
+      {
+        ibs.EffectCounter++;
+
+        fires = ((ibs.EffectCounter % ibs.Period) == 0);
+        if (fires)
+        {
+          ibs.EffectCounter = 0;
+        }
+      }
+
+      if (fires && ibs.Type != ItemBonusType::STR)
+      {
+        HP += ibs.BonusValue;
+        happened = true;
+      }
+    };
+
+    for (int j = Effects.size() - 1; j >= 0; j--)
+    {
+      if (Effects[j].Duration > 0)
+      {
+        ProcessEffect(Effects[j]);
+        Effects[j].Duration--;
+      }
+      else if (Effects[j].Duration == 0)
+      {
+        Effects.erase(Effects.begin() + j);
+        happened = true;
+      }
+      else if (Effects[j].Duration == -1)
+      {
+        ProcessEffect(Effects[j]);
+      }
+    }
+
+    return happened;
+  }
+
+  bool Has(ItemBonusType type)
+  {
+    for (auto& e : Effects)
+    {
+      if (e.Type == type)
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  int GetIdleTicks()
+  {
+    OldEffects copy = *this;
+
+    for (int i = 0; i < 1000; i++)
+    {
+      if (copy.Process())
+      {
+        return i;
+      }
+    }
+
+    return Component::kUnlimitedIdleTicks;
+  }
+};
+
+// =============================================================================
+
+void EffectsTest(std::stringstream& ss)
+{
+  ConsoleLog("%s", __func__);
+
+  ss << GetBanner(" EFFECTS ") << "\n\n";
+
+  TestLevel level(StringV(5, std::string(5, '.')));
+
+  Map::Instance().CurrentLevel = &level;
+
+  GameObject go(&level);
+
+  go.Attrs.HP.Reset(10000);
+  go.Attrs.HP.SetMin(5000);
+
+  OldEffects old;
+  old.HP = 5000;
+
+  auto Make = [](ItemBonusType type,
+                 uint64_t id,
+                 int value,
+                 int duration,
+                 int period)
+  {
+    ItemBonusStruct e;
+
+    e.Type       = type;
+    e.Id         = id;
+    e.BonusValue = value;
+    e.Duration   = duration;
+    e.Period     = period;
+
+    return e;
+  };
+
+  auto Add = [&go, &old](const ItemBonusStruct& e)
+  {
+    go.AddEffect(e);
+    old.Add(e);
+  };
+
+  const std::vector<ItemBonusType> types =
+  {
+    ItemBonusType::REGEN, ItemBonusType::POISONED, ItemBonusType::STR
+  };
+
+  Add(Make(ItemBonusType::REGEN,    1,  1, 20,  3));
+  Add(Make(ItemBonusType::POISONED, 2, -2,  9,  4));
+  Add(Make(ItemBonusType::STR,      3,  1,  5, -1));
+  Add(Make(ItemBonusType::REGEN,    4,  1, -1,  7));
+
+  bool hpOk    = true;
+  bool typesOk = true;
+  bool idleOk  = true;
+  bool skipped = false;
+
+  int tick = 0;
+
+  //
+  // Ticks are jumped over, so changes happen
+  // on the first tick that is not earlier than given.
+  //
+  std::vector<std::pair<int, std::function<void()>>> changes =
+  {
+    { 12, [&Add, &Make]()
+      {
+        Add(Make(ItemBonusType::POISONED, 2, -1, 6, 2));
+      }
+    },
+    { 25, [&go, &old]()
+      {
+        go.DispelEffectsAllOf(ItemBonusType::REGEN);
+        old.Dispel(ItemBonusType::REGEN);
+      }
+    },
+    //
+    // No period, acts on every call.
+    //
+    { 30, [&Add, &Make]()
+      {
+        Add(Make(ItemBonusType::POISONED, 5, -1, 4, -1));
+      }
+    },
+    //
+    // Expiry is the only event for a few calls.
+    //
+    { 40, [&Add, &Make]()
+      {
+        Add(Make(ItemBonusType::REGEN, 6, 2, 33, 5));
+      }
+    },
+    { 80, [&Add, &Make]()
+      {
+        Add(Make(ItemBonusType::STR, 7, 1, 6, -1));
+      }
+    }
+  };
+
+  size_t nextChange = 0;
+
+  while (tick < 100)
+  {
+    if (nextChange < changes.size() && tick >= changes[nextChange].first)
+    {
+      changes[nextChange].second();
+      nextChange++;
+    }
+
+    int idle = go.GetEffectsIdleTicks();
+
+    if (idle != old.GetIdleTicks())
+    {
+      ss << "tick " << tick << ": idle " << idle
+         << " vs " << old.GetIdleTicks() << "\n";
+      idleOk = false;
+      break;
+    }
+
+    //
+    // Jump over idle calls every other time.
+    //
+    if ((tick % 2) == 0 && idle > 0 && idle != Component::kUnlimitedIdleTicks)
+    {
+      go.SkipWaitingTicks(idle);
+
+      for (int i = 0; i < idle; i++)
+      {
+        old.Process();
+      }
+
+      tick += idle;
+      skipped = true;
+    }
+    else
+    {
+      go.WaitForTurn();
+      old.Process();
+
+      tick++;
+    }
+
+    if (go.Attrs.HP.Min().OriginalValue() != old.HP)
+    {
+      ss << "tick " << tick << ": HP "
+         << go.Attrs.HP.Min().OriginalValue()
+         << " vs " << old.HP << "\n";
+      hpOk = false;
+      break;
+    }
+
+    for (auto& t : types)
+    {
+      if (go.HasEffect(t) != old.Has(t))
+      {
+        ss << "tick " << tick << ": effect "
+           << (int)t << " presence differs\n";
+        typesOk = false;
+      }
+    }
+
+    if (!typesOk)
+    {
+      break;
+    }
+  }
+
+  CheckResult(ss, "HP changes",      hpOk && old.HP != 5000);
+  CheckResult(ss, "expiry",          typesOk && old.Effects.empty());
+  CheckResult(ss, "idle ticks",      idleOk && skipped);
+
+  Map::Instance().CurrentLevel = nullptr;
+}
+
+// =============================================================================
+
+void Run()
+{
+  std::ofstream file;
+  std::stringstream ss;
+
+  file.open("tests.txt");
+
+  ss << GetBanner(" START TESTS ") << "\n\n";
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  TestLoS(ss, 4, 4, 2);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  RoomTests(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  RNGTests(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  LevelUpTests(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  WeightedRandomTest(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  LootDropTest(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  LevelBuilderTest(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  GenNamesTest(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  StringSplitTests(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  TownNamesTest(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  PathfinderTest(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  TileLayerTest(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  OccupancyIndexTest(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  UpdateListTest(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  TriggerDispatcherTest(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  GameObjectsRegistryTest(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  BTSBlueprintsTest(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  BlackboardTest(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  LevelPregenerationTest(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  AttributeModifiersTest(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  FieldOfViewTest(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  ConnectIsolatedAreasTest(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  CellularAutomataStepTest(ss);
+
+  ss << GetEndTestLine();
+
+  // ---------------------------------------------------------------------------
+
+  DisplayProgress();
+
+  EffectsTest(ss);
 
   ss << GetEndTestLine();
 
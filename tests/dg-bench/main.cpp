@@ -0,0 +1,601 @@
+#include "level-builder.h"
+#include "rng.h"
+#include "timer.h"
+
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+
+#ifdef __unix__
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+//
+// Runs every dungeon generator over a set of map sizes and seeds
+// and prints timing and memory statistics as CSV,
+// one line per generator / map size pair.
+//
+// If baseline file (output of previous run) is provided,
+// median times are compared against it and program exits
+// with non-zero code if any of them got slower than allowed
+// or has no baseline entry to compare with.
+//
+
+// =============================================================================
+
+//
+// Every heap allocation made through global operator new is counted.
+// Size is stored in front of the returned block so that
+// currently allocated amount can be tracked.
+//
+namespace
+{
+  const size_t kHeaderSize = alignof(std::max_align_t);
+
+  size_t AllocationsCount = 0;
+  size_t AllocatedBytes   = 0;
+  size_t LiveBytes        = 0;
+  size_t PeakLiveBytes    = 0;
+}
+
+void* operator new(size_t size)
+{
+  void* block = std::malloc(size + kHeaderSize);
+  if (block == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+
+  *static_cast<size_t*>(block) = size;
+
+  AllocationsCount++;
+  AllocatedBytes += size;
+  LiveBytes      += size;
+
+  PeakLiveBytes = std::max(PeakLiveBytes, LiveBytes);
+
+  return static_cast<char*>(block) + kHeaderSize;
+}
+
+void operator delete(void* ptr) noexcept
+{
+  if (ptr == nullptr)
+  {
+    return;
+  }
+
+  void* block = static_cast<char*>(ptr) - kHeaderSize;
+
+  LiveBytes -= *static_cast<size_t*>(block);
+
+  std::free(block);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+  operator delete(ptr);
+}
+
+// =============================================================================
+
+struct BenchCase
+{
+  std::string Name;
+  std::function<void(LevelBuilder&, const Position&)> Run;
+};
+
+//
+// Plain data, so that it can be passed from child process as is
+// (see RunCaseInChild()).
+//
+struct BenchStats
+{
+  size_t Runs = 0;
+  double MinMs    = 0.0;
+  double MedianMs = 0.0;
+  double P99Ms    = 0.0;
+  size_t Allocations    = 0;
+  size_t AllocatedBytes = 0;
+  size_t PeakHeapBytes  = 0;
+};
+
+struct BenchResult
+{
+  std::string Name;
+  Position MapSize;
+  BenchStats Stats;
+  long PeakRssKb = -1;
+};
+
+// =============================================================================
+
+double GetPercentile(const std::vector<double>& sorted, double percentile)
+{
+  if (sorted.empty())
+  {
+    return 0.0;
+  }
+
+  size_t index = (size_t)(percentile * (sorted.size() - 1) + 0.5);
+
+  return sorted[std::min(index, sorted.size() - 1)];
+}
+
+// =============================================================================
+
+std::vector<BenchCase> GetCases()
+{
+  const FeatureRoomsWeights weights =
+  {
+    { FeatureRoomType::EMPTY,    { 10, 0 } },
+    { FeatureRoomType::DIAMOND,  {  3, 3 } },
+    { FeatureRoomType::FLOODED,  {  1, 3 } },
+    { FeatureRoomType::GARDEN,   {  3, 3 } },
+    { FeatureRoomType::PILLARS,  {  5, 0 } },
+    { FeatureRoomType::ROUND,    {  5, 3 } },
+    { FeatureRoomType::POND,     {  3, 3 } },
+    { FeatureRoomType::FOUNTAIN, {  3, 2 } },
+    { FeatureRoomType::SHRINE,   { 10, 1 } }
+  };
+
+  //
+  // Parameters are the same as the ones used by game levels
+  // (see map-level-*.cpp) where possible.
+  //
+  std::vector<BenchCase> cases =
+  {
+    {
+      "tunneler",
+      [](LevelBuilder& lb, const Position& size)
+      {
+        lb.TunnelerMethod(size, (size.X * size.Y) / 2, { 5, 15 });
+      }
+    },
+    {
+      "tunneler-bt",
+      [](LevelBuilder& lb, const Position& size)
+      {
+        lb.BacktrackingTunnelerMethod(size, { 5, 10 }, { 1, 1 }, true);
+      }
+    },
+    {
+      "recbt",
+      [](LevelBuilder& lb, const Position& size)
+      {
+        lb.RecursiveBacktrackerMethod(size, { -1, -1 }, { 6, 8, 1 });
+      }
+    },
+    {
+      "cellular",
+      [](LevelBuilder& lb, const Position& size)
+      {
+        lb.CellularAutomataMethod(size, 40, 5, 4, 12);
+      }
+    },
+    {
+      "feature-rooms",
+      [weights](LevelBuilder& lb, const Position& size)
+      {
+        lb.FeatureRoomsMethod(size, { 1, 10 }, weights, 30, size.X * size.Y);
+      }
+    },
+    {
+      "bsp",
+      [](LevelBuilder& lb, const Position& size)
+      {
+        lb.BSPRoomsMethod(size, { 45, 55 }, 7);
+      }
+    },
+    {
+      "rooms",
+      [](LevelBuilder& lb, const Position& size)
+      {
+        lb.RoomsMethod(size, { 3, 7 }, size.X);
+      }
+    },
+    {
+      "perm-tiles",
+      [](LevelBuilder& lb, const Position& size)
+      {
+        lb.FromPermutationTilesMethod(size, -1, true, false);
+      }
+    },
+    {
+      "blob-tiles",
+      [](LevelBuilder& lb, const Position& size)
+      {
+        lb.FromBlobTiles(size.X, size.Y, 3, 1, true);
+      }
+    }
+  };
+
+  return cases;
+}
+
+// =============================================================================
+
+BenchResult RunCase(const BenchCase& bc,
+                    const Position& mapSize,
+                    int seeds,
+                    int runsPerSeed)
+{
+  BenchResult res;
+
+  res.Name    = bc.Name;
+  res.MapSize = mapSize;
+
+  std::vector<double> times;
+
+  size_t allocsBefore = AllocationsCount;
+  size_t bytesBefore  = AllocatedBytes;
+
+  for (int seed = 1; seed <= seeds; seed++)
+  {
+    for (int run = 0; run < runsPerSeed; run++)
+    {
+      RNG::Instance().SetSeed((size_t)seed);
+
+      LevelBuilder lb;
+
+      PeakLiveBytes = LiveBytes;
+
+      size_t baseline = LiveBytes;
+
+      auto start = Clock::now();
+
+      bc.Run(lb, mapSize);
+
+      auto end = Clock::now();
+
+      double ms = std::chrono::duration_cast<Ns>(end - start).count() / 1e6;
+
+      times.push_back(ms);
+
+      res.Stats.PeakHeapBytes = std::max(res.Stats.PeakHeapBytes,
+                                         PeakLiveBytes - baseline);
+    }
+  }
+
+  std::sort(times.begin(), times.end());
+
+  BenchStats& st = res.Stats;
+
+  st.Runs     = times.size();
+  st.MinMs    = times.front();
+  st.MedianMs = GetPercentile(times, 0.5);
+  st.P99Ms    = GetPercentile(times, 0.99);
+
+  st.Allocations    = (AllocationsCount - allocsBefore) / st.Runs;
+  st.AllocatedBytes = (AllocatedBytes - bytesBefore) / st.Runs;
+
+  return res;
+}
+
+// =============================================================================
+
+#ifdef __unix__
+
+//
+// Peak RSS of a process only ever grows, so if every case ran here
+// it would just keep the biggest value seen so far.
+// Instead case is run in a child process and its own peak RSS is taken
+// from wait4(). This process never runs generators itself,
+// so what child inherits from it is the same for every case.
+//
+bool RunCaseInChild(const BenchCase& bc,
+                    const Position& mapSize,
+                    int seeds,
+                    int runsPerSeed,
+                    BenchResult& res)
+{
+  int fds[2];
+  if (pipe(fds) != 0)
+  {
+    return false;
+  }
+
+  pid_t pid = fork();
+  if (pid < 0)
+  {
+    close(fds[0]);
+    close(fds[1]);
+    return false;
+  }
+
+  if (pid == 0)
+  {
+    close(fds[0]);
+
+    BenchResult r = RunCase(bc, mapSize, seeds, runsPerSeed);
+
+    ssize_t written = write(fds[1], &r.Stats, sizeof(r.Stats));
+
+    //
+    // Not exit(), stdout buffer belongs to parent.
+    //
+    _exit(written == sizeof(r.Stats) ? 0 : 1);
+  }
+
+  close(fds[1]);
+
+  ssize_t got = read(fds[0], &res.Stats, sizeof(res.Stats));
+
+  close(fds[0]);
+
+  int status = 0;
+  rusage usage;
+
+  if (wait4(pid, &status, 0, &usage) != pid
+   || !WIFEXITED(status)
+   || WEXITSTATUS(status) != 0
+   || got != sizeof(res.Stats))
+  {
+    return false;
+  }
+
+  res.Name      = bc.Name;
+  res.MapSize   = mapSize;
+  res.PeakRssKb = usage.ru_maxrss;
+
+  return true;
+}
+
+#endif
+
+// =============================================================================
+
+std::string GetKey(const std::string& name, int sizeX, int sizeY)
+{
+  std::stringstream ss;
+  ss << name << "@" << sizeX << "x" << sizeY;
+  return ss.str();
+}
+
+// =============================================================================
+
+//
+// Returns median time by case key from previously saved output.
+//
+std::map<std::string, double> ReadBaseline(const std::string& fname)
+{
+  std::map<std::string, double> res;
+
+  std::ifstream f(fname);
+  if (!f.is_open())
+  {
+    printf("Can't open baseline file '%s'\n", fname.data());
+    return res;
+  }
+
+  std::string line;
+
+  //
+  // Header.
+  //
+  std::getline(f, line);
+
+  while (std::getline(f, line))
+  {
+    std::vector<std::string> cols;
+    std::stringstream ss(line);
+    std::string col;
+
+    while (std::getline(ss, col, ','))
+    {
+      cols.push_back(col);
+    }
+
+    if (cols.size() < 6)
+    {
+      continue;
+    }
+
+    std::string key = GetKey(cols[0], std::stoi(cols[1]), std::stoi(cols[2]));
+    res[key] = std::stod(cols[5]);
+  }
+
+  return res;
+}
+
+// =============================================================================
+
+void PrintUsage(const char* progName)
+{
+  printf("Usage: %s [-s <seeds>] [-r <runs_per_seed>] "
+         "[-g <generator>] [-z <map_x>x<map_y> ...] "
+         "[-b <baseline.csv>] [-t <tolerance_percent>] "
+         "[-o <output.csv>]\n", progName);
+}
+
+// =============================================================================
+
+int main(int argc, char* argv[])
+{
+  int seeds       = 5;
+  int runsPerSeed = 3;
+  int tolerance   = 20;
+
+  std::string baselineFile;
+  std::string outputFile;
+  std::string onlyGenerator;
+
+  std::vector<Position> mapSizes;
+
+  for (int i = 1; i < argc; i++)
+  {
+    std::string opt = argv[i];
+
+    if (i + 1 >= argc)
+    {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+
+    std::string val = argv[++i];
+
+    if      (opt == "-s") seeds         = std::stoi(val);
+    else if (opt == "-r") runsPerSeed   = std::stoi(val);
+    else if (opt == "-t") tolerance     = std::stoi(val);
+    else if (opt == "-b") baselineFile  = val;
+    else if (opt == "-o") outputFile    = val;
+    else if (opt == "-g") onlyGenerator = val;
+    else if (opt == "-z")
+    {
+      Position size;
+      if (sscanf(val.data(), "%ix%i", &size.X, &size.Y) != 2)
+      {
+        PrintUsage(argv[0]);
+        return 1;
+      }
+
+      mapSizes.push_back(size);
+    }
+    else
+    {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (seeds < 1 || runsPerSeed < 1)
+  {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  RNG::Instance().Init();
+
+  //
+  // Room based generators get slow on big maps,
+  // so bigger sizes must be requested explicitly.
+  //
+  if (mapSizes.empty())
+  {
+    mapSizes =
+    {
+      { 40, 40 },
+      { 80, 80 }
+    };
+  }
+
+  std::stringstream csv;
+
+  csv << "generator,size_x,size_y,runs,"
+      << "min_ms,median_ms,p99_ms,"
+      << "allocs_per_run,alloc_bytes_per_run,peak_heap_bytes,"
+      << "peak_rss_kb\n";
+
+  printf("%s", csv.str().data());
+
+  std::vector<BenchResult> results;
+
+  for (auto& bc : GetCases())
+  {
+    if (!onlyGenerator.empty() && bc.Name != onlyGenerator)
+    {
+      continue;
+    }
+
+    for (auto& size : mapSizes)
+    {
+      #ifdef __unix__
+      BenchResult r;
+      if (!RunCaseInChild(bc, size, seeds, runsPerSeed, r))
+      {
+        fprintf(stderr, "Failed to run %s\n",
+                GetKey(bc.Name, size.X, size.Y).data());
+        return 1;
+      }
+      #else
+      BenchResult r = RunCase(bc, size, seeds, runsPerSeed);
+      #endif
+
+      char buf[512];
+      snprintf(buf, sizeof(buf),
+               "%s,%i,%i,%zu,%.3f,%.3f,%.3f,%zu,%zu,%zu,%li\n",
+               r.Name.data(),
+               r.MapSize.X,
+               r.MapSize.Y,
+               r.Stats.Runs,
+               r.Stats.MinMs,
+               r.Stats.MedianMs,
+               r.Stats.P99Ms,
+               r.Stats.Allocations,
+               r.Stats.AllocatedBytes,
+               r.Stats.PeakHeapBytes,
+               r.PeakRssKb);
+
+      printf("%s", buf);
+      fflush(stdout);
+
+      csv << buf;
+
+      results.push_back(r);
+    }
+  }
+
+  if (results.empty())
+  {
+    fprintf(stderr, "No such generator: '%s'\n", onlyGenerator.data());
+    return 1;
+  }
+
+  if (!outputFile.empty())
+  {
+    std::ofstream f(outputFile);
+    f << csv.str();
+  }
+
+  if (baselineFile.empty())
+  {
+    return 0;
+  }
+
+  auto baseline = ReadBaseline(baselineFile);
+  if (baseline.empty())
+  {
+    return 1;
+  }
+
+  int regressions = 0;
+  int missing     = 0;
+
+  for (auto& r : results)
+  {
+    std::string key = GetKey(r.Name, r.MapSize.X, r.MapSize.Y);
+    if (baseline.count(key) == 0)
+    {
+      fprintf(stderr, "MISSING: %s is not in baseline\n", key.data());
+      missing++;
+      continue;
+    }
+
+    double allowed = baseline[key] * (100.0 + tolerance) / 100.0;
+
+    if (r.Stats.MedianMs > allowed)
+    {
+      fprintf(stderr,
+              "REGRESSION: %s median %.3f ms, baseline %.3f ms (+%i%% allowed)\n",
+              key.data(),
+              r.Stats.MedianMs,
+              baseline[key],
+              tolerance);
+
+      regressions++;
+    }
+  }
+
+  if (missing != 0)
+  {
+    return 1;
+  }
+
+  return (regressions == 0) ? 0 : 2;
+}
@@ -1,6 +1,7 @@
 #include "serializer.h"
 
 #include "gid-generator.h"
+#include "game-objects-registry.h"
 #include "application.h"
 #include "game-objects-factory.h"
 #include "spells-processor.h"
@@ -8,6 +9,7 @@
 #include "monsters-inc.h"
 #include "blackboard.h"
 #include "bts-decompiler.h"
+#include "bts-blueprints.h"
 #include "map.h"
 #include "timer.h"
 #include "util.h"
@@ -24,6 +26,7 @@ void SaveGameTest()
   // ---------------------------------------------------------------------------
 
   GID::Instance().Init();
+  GameObjectsRegistry::Instance().Init();
   RNG::Instance().Init();
 
   Blackboard::Instance().Init();
@@ -35,6 +38,7 @@ void SaveGameTest()
 #endif
 
   BTSDecompiler::Instance().Init();
+  BTSBlueprints::Instance().Init();
 
   Application::Instance().Init();
 
@@ -1,4 +1,5 @@
 #include "gid-generator.h"
+#include "game-objects-registry.h"
 #include "application.h"
 #include "game-objects-factory.h"
 #include "spells-processor.h"
@@ -6,8 +7,10 @@
 #include "monsters-inc.h"
 #include "blackboard.h"
 #include "bts-decompiler.h"
+#include "bts-blueprints.h"
 #include "map.h"
 #include "timer.h"
+#include "animation-timeline.h"
 #include "util.h"
 #include "rng.h"
 
@@ -18,10 +21,12 @@
 int main(int argc, char* argv[])
 {
   GID::Instance().Init();
+  GameObjectsRegistry::Instance().Init();
   RNG::Instance().Init();
 
   Blackboard::Instance().Init();
   Timer::Instance().Init();
+  AnimationTimeline::Instance().Init();
 
 #ifdef DEBUG_BUILD
   Logger::Instance().Init();
@@ -29,6 +34,7 @@ int main(int argc, char* argv[])
 #endif
 
   BTSDecompiler::Instance().Init();
+  BTSBlueprints::Instance().Init();
 
   Application::Instance().Init();
 